@@ -25,6 +25,7 @@ namespace Genode {
 
 	class Heap;
 	class Sliced_heap;
+	class Thread_cached_heap;
 }
 
 
@@ -123,6 +124,28 @@ class Genode::Heap : public Allocator
 		 */
 		bool _unsynchronized_alloc(size_t size, void **out_addr);
 
+		/**
+		 * Unsynchronized implementation of 'free'
+		 */
+		void _unsynchronized_free(void *addr);
+
+		/*
+		 * Batched operations used by 'Thread_cached_heap'
+		 */
+		friend class Thread_cached_heap;
+
+		/**
+		 * Allocate up to 'num' blocks of 'size' bytes at once
+		 *
+		 * \return  number of allocated blocks
+		 */
+		unsigned _alloc_batch(size_t size, void **out_addr, unsigned num);
+
+		/**
+		 * Free 'num' blocks at once
+		 */
+		void _free_batch(void * const *addr, unsigned num);
+
 	public:
 
 		enum { UNLIMITED = ~0 };
@@ -229,4 +252,117 @@ class Genode::Sliced_heap : public Allocator
 		bool   need_size_for_free()  const override { return false; }
 };
 
+
+/**
+ * Front end of a heap that caches small blocks per thread
+ *
+ * All allocations of the heap are serialized by one mutex. For components
+ * with many threads that allocate concurrently, this front end keeps freed
+ * blocks of small size classes in magazines. The magazines are organized in
+ * stripes, and each thread uses the stripe that corresponds to its stack.
+ * So, threads usually do not contend for a stripe. An empty magazine is
+ * refilled with a batch of blocks from the heap, and a full magazine returns
+ * a batch of blocks to the heap, each under one acquisition of the heap's
+ * mutex.
+ *
+ * Cached blocks are not accounted as consumed. If the heap runs out of
+ * quota, the cached blocks are returned to the heap before the allocation
+ * fails.
+ */
+class Genode::Thread_cached_heap : public Allocator
+{
+	public:
+
+		enum {
+			NUM_STRIPES   = 16,
+			NUM_CLASSES   = 7,   /* blocks of 32 to 2048 bytes */
+			MAGAZINE_SIZE = 32,
+			BATCH         = MAGAZINE_SIZE/2,
+		};
+
+	private:
+
+		/*
+		 * Header in front of each block, which keeps the block's size class
+		 * because 'free' is not guaranteed to be called with the size
+		 *
+		 * The header is padded to 16 bytes on all architectures, so that
+		 * the 16-byte alignment of the blocks of the heap carries over to
+		 * the returned addresses.
+		 */
+		struct Header
+		{
+			enum { UNCACHED = ~0UL };
+
+			unsigned long size_class;
+			unsigned long padding[16/sizeof(unsigned long) - 1];
+		};
+
+		static_assert(sizeof(Header) == 16, "unexpected heap-header size");
+
+		struct Magazine
+		{
+			unsigned count = 0;
+			void    *blocks[MAGAZINE_SIZE] { };
+		};
+
+		struct Stripe
+		{
+			Mutex    mutex     { };
+			size_t   cached    { 0 };  /* bytes held by the magazines */
+			Magazine magazines[NUM_CLASSES] { };
+		};
+
+		Heap &_heap;
+
+		Stripe * const _stripes;
+
+		static size_t _class_size(unsigned size_class) {
+			return 32UL << size_class; }
+
+		static unsigned long _size_class(size_t size);
+
+		static Stripe *_alloc_stripes(Heap &);
+
+		Stripe &_stripe();
+
+		void _flush(Stripe &);
+		void _flush_all();
+
+		bool _alloc_uncached(size_t size, Header **);
+
+		/*
+		 * Noncopyable
+		 */
+		Thread_cached_heap(Thread_cached_heap const &);
+		Thread_cached_heap &operator = (Thread_cached_heap const &);
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param heap  backing heap, which also holds the magazines
+		 */
+		Thread_cached_heap(Heap &heap);
+
+		~Thread_cached_heap();
+
+		/**
+		 * Return blocks of all magazines to the heap
+		 */
+		void flush() { _flush_all(); }
+
+
+		/*************************
+		 ** Allocator interface **
+		 *************************/
+
+		bool   alloc(size_t, void **) override;
+		void   free(void *, size_t)   override;
+		size_t consumed()       const override;
+		size_t overhead(size_t) const override;
+		bool   need_size_for_free() const override { return false; }
+};
+
 #endif /* _INCLUDE__BASE__HEAP_H_ */
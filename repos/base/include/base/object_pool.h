@@ -19,7 +19,10 @@
 #include <util/avl_tree.h>
 #include <util/noncopyable.h>
 #include <base/capability.h>
+#include <base/semaphore.h>
 #include <base/weak_ptr.h>
+#include <cpu/atomic.h>
+#include <cpu/memory_barrier.h>
 
 namespace Genode { template <typename> class Object_pool; }
 
@@ -31,6 +34,12 @@ namespace Genode { template <typename> class Object_pool; }
  *
  * The local names of a capabilities are used to differentiate multiple server
  * objects managed by one and the same object pool.
+ *
+ * Lookups via 'apply' do not take the pool-wide lock. They walk the tree
+ * optimistically and validate the result against a version counter that is
+ * incremented before and after each modification of the tree. An entry
+ * removed from the pool is guaranteed to be no longer accessed by any
+ * lookup once 'remove' returns.
  */
 template <typename OBJ_TYPE>
 class Genode::Object_pool : Interface, Noncopyable
@@ -94,8 +103,154 @@ class Genode::Object_pool : Interface, Noncopyable
 
 	private:
 
-		Avl_tree<Entry> _tree { };
-		Lock            _lock { };
+		/**
+		 * Synchronization of lock-free lookups with the removal of entries
+		 *
+		 * Lookups announce themselves at one of two reader counters,
+		 * selected by the parity of the current epoch. 'synchronize' starts
+		 * a new epoch and blocks until all lookups of the previous epoch
+		 * are finished.
+		 */
+		class Epoch : Noncopyable
+		{
+			private:
+
+				int volatile _epoch      = 0;
+				int volatile _readers[2] = { 0, 0 };
+				int volatile _waiting    = 0;  /* parity + 1 of awaited readers */
+
+				Lock      _synchronize_lock { };
+				Semaphore _drained          { };
+
+				static int _add(int volatile &value, int delta)
+				{
+					for (;;) {
+						int const old = value;
+						if (cmpxchg(&value, old, old + delta))
+							return old + delta;
+					}
+				}
+
+				unsigned _enter()
+				{
+					for (;;) {
+						int      const epoch  = _epoch;
+						unsigned const parity = epoch & 1;
+
+						_add(_readers[parity], 1);
+						if (_epoch == epoch)
+							return parity;
+
+						/* raced with 'synchronize', retry in the new epoch */
+						_leave(parity);
+					}
+				}
+
+				void _leave(unsigned parity)
+				{
+					int const awaited = parity + 1;
+
+					if (_add(_readers[parity], -1) == 0 && _waiting == awaited
+					 && cmpxchg(&_waiting, awaited, 0))
+						_drained.up();
+				}
+
+			public:
+
+				struct Read_guard : Noncopyable
+				{
+					Epoch         &epoch;
+					unsigned const parity;
+
+					Read_guard(Epoch &epoch) : epoch(epoch), parity(epoch._enter()) { }
+
+					~Read_guard() { epoch._leave(parity); }
+				};
+
+				void synchronize()
+				{
+					Lock::Guard guard(_synchronize_lock);
+
+					int      const epoch   = _epoch;
+					unsigned const parity  = epoch & 1;
+					int      const awaited = parity + 1;
+
+					cmpxchg(&_epoch, epoch, epoch + 1);
+					cmpxchg(&_waiting, 0, awaited);
+
+					if (_readers[parity] == 0 && cmpxchg(&_waiting, awaited, 0))
+						return;
+
+					/* the last reader of the old epoch wakes us up */
+					_drained.down();
+				}
+		};
+
+		enum { MAX_DEPTH = 64, MAX_ATTEMPTS = 8 };
+
+		Avl_tree<Entry> _tree    { };
+		Lock            _lock    { };
+		int volatile    _version { 0 };  /* odd while the tree is modified */
+		Epoch           _epoch   { };
+
+		/**
+		 * Modify tree, must be called with '_lock' held
+		 */
+		template <typename FN>
+		void _modify(FN const &fn)
+		{
+			_version = _version + 1;
+			memory_barrier();
+
+			fn();
+
+			memory_barrier();
+			_version = _version + 1;
+		}
+
+		Entry *_find(unsigned long obj_id)
+		{
+			Entry *entry = _tree.first();
+
+			/* bound the walk as the tree may be rebalanced concurrently */
+			for (unsigned depth = 0; entry && depth < MAX_DEPTH; depth++) {
+
+				unsigned long const id = entry->_obj_id();
+				if (id == obj_id)
+					return entry;
+
+				entry = entry->child(obj_id > id);
+			}
+			return nullptr;
+		}
+
+		/**
+		 * Look up entry, must be called within a read-side section
+		 */
+		Entry *_lookup(unsigned long obj_id)
+		{
+			for (unsigned i = 0; i < MAX_ATTEMPTS; i++) {
+
+				int const version = _version;
+				memory_barrier();
+
+				if (version & 1)
+					continue;
+
+				/* an entry with matching ID is valid even if the tree changed */
+				Entry * const entry = _find(obj_id);
+				if (entry)
+					return entry;
+
+				memory_barrier();
+				if (_version == version)
+					return nullptr;
+			}
+
+			/* the tree is modified all the time, wait for the modification */
+			Lock::Guard lock_guard(_lock);
+			return _find(obj_id);
+		}
 
 	protected:
 
@@ -110,13 +265,18 @@ class Genode::Object_pool : Interface, Noncopyable
 		void insert(OBJ_TYPE *obj)
 		{
 			Lock::Guard lock_guard(_lock);
-			_tree.insert(obj);
+			_modify([&] () { _tree.insert(obj); });
 		}
 
 		void remove(OBJ_TYPE *obj)
 		{
-			Lock::Guard lock_guard(_lock);
-			_tree.remove(obj);
+			{
+				Lock::Guard lock_guard(_lock);
+				_modify([&] () { _tree.remove(obj); });
+			}
+
+			/* wait for lookups that may still refer to the removed entry */
+			_epoch.synchronize();
 		}
 
 		template <typename FUNC>
@@ -131,10 +291,9 @@ class Genode::Object_pool : Interface, Noncopyable
 			Weak_ptr ptr;
 
 			{
-				Lock::Guard lock_guard(_lock);
+				typename Epoch::Read_guard guard(_epoch);
 
-				Entry * entry = _tree.first() ?
-					_tree.first()->find_by_obj_id(capid) : nullptr;
+				Entry * entry = _lookup(capid);
 
 				if (entry) ptr = entry->_lock.weak_ptr();
 			}
@@ -173,10 +332,11 @@ class Genode::Object_pool : Interface, Noncopyable
 						Locked_ptr lock_ptr(ptr);
 						if (!lock_ptr.valid()) return;
 
-						_tree.remove(obj);
+						_modify([&] () { _tree.remove(obj); });
 					}
 				}
 
+				_epoch.synchronize();
 				func(obj);
 			}
 		}
@@ -16,12 +16,21 @@
 
 #include <base/stdint.h>
 #include <cpu_session/cpu_session.h>
+#include <cpu/memory_barrier.h>
+#include <util/string.h>
 
 namespace Genode { namespace Trace { class Buffer; } }
 
 
 /**
  * Buffer shared between CPU client thread and TRACE client
+ *
+ * The buffer is written by exactly one thread, the traced thread, and read
+ * concurrently by the TRACE client. Each committed entry carries a sequence
+ * number. Before modifying any part of the buffer, the writer announces the
+ * extent of the modification as monotonic byte position ('_dirty_pos').
+ * This enables the 'Reader' to detect entries that were overwritten while
+ * or before being read and to account for the number of lost entries.
  */
 class Genode::Trace::Buffer
 {
@@ -31,23 +40,53 @@ class Genode::Trace::Buffer
 		unsigned volatile _size;         /* in bytes */
 		unsigned volatile _wrapped;      /* count of buffer wraps */
 
+		unsigned long volatile _num_entries;  /* sequence number of next entry */
+		unsigned long volatile _dirty_pos;    /* end of region touched by writer */
+
 		struct _Entry
 		{
-			size_t len;
-			char   data[0];
+			size_t        len;
+			unsigned long seq;
+			char          data[0];
 		};
 
 		_Entry _entries[0];
 
 		_Entry *_head_entry() { return (_Entry *)((addr_t)_entries + _head_offset); }
 
+		/**
+		 * Return monotonic byte position of offset within given buffer lap
+		 *
+		 * Positions are compared via their difference, so overflows do
+		 * not matter.
+		 */
+		unsigned long _pos(unsigned lap, size_t offset) const {
+			return (unsigned long)lap*_size + offset; }
+
+		/**
+		 * Announce that the writer is about to modify the buffer up to 'pos'
+		 */
+		void _mark_dirty(unsigned long pos)
+		{
+			if ((long)(pos - _dirty_pos) <= 0)
+				return;
+
+			_dirty_pos = pos;
+			memory_barrier();
+		}
+
 		void _buffer_wrapped()
 		{
+			_mark_dirty(_pos(_wrapped + 1, sizeof(_Entry)));
+
 			_head_offset = 0;
-			_wrapped++;
 
 			/* mark first entry with len 0 */
 			_head_entry()->len = 0;
+
+			/* a reader observing the wrap finds the marker in place */
+			memory_barrier();
+			_wrapped = _wrapped + 1;
 		}
 
 		/*
@@ -70,19 +109,23 @@ class Genode::Trace::Buffer
 
 			_size = size - header_size;
 
-			_wrapped = 0;
+			_wrapped     = 0;
+			_num_entries = 0;
+			_dirty_pos   = 0;
 		}
 
 		char *reserve(size_t len)
 		{
-			if (_head_offset + sizeof(_Entry) + len <= _size)
-				return _head_entry()->data;
+			if (_head_offset + sizeof(_Entry) + len > _size) {
 
-			/* mark last entry with len 0 and wrap */
-			if (_head_offset + sizeof(_Entry) <= _size)
-				_head_entry()->len = 0;
+				/* mark last entry with len 0 and wrap */
+				if (_head_offset + sizeof(_Entry) <= _size)
+					_head_entry()->len = 0;
+
+				_buffer_wrapped();
+			}
 
-			_buffer_wrapped();
+			_mark_dirty(_pos(_wrapped, _head_offset + sizeof(_Entry) + len));
 
 			return _head_entry()->data;
 		}
@@ -93,6 +136,7 @@ class Genode::Trace::Buffer
 			if (len == 0)
 				return;
 
+			_head_entry()->seq = _num_entries;
 			_head_entry()->len = len;
 
 			/* advance head offset, wrap when reaching buffer boundary */
@@ -101,8 +145,14 @@ class Genode::Trace::Buffer
 				_buffer_wrapped();
 
 			/* mark entry next to new entry with len 0 */
-			else if (_head_offset + sizeof(_Entry) <= _size)
+			else if (_head_offset + sizeof(_Entry) <= _size) {
+				_mark_dirty(_pos(_wrapped, _head_offset + sizeof(_Entry)));
 				_head_entry()->len = 0;
+			}
+
+			/* publish the entry not before it is completely in place */
+			memory_barrier();
+			_num_entries = _num_entries + 1;
 		}
 
 		unsigned wrapped() const { return _wrapped; }
@@ -124,8 +174,9 @@ class Genode::Trace::Buffer
 
 			public:
 
-				size_t      length() const { return _entry->len; }
-				char const *data()   const { return _entry->data; }
+				size_t        length() const { return _entry->len; }
+				char const   *data()   const { return _entry->data; }
+				unsigned long seq()    const { return _entry->seq; }
 
 				/*
 				 * XXX The meaning of this method is irritating.
@@ -176,6 +227,168 @@ class Genode::Trace::Buffer
 
 			return Entry((_Entry const *)((addr_t)entry.data() + entry.length()));
 		}
+
+		class Reader;
+};
+
+
+/**
+ * Consumer of the entries of a trace buffer in commit order
+ *
+ * In contrast to walking the buffer via 'first' and 'next', the reader
+ * copies each entry out of the buffer and validates the copy against the
+ * progress of the writer before handing it out. Entries that were
+ * overwritten before they could be read are skipped and accounted as lost.
+ * Entries longer than 'MAX_ENTRY_LEN' are truncated.
+ */
+class Genode::Trace::Buffer::Reader
+{
+	public:
+
+		enum { MAX_ENTRY_LEN = 1024 };
+
+	private:
+
+		Buffer const &_buffer;
+
+		unsigned      _lap      = 0;  /* buffer lap of next entry */
+		size_t        _offset   = 0;  /* offset of next entry within lap */
+		unsigned long _next_seq = 0;
+		unsigned long _lost     = 0;
+
+		struct
+		{
+			_Entry header;
+			char   data[MAX_ENTRY_LEN];
+		} _copy { };
+
+		_Entry const &_entry_at(size_t offset) const {
+			return *(_Entry const *)((addr_t)_buffer._entries + offset); }
+
+		/**
+		 * Return true if the writer did not touch the buffer at the given
+		 * position since the entries of the position's lap were written
+		 */
+		bool _intact(unsigned lap, size_t offset) const
+		{
+			memory_barrier();
+			return _buffer._dirty_pos - _buffer._pos(lap, offset) <= _buffer._size;
+		}
+
+		/**
+		 * Copy next entry into '_copy'
+		 *
+		 * \return false if the entry was overwritten by the writer
+		 */
+		bool _copy_next()
+		{
+			size_t const size = _buffer._size;
+
+			for (unsigned attempt = 0; attempt < 2; attempt++) {
+
+				size_t len = 0;
+				unsigned long seq = 0;
+
+				if (_offset + sizeof(_Entry) <= size) {
+					len = _entry_at(_offset).len;
+					seq = _entry_at(_offset).seq;
+				}
+
+				if (!_intact(_lap, _offset))
+					return false;
+
+				/* the next entry is located at the start of the next lap */
+				if (len == 0) {
+					_lap++;
+					_offset = 0;
+					continue;
+				}
+
+				if (seq != _next_seq || _offset + sizeof(_Entry) + len > size)
+					return false;
+
+				_copy.header.len = min(len, (size_t)MAX_ENTRY_LEN);
+				_copy.header.seq = seq;
+				memcpy(_copy.data, _entry_at(_offset).data, _copy.header.len);
+
+				if (!_intact(_lap, _offset))
+					return false;
+
+				_offset += sizeof(_Entry) + len;
+				if (_offset == size) {
+					_lap++;
+					_offset = 0;
+				}
+				_next_seq++;
+				return true;
+			}
+			return false;
+		}
+
+		/**
+		 * Continue at the oldest entry that is still available
+		 */
+		void _resync()
+		{
+			for (;;) {
+				unsigned long const num_entries = _buffer._num_entries;
+				memory_barrier();
+				unsigned const lap = _buffer._wrapped;
+				memory_barrier();
+
+				size_t        const len = _entry_at(0).len;
+				unsigned long const seq = _entry_at(0).seq;
+
+				if (!_intact(lap, 0))
+					continue;
+
+				unsigned long const next_seq = len ? seq : num_entries;
+
+				if ((long)(next_seq - _next_seq) > 0)
+					_lost += next_seq - _next_seq;
+
+				_next_seq = next_seq;
+				_lap      = lap;
+				_offset   = 0;
+				return;
+			}
+		}
+
+	public:
+
+		Reader(Buffer const &buffer) : _buffer(buffer) { }
+
+		/**
+		 * Call 'fn' with each entry that was committed since the last call
+		 *
+		 * The functor is called with a 'Buffer::Entry' that refers to a
+		 * private copy of the entry. It returns false to stop the iteration
+		 * after the current entry.
+		 */
+		template <typename FN>
+		void for_each_new_entry(FN const &fn)
+		{
+			for (;;) {
+				unsigned long const num_entries = _buffer._num_entries;
+				memory_barrier();
+
+				if (_next_seq == num_entries)
+					return;
+
+				if (!_copy_next()) {
+					_resync();
+					continue;
+				}
+
+				if (!fn(Entry(&_copy.header)))
+					return;
+			}
+		}
+
+		/**
+		 * Return number of entries overwritten before they could be read
+		 */
+		unsigned long lost() const { return _lost; }
 };
 
 #endif /* _INCLUDE__BASE__TRACE__BUFFER_H_ */
@@ -173,6 +173,8 @@ class Genode::Timeout : private Noncopyable
 				Raw                      _raw           { };
 				int                      _active        { 0 };
 				Alarm                   *_next          { nullptr };
+				Alarm                   *_prev          { nullptr };
+				unsigned                 _wheel_list    { 0 };
 				Alarm_timeout_scheduler *_scheduler     { nullptr };
 
 				void _alarm_assign(Time                     period,
@@ -186,7 +188,7 @@ class Genode::Timeout : private Noncopyable
 					_scheduler           = scheduler;
 				}
 
-				void _alarm_reset() { _alarm_assign(0, 0, false, 0), _active = 0, _next = 0; }
+				void _alarm_reset() { _alarm_assign(0, 0, false, 0), _active = 0, _next = 0, _prev = 0; }
 
 				bool _on_alarm(uint64_t);
 
@@ -225,6 +227,22 @@ class Genode::Timeout : private Noncopyable
 
 /**
  * Timeout-scheduler implementation using the Alarm framework
+ *
+ * The active alarms are kept either in a list sorted by deadline or in a
+ * hierarchical timing wheel. The list is cheap for a handful of timeouts but
+ * inserting an alarm costs O(n). The timing wheel schedules and discards an
+ * alarm in constant time, which pays off for components that keep thousands
+ * of timeouts alive like network stacks with their retransmission timers.
+ *
+ * The wheel consists of 'WHEEL_LEVELS' levels of 'WHEEL_SLOTS' slots each.
+ * A slot at level 0 spans one microsecond, a slot at level l spans
+ * 'WHEEL_SLOTS' slots of level l-1. An alarm is put into the slot of the
+ * lowest level that covers its distance to the wheel time. Once the wheel
+ * time reaches the start of a slot at a higher level, the alarms of the slot
+ * are cascaded to the lower levels. Deadlines beyond the range of the wheel
+ * are kept in an overflow list that is re-examined at the start of a
+ * rotation of the top level. Each level has a bitmap of occupied slots so
+ * that advancing the wheel skips empty slots.
  */
 class Genode::Alarm_timeout_scheduler : private Noncopyable,
                                         public  Timeout_scheduler,
@@ -234,11 +252,38 @@ class Genode::Alarm_timeout_scheduler : private Noncopyable,
 	friend class Timer::Root_component;
 	friend class Timeout::Alarm;
 
+	public:
+
+		/**
+		 * Data structure used for the active alarms
+		 */
+		enum class Queue { SORTED_LIST, TIMING_WHEEL };
+
 	private:
 
 		using Alarm = Timeout::Alarm;
 
+		enum {
+			WHEEL_LEVELS    = 6,
+			WHEEL_SLOT_BITS = 6,
+			WHEEL_SLOTS     = 1 << WHEEL_SLOT_BITS,
+
+			/* lists beside the slots of the wheel */
+			WHEEL_DUE       = WHEEL_LEVELS * WHEEL_SLOTS,
+			WHEEL_OVERFLOW  = WHEEL_DUE + 1,
+			WHEEL_NR_OF_LISTS,
+		};
+
+		struct Wheel_list
+		{
+			Alarm       *head;
+
+			/* lower bound of the deadlines in the list */
+			Alarm::Time  min_deadline;
+		};
+
 		Time_source     &_time_source;
+		Queue      const _queue;
 		Lock             _lock              { };
 		Alarm           *_active_head       { nullptr };
 		Alarm           *_pending_head      { nullptr };
@@ -246,6 +291,35 @@ class Genode::Alarm_timeout_scheduler : private Noncopyable,
 		bool             _now_period        { false };
 		Alarm::Raw       _min_handle_period { };
 
+		/*
+		 * The wheel time is the next point in time to be processed. All
+		 * alarms with a deadline before the wheel time are in the due list.
+		 */
+		Wheel_list       _wheel_lists[WHEEL_NR_OF_LISTS]  { };
+		uint64_t         _wheel_occupied[WHEEL_LEVELS]     { };
+		Alarm::Time      _wheel_time                       { 0 };
+
+		unsigned _wheel_list_index(Alarm::Raw const &raw) const;
+
+		void _wheel_link(Alarm &alarm, unsigned index);
+
+		void _wheel_unlink(Alarm &alarm);
+
+		void _wheel_move(unsigned index);
+
+		bool _wheel_next_slot(unsigned level, Alarm::Time &start,
+		                      unsigned &slot) const;
+
+		bool _wheel_next_event(Alarm::Time &time) const;
+
+		void _wheel_process(Alarm::Time time);
+
+		void _wheel_advance(Alarm::Time now);
+
+		void _wheel_rebase();
+
+		bool _wheel_next_deadline(Alarm::Time &deadline) const;
+
 		void _alarm_unsynchronized_enqueue(Alarm *alarm);
 
 		void _alarm_unsynchronized_dequeue(Alarm *alarm);
@@ -284,13 +358,20 @@ class Genode::Alarm_timeout_scheduler : private Noncopyable,
 
 		bool _alarm_next_deadline(Alarm::Time *deadline);
 
-		bool _alarm_head_timeout(const Alarm * alarm) { return _active_head == alarm; }
+		bool _alarm_head_timeout(const Alarm * alarm);
 
 		Alarm_timeout_scheduler(Alarm_timeout_scheduler const &);
 		Alarm_timeout_scheduler &operator = (Alarm_timeout_scheduler const &);
 
 	public:
 
+		Alarm_timeout_scheduler(Time_source  &time_source,
+		                        Microseconds  min_handle_period,
+		                        Queue         queue);
+
+		/**
+		 * Constructor for a scheduler that keeps the alarms in a sorted list
+		 */
 		Alarm_timeout_scheduler(Time_source  &time_source,
 		                        Microseconds  min_handle_period = Microseconds(1));
 
@@ -241,7 +241,7 @@ class Timer::Connection : public  Genode::Connection<Session>,
 		 ** Timeout_scheduler helpers **
 		 *******************************/
 
-		Genode::Alarm_timeout_scheduler _scheduler { *this };
+		Genode::Alarm_timeout_scheduler _scheduler;
 
 
 		/***********************
@@ -256,12 +256,29 @@ class Timer::Connection : public  Genode::Connection<Session>,
 
 		struct Cannot_use_both_legacy_and_modern_interface : Genode::Exception { };
 
+		using Queue = Genode::Alarm_timeout_scheduler::Queue;
+
 		/**
 		 * Constructor
 		 *
 		 * \param env    environment used for construction (e.g. quota trading)
 		 * \param ep     entrypoint used as timeout handler execution context
 		 * \param label  optional label used in session routing
+		 * \param queue  data structure for scheduling the local timeouts,
+		 *               'TIMING_WHEEL' is preferable for many timeouts
+		 */
+		Connection(Genode::Env &env,
+		           Genode::Entrypoint & ep,
+		           char const *label,
+		           Queue queue);
+
+		/**
+		 * Constructor for a connection that keeps the local timeouts in a
+		 * sorted list
+		 *
+		 * \param env    environment used for construction (e.g. quota trading)
+		 * \param ep     entrypoint used as timeout handler execution context
+		 * \param label  optional label used in session routing
 		 */
 		Connection(Genode::Env &env,
 		           Genode::Entrypoint & ep,
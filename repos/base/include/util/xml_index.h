@@ -0,0 +1,244 @@
+/*
+ * \brief  Index of the nodes of an XML document
+ * \author Norman Feske
+ * \date   2026-10-17
+ *
+ * A plain 'Xml_node' determines its end tag and its number of sub nodes by
+ * scanning its content on construction. Hence, obtaining a node via
+ * 'sub_node()' or 'next()' costs time linear in the size of the node, and
+ * walking a large document becomes quadratic. The index scans the document
+ * once and records the start and end tag, the sub nodes, and the next
+ * sibling of each node. Nodes obtained from the index are regular
+ * 'Xml_node' objects that navigate to their sub nodes and siblings via the
+ * index in constant time. Attributes are not indexed.
+ *
+ * Only well-formed documents can be indexed. The index and the document
+ * must outlive all nodes obtained from the index.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__UTIL__XML_INDEX_H_
+#define _INCLUDE__UTIL__XML_INDEX_H_
+
+#include <base/allocator.h>
+#include <util/xml_node.h>
+
+namespace Genode { class Xml_index; }
+
+
+class Genode::Xml_index : Noncopyable
+{
+	private:
+
+		typedef Xml_node::Index        Index;
+		typedef Xml_node::Index::Node  Node;
+		typedef Xml_node::Token        Token;
+		typedef Xml_node::Tag          Tag;
+		typedef Xml_node::Comment      Comment;
+
+		/*
+		 * Array that is freed on destruction, even if the construction of
+		 * the index fails
+		 */
+		template <typename T>
+		struct Table : Noncopyable
+		{
+			Allocator &alloc;
+			unsigned   capacity;
+			T         *elem;
+
+			Table(Allocator &alloc, unsigned capacity)
+			:
+				alloc(alloc), capacity(capacity),
+				elem((T *)alloc.alloc(capacity*sizeof(T)))
+			{ }
+
+			~Table() { alloc.free(elem, capacity*sizeof(T)); }
+
+			void double_capacity()
+			{
+				T *new_elem = (T *)alloc.alloc(2*capacity*sizeof(T));
+				memcpy(new_elem, elem, capacity*sizeof(T));
+				alloc.free(elem, capacity*sizeof(T));
+
+				elem      = new_elem;
+				capacity *= 2;
+			}
+
+			private:
+
+				/*
+				 * Noncopyable
+				 */
+				Table(Table const &);
+				Table &operator = (Table const &);
+		};
+
+		Xml_node const _root;
+
+		Index _index { _root._addr, _root._max_len, nullptr, nullptr };
+
+		Table<Node> _nodes;
+		unsigned    _num_nodes = 0;
+
+		/* one entry per node except for the root */
+		Table<unsigned> _sub_nodes { _nodes.alloc, _scan() };
+
+		size_t _offset(Token t) const { return t.start() - _root._addr; }
+
+		Tag _start_tag(Node const &node) const {
+			return Tag(Xml_node::_index_token(_index, node.start)); }
+
+		size_t _content_offset(Node const &node) const {
+			return _offset(_start_tag(node).next_token()); }
+
+		unsigned _append(Tag const &tag, unsigned parent)
+		{
+			if (_num_nodes == _nodes.capacity)
+				_nodes.double_capacity();
+
+			size_t const start = _offset(tag.token());
+
+			_nodes.elem[_num_nodes] = Node { start, start, start, 0, 0,
+			                                 Index::NONE, parent };
+
+			return _num_nodes++;
+		}
+
+		static bool _names_match(Tag const &start, Tag const &end)
+		{
+			size_t const len = start.name().len();
+
+			return len == end.name().len()
+			    && !strcmp(start.name().start(), end.name().start(), len);
+		}
+
+		/**
+		 * Scan document and record its nodes in document order
+		 *
+		 * \return  capacity needed for the sub-node table
+		 * \throw   Xml_node::Invalid_syntax
+		 */
+		unsigned _scan()
+		{
+			Tag const root_tag = _root._tags.start;
+
+			/* the root node starts where the document starts */
+			_append(root_tag, Index::NONE);
+			_nodes.elem[0].addr = 0;
+
+			if (root_tag.type() == Tag::EMPTY)
+				return 1;
+
+			unsigned curr = 0;  /* innermost open node */
+			unsigned prev = 0;  /* last sub node of 'curr' */
+
+			for (Token t = root_tag.next_token(); t.type() != Token::END; ) {
+
+				Comment const comment(t);
+				if (comment.valid()) {
+					t = comment.next_token();
+					continue;
+				}
+
+				Tag const tag(t);
+				if (tag.type() == Tag::INVALID) {
+					t = t.next();
+					continue;
+				}
+
+				if (tag.node()) {
+
+					unsigned const node = _append(tag, curr);
+					Node &parent = _nodes.elem[curr];
+
+					/*
+					 * Like a sub node obtained via 'Xml_node::sub_node', the
+					 * first sub node starts right after the parent's start tag.
+					 */
+					if (parent.num_sub_nodes++ == 0)
+						_nodes.elem[node].addr = _content_offset(parent);
+					else
+						_nodes.elem[prev].next = node;
+
+					prev = node;
+					if (tag.type() == Tag::START)
+						curr = node;
+
+				} else {
+
+					Node &node = _nodes.elem[curr];
+
+					if (!_names_match(_start_tag(node), tag))
+						throw Xml_node::Invalid_syntax();
+
+					node.end = _offset(tag.token());
+
+					if (node.parent == Index::NONE)
+						return _num_nodes;
+
+					prev = curr;
+					curr = node.parent;
+				}
+				t = tag.next_token();
+			}
+
+			/* end of document reached with nodes left open */
+			throw Xml_node::Invalid_syntax();
+		}
+
+		/**
+		 * Group the sub nodes of each node in the 'sub_nodes' table
+		 */
+		void _collect_sub_nodes()
+		{
+			unsigned pos = 0;
+			for (unsigned i = 0; i < _num_nodes; i++) {
+
+				Node &node = _nodes.elem[i];
+				node.first_sub_node = pos;
+
+				if (node.num_sub_nodes == 0)
+					continue;
+
+				/* the first sub node directly follows its parent */
+				for (unsigned s = i + 1; s != Index::NONE; s = _nodes.elem[s].next)
+					_sub_nodes.elem[pos++] = s;
+			}
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param alloc  backing store of the index
+		 * \param node   root node of the document
+		 *
+		 * \throw Xml_node::Invalid_syntax
+		 */
+		Xml_index(Allocator &alloc, Xml_node const &node)
+		:
+			_root(node), _nodes(alloc, 64)
+		{
+			_collect_sub_nodes();
+
+			_index.nodes     = _nodes.elem;
+			_index.sub_nodes = _sub_nodes.elem;
+		}
+
+		/**
+		 * Return indexed root node of the document
+		 */
+		Xml_node xml() const { return Xml_node(_index, 0); }
+
+		unsigned num_nodes() const { return _num_nodes; }
+};
+
+#endif /* _INCLUDE__UTIL__XML_INDEX_H_ */
@@ -22,6 +22,7 @@
 namespace Genode {
 	class Xml_attribute;
 	class Xml_node;
+	class Xml_index;
 	class Xml_unquoted;
 }
 
@@ -279,6 +280,7 @@ class Genode::Xml_node
 		class Tag;
 
 		friend class Xml_unquoted;
+		friend class Xml_index;
 
 	public:
 
@@ -531,6 +533,32 @@ class Genode::Xml_node
 			}
 		};
 
+		/**
+		 * Table of the nodes of a document as built by 'Xml_index'
+		 *
+		 * All offsets are relative to 'base'.
+		 */
+		struct Index
+		{
+			enum : unsigned { NONE = ~0U };
+
+			struct Node
+			{
+				size_t   addr;            /* start of node data */
+				size_t   start;           /* start tag */
+				size_t   end;             /* end tag, same as 'start' if empty */
+				unsigned num_sub_nodes;
+				unsigned first_sub_node;  /* position in 'sub_nodes' table */
+				unsigned next;            /* next sibling or NONE */
+				unsigned parent;          /* parent or NONE for the root */
+			};
+
+			char const     *base;
+			size_t          max_len;
+			Node     const *nodes;
+			unsigned const *sub_nodes;  /* node numbers grouped by parent */
+		};
+
 		char const * _addr;       /* first character of XML data */
 		size_t       _max_len;    /* length of XML data in characters */
 
@@ -644,8 +672,49 @@ class Genode::Xml_node
 				start(skip_non_tag_characters(Token(addr, max_len))),
 				end(_search_end_tag(start, num_sub_nodes))
 			{ }
+
+			Tags(Token start, Token end, int num_sub_nodes)
+			:
+				num_sub_nodes(num_sub_nodes), start(start), end(end)
+			{ }
 		} _tags;
 
+		/* index the node was obtained from, if any */
+		Index const *_index     { nullptr };
+		unsigned     _index_pos { 0 };
+
+		static Token _index_token(Index const &index, size_t offset) {
+			return Token(index.base + offset, index.max_len - offset); }
+
+		/**
+		 * Constructor used by 'Xml_index'
+		 *
+		 * The node is created from its index entry without scanning the
+		 * document.
+		 */
+		Xml_node(Index const &index, unsigned pos)
+		:
+			_addr(index.base + index.nodes[pos].addr),
+			_max_len(index.max_len - index.nodes[pos].addr),
+			_tags(_index_token(index, index.nodes[pos].start),
+			      _index_token(index, index.nodes[pos].end),
+			      index.nodes[pos].num_sub_nodes),
+			_index(&index), _index_pos(pos)
+		{ }
+
+		Index::Node const &_index_node() const { return _index->nodes[_index_pos]; }
+
+		/**
+		 * Return true if the siblings of the node are known by the index
+		 *
+		 * The siblings of the root node are outside of the indexed document.
+		 */
+		bool _indexed_siblings() const {
+			return _index && _index_node().parent != Index::NONE; }
+
+		Xml_node _indexed_sub_node(unsigned idx) const {
+			return Xml_node(*_index, _index->sub_nodes[_index_node().first_sub_node + idx]); }
+
 		/**
 		 * Return true if specified buffer contains a valid XML node
 		 */
@@ -852,6 +921,13 @@ class Genode::Xml_node
 		 */
 		Xml_node next() const
 		{
+			if (_indexed_siblings()) {
+				if (_index_node().next == Index::NONE)
+					throw Nonexistent_sub_node();
+
+				return Xml_node(*_index, _index_node().next);
+			}
+
 			Token after_node = _tags.end.next_token();
 			after_node = skip_non_tag_characters(after_node);
 			try {
@@ -879,6 +955,15 @@ class Genode::Xml_node
 		 */
 		bool last(char const *type = nullptr) const
 		{
+			if (_indexed_siblings()) {
+				for (unsigned i = _index_node().next; i != Index::NONE;
+				     i = _index->nodes[i].next)
+					if (!type || Xml_node(*_index, i).has_type(type))
+						return false;
+
+				return true;
+			}
+
 			Token after = _tags.end.next_token();
 			after = skip_non_tag_characters(after);
 
@@ -904,6 +989,13 @@ class Genode::Xml_node
 		 */
 		Xml_node sub_node(unsigned idx = 0U) const
 		{
+			if (_index) {
+				if (idx >= _index_node().num_sub_nodes)
+					throw Nonexistent_sub_node();
+
+				return _indexed_sub_node(idx);
+			}
+
 			if (_tags.num_sub_nodes > 0) {
 				try {
 					Xml_node curr_node = _node_at(_content_base());
@@ -922,6 +1014,15 @@ class Genode::Xml_node
 		 */
 		Xml_node sub_node(char const *type) const
 		{
+			if (_index) {
+				for (unsigned i = 0; i < _index_node().num_sub_nodes; i++) {
+					Xml_node const node = _indexed_sub_node(i);
+					if (!type || node.has_type(type))
+						return node;
+				}
+				throw Nonexistent_sub_node();
+			}
+
 			if (_tags.num_sub_nodes > 0) {
 
 				/* search for sub node of specified type */
@@ -1080,6 +1181,14 @@ class Genode::Xml_node
 			if (_tags.num_sub_nodes == 0)
 				return false;
 
+			if (_index) {
+				for (unsigned i = 0; i < _index_node().num_sub_nodes; i++)
+					if (!type || _indexed_sub_node(i).has_type(type))
+						return true;
+
+				return false;
+			}
+
 			if (!_valid_node_at(_content_base()))
 				return false;
 
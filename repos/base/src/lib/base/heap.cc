@@ -234,11 +234,46 @@ bool Heap::alloc(size_t size, void **out_addr)
 }
 
 
+unsigned Heap::_alloc_batch(size_t size, void **out_addr, unsigned num)
+{
+	Mutex::Guard guard(_mutex);
+
+	unsigned i = 0;
+	try {
+		for (; i < num; i++)
+			if (size + _quota_used > _quota_limit
+			 || !_unsynchronized_alloc(size, &out_addr[i]))
+				break;
+	}
+	catch (...) {
+		/* hand out the blocks allocated so far */
+		if (i == 0)
+			throw;
+	}
+	return i;
+}
+
+
+void Heap::_free_batch(void * const *addr, unsigned num)
+{
+	Mutex::Guard guard(_mutex);
+
+	for (unsigned i = 0; i < num; i++)
+		_unsynchronized_free(addr[i]);
+}
+
+
 void Heap::free(void *addr, size_t)
 {
 	/* serialize access of heap functions */
 	Mutex::Guard guard(_mutex);
 
+	_unsynchronized_free(addr);
+}
+
+
+void Heap::_unsynchronized_free(void *addr)
+{
 	/* try to find the size in our local allocator */
 	size_t const size = _alloc->size_at(addr);
 
@@ -0,0 +1,212 @@
+/*
+ * \brief  Heap front end that caches small blocks per thread
+ * \author Norman Feske
+ * \date   2026-10-17
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#include <util/construct_at.h>
+#include <base/heap.h>
+
+/* base-internal includes */
+#include <base/internal/stack_area.h>
+
+using namespace Genode;
+
+
+unsigned long Thread_cached_heap::_size_class(size_t size)
+{
+	if (size > _class_size(NUM_CLASSES - 1))
+		return Header::UNCACHED;
+
+	if (size <= _class_size(0))
+		return 0;
+
+	/* smallest power of two that holds 'size', relative to 32 bytes */
+	return log2(size - 1) + 1 - 5;
+}
+
+
+Thread_cached_heap::Stripe &Thread_cached_heap::_stripe()
+{
+	/*
+	 * Each thread has its own slot in the stack area. The index of the slot
+	 * spreads the threads evenly over the stripes. Stacks outside the stack
+	 * area, i.e., the main thread on some platforms, use the first stripe.
+	 */
+	int dummy = 0;
+	addr_t const sp   = (addr_t)&dummy;
+	addr_t const base = stack_area_virtual_base();
+
+	if (sp < base || sp >= base + stack_area_virtual_size())
+		return _stripes[0];
+
+	return _stripes[((sp - base) / stack_virtual_size()) % NUM_STRIPES];
+}
+
+
+void Thread_cached_heap::_flush(Stripe &stripe)
+{
+	Mutex::Guard guard(stripe.mutex);
+
+	for (Magazine &magazine : stripe.magazines) {
+		_heap._free_batch(magazine.blocks, magazine.count);
+		magazine.count = 0;
+	}
+	stripe.cached = 0;
+}
+
+
+void Thread_cached_heap::_flush_all()
+{
+	for (unsigned i = 0; i < NUM_STRIPES; i++)
+		_flush(_stripes[i]);
+}
+
+
+bool Thread_cached_heap::_alloc_uncached(size_t size, Header **out)
+{
+	void *addr = nullptr;
+
+	if (_heap.alloc(size, &addr)) {
+		*out = (Header *)addr;
+		return true;
+	}
+
+	/* the blocks held by the magazines may make the difference */
+	_flush_all();
+
+	if (_heap.alloc(size, &addr)) {
+		*out = (Header *)addr;
+		return true;
+	}
+	return false;
+}
+
+
+bool Thread_cached_heap::alloc(size_t size, void **out_addr)
+{
+	size_t        const total      = size + sizeof(Header);
+	unsigned long const size_class = _size_class(total);
+
+	Header *header = nullptr;
+
+	if (size_class == Header::UNCACHED) {
+
+		if (!_alloc_uncached(total, &header))
+			return false;
+
+	} else {
+
+		size_t const class_size = _class_size(size_class);
+
+		Stripe &stripe = _stripe();
+		{
+			Mutex::Guard guard(stripe.mutex);
+
+			Magazine &magazine = stripe.magazines[size_class];
+
+			if (magazine.count == 0) {
+				magazine.count  = _heap._alloc_batch(class_size, magazine.blocks, BATCH);
+				stripe.cached  += magazine.count*class_size;
+			}
+
+			if (magazine.count) {
+				header = (Header *)magazine.blocks[--magazine.count];
+				stripe.cached -= class_size;
+			}
+		}
+
+		if (!header && !_alloc_uncached(class_size, &header))
+			return false;
+	}
+
+	header->size_class = size_class;
+	*out_addr = header + 1;
+	return true;
+}
+
+
+void Thread_cached_heap::free(void *addr, size_t)
+{
+	Header * const header = (Header *)addr - 1;
+
+	unsigned long const size_class = header->size_class;
+
+	if (size_class == Header::UNCACHED) {
+		_heap.free(header, 0);
+		return;
+	}
+
+	size_t const class_size = _class_size(size_class);
+
+	Stripe &stripe = _stripe();
+	Mutex::Guard guard(stripe.mutex);
+
+	Magazine &magazine = stripe.magazines[size_class];
+
+	/* return the older half of a full magazine to the heap */
+	if (magazine.count == MAGAZINE_SIZE) {
+		_heap._free_batch(magazine.blocks, BATCH);
+		memmove(magazine.blocks, magazine.blocks + BATCH,
+		        (MAGAZINE_SIZE - BATCH)*sizeof(void *));
+		magazine.count -= BATCH;
+		stripe.cached  -= BATCH*class_size;
+	}
+
+	magazine.blocks[magazine.count++] = header;
+	stripe.cached += class_size;
+}
+
+
+size_t Thread_cached_heap::consumed() const
+{
+	size_t cached = 0;
+	for (unsigned i = 0; i < NUM_STRIPES; i++)
+		cached += _stripes[i].cached;
+
+	size_t const used = _heap.consumed();
+	return used > cached ? used - cached : 0;
+}
+
+
+size_t Thread_cached_heap::overhead(size_t size) const
+{
+	return _heap.overhead(size) + sizeof(Header);
+}
+
+
+Thread_cached_heap::Stripe *Thread_cached_heap::_alloc_stripes(Heap &heap)
+{
+	Allocator &alloc = heap;
+
+	Stripe * const stripes = (Stripe *)alloc.alloc(NUM_STRIPES*sizeof(Stripe));
+
+	for (unsigned i = 0; i < NUM_STRIPES; i++)
+		construct_at<Stripe>(&stripes[i]);
+
+	return stripes;
+}
+
+
+Thread_cached_heap::Thread_cached_heap(Heap &heap)
+:
+	_heap(heap), _stripes(_alloc_stripes(heap))
+{ }
+
+
+Thread_cached_heap::~Thread_cached_heap()
+{
+	_flush_all();
+
+	for (unsigned i = 0; i < NUM_STRIPES; i++)
+		_stripes[i].~Stripe();
+
+	_heap.free(_stripes, NUM_STRIPES*sizeof(Stripe));
+}
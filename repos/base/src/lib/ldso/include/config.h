@@ -50,6 +50,28 @@ class Linker::Config : Noncopyable
 		bool const _verbose     = _config.attribute_value("ld_verbose",     false);
 		bool const _check_ctors = _config.attribute_value("ld_check_ctors", true);
 
+	public:
+
+		enum class Relocation_cache { NONE, RECORD, REPLAY };
+
+	private:
+
+		static Relocation_cache _relocation_cache_mode(Xml_node config)
+		{
+			typedef String<8> Mode;
+
+			Mode mode { };
+			config.with_sub_node("ld", [&] (Xml_node ld) {
+				mode = ld.attribute_value("relocation_cache", Mode()); });
+
+			if (mode == "record") return Relocation_cache::RECORD;
+			if (mode == "replay") return Relocation_cache::REPLAY;
+
+			return Relocation_cache::NONE;
+		}
+
+		Relocation_cache const _relocation_cache = _relocation_cache_mode(_config);
+
 	public:
 
 		Config(Env &env) : _config(env) { }
@@ -58,6 +80,8 @@ class Linker::Config : Noncopyable
 		bool verbose()     const { return _verbose; }
 		bool check_ctors() const { return _check_ctors; }
 
+		Relocation_cache relocation_cache() const { return _relocation_cache; }
+
 		typedef String<100> Rom_name;
 
 		/**
@@ -20,6 +20,8 @@
 
 namespace Linker {
 	struct Hash_table;
+	struct Gnu_hash_table;
+	struct Symbol_hash;
 	struct Dynamic;
 }
 
@@ -53,6 +55,102 @@ struct Linker::Hash_table
 };
 
 
+/**
+ * GNU hash table and hash function
+ *
+ * The table starts with a bloom filter that rejects most lookups of symbols
+ * not defined by the object without touching the hash chains. The chains
+ * store the hash values of the symbols so that names are compared only on a
+ * matching hash value. Symbols that are not part of the table, i.e., the
+ * undefined ones, precede the symbol index 'symoffset'.
+ */
+struct Linker::Gnu_hash_table
+{
+	typedef Genode::uint32_t uint32_t;
+
+	uint32_t nbuckets()    const { return ((uint32_t const *)this)[0]; }
+	uint32_t symoffset()   const { return ((uint32_t const *)this)[1]; }
+	uint32_t bloom_size()  const { return ((uint32_t const *)this)[2]; }
+	uint32_t bloom_shift() const { return ((uint32_t const *)this)[3]; }
+
+	Elf::Addr const *bloom() const {
+		return (Elf::Addr const *)((uint32_t const *)this + 4); }
+
+	uint32_t const *buckets() const {
+		return (uint32_t const *)(bloom() + bloom_size()); }
+
+	/**
+	 * Return hash value of symbol, the lowest bit marks the end of a chain
+	 */
+	uint32_t chain(unsigned long sym_index) const {
+		return (buckets() + nbuckets())[sym_index - symoffset()]; }
+
+	/**
+	 * Return false if the object does not define a symbol with 'hash'
+	 */
+	bool may_contain(uint32_t hash) const
+	{
+		enum { BITS = 8*sizeof(Elf::Addr) };
+
+		Elf::Addr const word = bloom()[(hash / BITS) % bloom_size()];
+		Elf::Addr const mask = ((Elf::Addr)1 << (hash % BITS))
+		                     | ((Elf::Addr)1 << ((hash >> bloom_shift()) % BITS));
+
+		return (word & mask) == mask;
+	}
+
+	/**
+	 * Return number of symbols of the symbol table
+	 *
+	 * The table does not store this number. The symbols of the last chain
+	 * are the last ones of the symbol table though.
+	 */
+	unsigned long nsyms() const
+	{
+		unsigned long last = 0;
+		for (uint32_t i = 0; i < nbuckets(); i++)
+			if (buckets()[i] > last)
+				last = buckets()[i];
+
+		if (last < symoffset())
+			return symoffset();
+
+		while (!(chain(last) & 1))
+			last++;
+
+		return last + 1;
+	}
+
+	/**
+	 * Hash function of the GNU hash table (Bernstein)
+	 */
+	static uint32_t hash(char const *name)
+	{
+		uint32_t h = 5381;
+		for (unsigned char const *p = (unsigned char const *)name; *p; p++)
+			h = h*33 + *p;
+
+		return h;
+	}
+};
+
+
+/**
+ * Hash values of a symbol name for both kinds of hash tables
+ *
+ * The hash values are calculated once per lookup and used for all objects
+ * the symbol is looked up in.
+ */
+struct Linker::Symbol_hash
+{
+	unsigned long    const sysv;
+	Genode::uint32_t const gnu;
+
+	Symbol_hash(char const *name)
+	: sysv(Hash_table::hash(name)), gnu(Gnu_hash_table::hash(name)) { }
+};
+
+
 /**
  * .dynamic section entries
  */
@@ -94,6 +192,10 @@ class Linker::Dynamic
 		Allocator           *_md_alloc      = nullptr;
 
 		Hash_table          *_hash_table    = nullptr;
+		Gnu_hash_table      *_gnu_hash_table = nullptr;
+
+		/* number of symbols, determined on first use */
+		mutable unsigned long _nsyms        = 0;
 
 		Elf::Rela           *_reloca        = nullptr;
 		unsigned long        _reloca_size   = 0;
@@ -158,6 +260,7 @@ class Linker::Dynamic
 				case DT_PLTRELSZ: _pltrel_size = d->un.val;                             break;
 				case DT_PLTGOT  : _section<typeof(_pltgot)>(&_pltgot, d);               break;
 				case DT_HASH    : _section<typeof(_hash_table)>(&_hash_table, d);       break;
+				case DT_GNU_HASH: _section<typeof(_gnu_hash_table)>(&_gnu_hash_table, d); break;
 				case DT_RELA    : _section<typeof(_reloca)>(&_reloca, d);               break;
 				case DT_RELASZ  : _reloca_size = d->un.val;                             break;
 				case DT_SYMTAB  : _section<typeof(_symtab)>(&_symtab, d);               break;
@@ -214,9 +317,17 @@ class Linker::Dynamic
 			_init_function();
 		}
 
+		unsigned long nsyms() const
+		{
+			if (!_nsyms)
+				_nsyms = _hash_table ? _hash_table->nchains()
+				                     : _gnu_hash_table->nsyms();
+			return _nsyms;
+		}
+
 		Elf::Sym const *symbol(unsigned sym_index) const
 		{
-			if (sym_index > _hash_table->nchains())
+			if (sym_index > nsyms())
 				return nullptr;
 
 			return _symtab + sym_index;
@@ -227,6 +338,24 @@ class Linker::Dynamic
 			return _strtab + sym.st_name;
 		}
 
+		/**
+		 * Return index of symbol within the symbol table
+		 */
+		unsigned long symbol_index(Elf::Sym const &sym) const
+		{
+			return &sym - _symtab;
+		}
+
+		/**
+		 * Call 'fn' with the address and size of the symbol and string table
+		 */
+		template <typename FN>
+		void with_symbol_tables(FN const &fn) const
+		{
+			fn((void const *)_symtab, nsyms()*sizeof(Elf::Sym));
+			fn((void const *)_strtab, (size_t)_strtab_size);
+		}
+
 		void const *dynamic_ptr() const { return &_dynamic; }
 
 		void dep(Dependency const &dep) { _dep = &dep; }
@@ -234,15 +363,40 @@ class Linker::Dynamic
 		Dependency const &dep() const { return *_dep; }
 
 		/*
-		 * Use DT_HASH table address for linker, assuming that it will always be at
-		 * the beginning of the file
+		 * Use hash-table address for linker, assuming that it will always be
+		 * at the beginning of the file
 		 */
-		Elf::Addr link_map_addr() const { return trunc_page((Elf::Addr)_hash_table); }
+		Elf::Addr link_map_addr() const
+		{
+			return _hash_table ? trunc_page((Elf::Addr)_hash_table)
+			                   : trunc_page((Elf::Addr)_gnu_hash_table);
+		}
+
+	private:
 
 		/**
-		 * Lookup symbol name in this ELF
+		 * Return symbol if it is a defined symbol with the given name
 		 */
-		Elf::Sym const *lookup_symbol(char const *name, unsigned long hash) const
+		Elf::Sym const *_match(unsigned long sym_index, char const *name) const
+		{
+			Elf::Sym const *sym      = _symtab + sym_index;
+			char const     *sym_name = symbol_name(*sym);
+
+			/* this omitts everything but 'NOTYPE', 'OBJECT', and 'FUNC' */
+			if (sym->type() > STT_FUNC)
+				return nullptr;
+
+			if (sym->st_value == 0)
+				return nullptr;
+
+			/* check for symbol name */
+			if (name[0] != sym_name[0] || strcmp(name, sym_name))
+				return nullptr;
+
+			return sym;
+		}
+
+		Elf::Sym const *_lookup_sysv(char const *name, unsigned long hash) const
 		{
 			Hash_table *h = _hash_table;
 
@@ -258,24 +412,51 @@ class Linker::Dynamic
 				if (sym_index > h->nchains())
 					return nullptr;
 
-				Elf::Sym const *sym      = symbol(sym_index);
-				char const     *sym_name = symbol_name(*sym);
+				if (Elf::Sym const *sym = _match(sym_index, name))
+					return sym;
+			}
 
-				/* this omitts everything but 'NOTYPE', 'OBJECT', and 'FUNC' */
-				if (sym->type() > STT_FUNC)
-					continue;
+			return nullptr;
+		}
 
-				if (sym->st_value == 0)
-					continue;
+		Elf::Sym const *_lookup_gnu(char const *name, Genode::uint32_t hash) const
+		{
+			Gnu_hash_table const &h = *_gnu_hash_table;
 
-				/* check for symbol name */
-				if (name[0] != sym_name[0] || strcmp(name, sym_name))
-					continue;
+			if (!h.nbuckets() || !h.bloom_size() || !h.may_contain(hash))
+				return nullptr;
+
+			unsigned long sym_index = h.buckets()[hash % h.nbuckets()];
+
+			/* empty bucket */
+			if (sym_index < h.symoffset())
+				return nullptr;
+
+			/* traverse hash chain, comparing names only on matching hashes */
+			for (;; sym_index++) {
 
-				return sym;
+				Genode::uint32_t const chain_hash = h.chain(sym_index);
+
+				if ((chain_hash | 1) == (hash | 1))
+					if (Elf::Sym const *sym = _match(sym_index, name))
+						return sym;
+
+				if (chain_hash & 1)
+					return nullptr;
 			}
+		}
 
-			return nullptr;
+	public:
+
+		/**
+		 * Lookup symbol name in this ELF
+		 *
+		 * The GNU hash table is preferred if the object provides one.
+		 */
+		Elf::Sym const *lookup_symbol(char const *name, Symbol_hash const &hash) const
+		{
+			return _gnu_hash_table ? _lookup_gnu(name, hash.gnu)
+			                       : _lookup_sysv(name, hash.sysv);
 		}
 
 		/**
@@ -285,7 +466,7 @@ class Linker::Dynamic
 		{
 			addr_t const reloc_base = _obj.reloc_base();
 
-			for (unsigned long i = 0; i < _hash_table->nchains(); i++)
+			for (unsigned long i = 0; i < nsyms(); i++)
 			{
 				Elf::Sym const *sym = symbol(i);
 				if (!sym)
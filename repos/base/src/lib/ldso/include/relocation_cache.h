@@ -0,0 +1,152 @@
+/*
+ * \brief  Cache of the symbol bindings of the dynamic binary
+ * \author Sebastian Sumpf
+ * \date   2026-10-17
+ *
+ * Resolving the symbol of a relocation means looking up its name in the
+ * objects of the dependency list. For a given list of objects, the outcome
+ * is always the same. In record mode, the linker keeps the binding of each
+ * resolved symbol, i.e., the defining object and the index of the symbol
+ * within this object, and reports the bindings as "ld_relocation_cache"
+ * once the binary is relocated. In replay mode, the bindings are taken from
+ * the ROM module of the same name, which lets the relocation skip the
+ * symbol lookups.
+ *
+ * Bindings refer to objects by their position within the dependency list.
+ * The cache is used only if the name, the position, and the checksum over
+ * the symbol and string tables of each object match the recorded ones.
+ * Otherwise, all symbols are resolved regularly.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__RELOCATION_CACHE_H_
+#define _INCLUDE__RELOCATION_CACHE_H_
+
+/* Genode includes */
+#include <base/attached_rom_dataspace.h>
+
+/* local includes */
+#include <linker.h>
+
+namespace Linker { class Relocation_cache; }
+
+
+class Linker::Relocation_cache : Noncopyable
+{
+	public:
+
+		typedef Config::Relocation_cache Mode;
+
+		enum { MAX_OBJECTS = 64 };
+
+	private:
+
+		enum { MAGIC = 0x4c445243 /* "LDRC" */, VERSION = 1, NAME_LEN = 64 };
+
+		/*
+		 * Layout of the cache: header, one 'Object_info' per object, and
+		 * one 'Binding' per symbol of each object
+		 */
+
+		struct Header
+		{
+			uint32_t magic;
+			uint32_t version;
+			uint32_t num_objects;
+			uint32_t num_bindings;
+		};
+
+		struct Object_info
+		{
+			char     name[NAME_LEN];
+			uint32_t checksum;
+			uint32_t nsyms;
+			uint32_t first_binding;
+		};
+
+		struct Binding
+		{
+			enum { UNRESOLVED = ~0U };
+
+			uint32_t object;
+			uint32_t symbol;
+		};
+
+		Env       &_env;
+		Allocator &_md_alloc;
+		Mode       _mode;
+
+		Dependency const *_first = nullptr;
+
+		Object const *_objects[MAX_OBJECTS] { };
+		unsigned      _num_objects = 0;
+
+		/* bindings of each object indexed by the symbol index */
+		Binding       *_bindings[MAX_OBJECTS] { };
+		unsigned long  _nsyms[MAX_OBJECTS]    { };
+
+		/* recorded bindings */
+		Binding      *_records      = nullptr;
+		unsigned long _num_bindings = 0;
+
+		Constructible<Attached_rom_dataspace> _rom { };
+
+		/*
+		 * Noncopyable
+		 */
+		Relocation_cache(Relocation_cache const &);
+		Relocation_cache &operator = (Relocation_cache const &);
+
+		static uint32_t _checksum(Object const &);
+
+		int _index(Object const &) const;
+
+		bool _import_rom();
+		void _alloc_records();
+
+	public:
+
+		Relocation_cache(Env &env, Allocator &md_alloc, Mode mode)
+		: _env(env), _md_alloc(md_alloc), _mode(mode) { }
+
+		~Relocation_cache();
+
+		/**
+		 * Activate cache for the objects of dependency list
+		 *
+		 * Must be called after loading all objects and before relocating
+		 * them.
+		 */
+		void activate(Dependency const &first);
+
+		/**
+		 * Return symbol bound to symbol index of dependency
+		 *
+		 * \return  symbol or 'nullptr' if the binding is not cached
+		 */
+		Elf::Sym const *lookup(Dependency const &dep, unsigned sym_index,
+		                       Elf::Addr *base);
+
+		/**
+		 * Record binding of resolved symbol
+		 *
+		 * \param base  relocation base of the object that defines 'sym'
+		 */
+		void record(Dependency const &dep, unsigned sym_index,
+		            Elf::Addr base, Elf::Sym const &sym);
+
+		/**
+		 * Report recorded bindings
+		 */
+		void report();
+
+		bool recording() const { return _mode == Mode::RECORD; }
+};
+
+#endif /* _INCLUDE__RELOCATION_CACHE_H_ */
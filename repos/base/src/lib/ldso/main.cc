@@ -30,6 +30,7 @@
 #include <init.h>
 #include <region_map.h>
 #include <config.h>
+#include <relocation_cache.h>
 
 using namespace Linker;
 
@@ -44,6 +45,7 @@ namespace Linker {
 };
 
 static    Binary *binary_ptr = nullptr;
+static    Relocation_cache *relocation_cache_ptr = nullptr;
 bool      Linker::verbose  = false;
 Stage     Linker::stage    = STAGE_BINARY;
 Link_map *Link_map::first;
@@ -177,7 +179,7 @@ class Linker::Elf_object : public Object, private Fifo<Elf_object>::Element
 			return _dyn.symbol_name(sym);
 		}
 
-		Elf::Sym const *lookup_symbol(char const *name, unsigned long hash) const
+		Elf::Sym const *lookup_symbol(char const *name, Symbol_hash const &hash) const
 		{
 			return _dyn.lookup_symbol(name, hash);
 		}
@@ -361,6 +363,8 @@ struct Linker::Binary : private Root_object, public Elf_object
 
 	bool const _check_ctors;
 
+	Relocation_cache _relocation_cache;
+
 	bool static_construction_finished = false;
 
 	Binary(Env &env, Allocator &md_alloc, Config const &config, char const *name)
@@ -368,7 +372,8 @@ struct Linker::Binary : private Root_object, public Elf_object
 		Root_object(md_alloc),
 		Elf_object(env, md_alloc, name,
 		           *new (md_alloc) Dependency(*this, this), DONT_KEEP),
-		_check_ctors(config.check_ctors())
+		_check_ctors(config.check_ctors()),
+		_relocation_cache(env, md_alloc, config.relocation_cache())
 	{
 		/* create dep for binary and linker */
 		Dependency *binary = const_cast<Dependency *>(&dynamic().dep());
@@ -387,8 +392,23 @@ struct Linker::Binary : private Root_object, public Elf_object
 		/* load dependencies */
 		binary->load_needed(env, md_alloc, deps(), DONT_KEEP);
 
+		/* bind symbols via the relocation cache if configured */
+		_relocation_cache.activate(*first_dep());
+		relocation_cache_ptr = &_relocation_cache;
+
+		/* record the bindings of all jump slots */
+		Bind const bind = _relocation_cache.recording() ? BIND_NOW : config.bind();
+
 		/* relocate and call constructors */
-		Init::list()->initialize(config.bind(), STAGE_BINARY);
+		Init::list()->initialize(bind, STAGE_BINARY);
+
+		_relocation_cache.report();
+	}
+
+	~Binary()
+	{
+		if (relocation_cache_ptr == &_relocation_cache)
+			relocation_cache_ptr = nullptr;
 	}
 
 	Elf::Addr lookup_symbol(char const *name)
@@ -503,8 +523,8 @@ struct Linker::Binary : private Root_object, public Elf_object
 
 Elf::Addr Linker::Object::_symbol_address(char const *name)
 {
-	unsigned long   hash = Hash_table::hash(name);
-	Elf::Sym const *sym  = dynamic().lookup_symbol(name, hash);
+	Symbol_hash const hash { name };
+	Elf::Sym    const *sym = dynamic().lookup_symbol(name, hash);
 
 	if (sym)
 		return reloc_base() + sym->st_value;
@@ -569,7 +589,19 @@ Elf::Sym const *Linker::lookup_symbol(unsigned sym_index, Dependency const &dep,
 		return symbol;
 	}
 
-	return lookup_symbol(elf.symbol_name(*symbol), dep, base, undef, other);
+	/* lookups of undefined symbols and for copy relocations are not cached */
+	Relocation_cache *cache = (undef || other) ? nullptr : relocation_cache_ptr;
+
+	if (cache)
+		if (Elf::Sym const *cached = cache->lookup(dep, sym_index, base))
+			return cached;
+
+	Elf::Sym const *sym = lookup_symbol(elf.symbol_name(*symbol), dep, base, undef, other);
+
+	if (cache && sym)
+		cache->record(dep, sym_index, *base, *sym);
+
+	return sym;
 }
 
 
@@ -577,7 +609,7 @@ Elf::Sym const *Linker::lookup_symbol(char const *name, Dependency const &dep,
                                       Elf::Addr *base, bool undef, bool other)
 {
 	Dependency const *curr        = &dep.first();
-	unsigned long     hash        = Hash_table::hash(name);
+	Symbol_hash const hash        { name };
 	Elf::Sym   const *weak_symbol = 0;
 	Elf::Addr        weak_base    = 0;
 	Elf::Sym   const *symbol      = 0;
@@ -0,0 +1,246 @@
+/*
+ * \brief  Cache of the symbol bindings of the dynamic binary
+ * \author Sebastian Sumpf
+ * \date   2026-10-17
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/attached_dataspace.h>
+#include <report_session/connection.h>
+
+/* local includes */
+#include <relocation_cache.h>
+#include <dynamic.h>
+
+using namespace Linker;
+
+
+static char const *cache_name() { return "ld_relocation_cache"; }
+
+
+Genode::uint32_t Relocation_cache::_checksum(Object const &obj)
+{
+	/* FNV-1a */
+	uint32_t sum = 2166136261U;
+
+	obj.dynamic().with_symbol_tables([&] (void const *data, size_t size) {
+		uint8_t const *bytes = (uint8_t const *)data;
+		for (size_t i = 0; i < size; i++)
+			sum = (sum ^ bytes[i]) * 16777619U;
+	});
+	return sum;
+}
+
+
+int Relocation_cache::_index(Object const &obj) const
+{
+	for (unsigned i = 0; i < _num_objects; i++)
+		if (_objects[i] == &obj)
+			return i;
+
+	return -1;
+}
+
+
+bool Relocation_cache::_import_rom()
+{
+	try { _rom.construct(_env, cache_name()); }
+	catch (...) { return false; }
+
+	size_t const  size   = _rom->size();
+	Header const &header = *_rom->local_addr<Header const>();
+
+	if (size < sizeof(Header)
+	 || header.magic       != MAGIC
+	 || header.version     != VERSION
+	 || header.num_objects != _num_objects)
+		return false;
+
+	size_t const info_size = _num_objects*sizeof(Object_info);
+	if (size - sizeof(Header) < info_size
+	 || (size - sizeof(Header) - info_size) / sizeof(Binding) < header.num_bindings)
+		return false;
+
+	Object_info const *info     = (Object_info const *)(&header + 1);
+	Binding           *bindings = (Binding *)(info + _num_objects);
+
+	for (unsigned i = 0; i < _num_objects; i++) {
+
+		Object_info const &o = info[i];
+
+		if (strcmp(o.name, _objects[i]->name(), NAME_LEN)
+		 || o.nsyms != _nsyms[i]
+		 || o.first_binding > header.num_bindings
+		 || header.num_bindings - o.first_binding < o.nsyms
+		 || o.checksum != _checksum(*_objects[i]))
+			return false;
+
+		_bindings[i] = bindings + o.first_binding;
+	}
+
+	/* reject bindings that refer to non-existing symbols */
+	for (unsigned i = 0; i < _num_objects; i++)
+		for (unsigned long s = 0; s < _nsyms[i]; s++) {
+
+			Binding const &b = _bindings[i][s];
+			if (b.object == Binding::UNRESOLVED)
+				continue;
+
+			if (b.object >= _num_objects || b.symbol >= _nsyms[b.object])
+				return false;
+		}
+
+	return true;
+}
+
+
+void Relocation_cache::_alloc_records()
+{
+	for (unsigned i = 0; i < _num_objects; i++)
+		_num_bindings += _nsyms[i];
+
+	_records = (Binding *)_md_alloc.alloc(_num_bindings*sizeof(Binding));
+
+	Binding *b = _records;
+	for (unsigned i = 0; i < _num_objects; i++) {
+		_bindings[i] = b;
+		for (unsigned long s = 0; s < _nsyms[i]; s++)
+			*b++ = Binding { Binding::UNRESOLVED, 0 };
+	}
+}
+
+
+Relocation_cache::~Relocation_cache()
+{
+	if (_records)
+		_md_alloc.free(_records, _num_bindings*sizeof(Binding));
+}
+
+
+void Relocation_cache::activate(Dependency const &first)
+{
+	if (_mode == Mode::NONE)
+		return;
+
+	_first = &first;
+
+	for (Dependency const *d = &first; d; d = d->next()) {
+
+		if (_num_objects == MAX_OBJECTS) {
+			warning("LD: too many objects for relocation cache");
+			_mode = Mode::NONE;
+			return;
+		}
+		_objects[_num_objects] = &d->obj();
+		_nsyms  [_num_objects] = d->obj().dynamic().nsyms();
+		_num_objects++;
+	}
+
+	if (_mode == Mode::RECORD) {
+		_alloc_records();
+		return;
+	}
+
+	if (!_import_rom()) {
+		warning("LD: relocation cache does not match the loaded objects, "
+		        "resolving symbols regularly");
+		_mode = Mode::NONE;
+	}
+}
+
+
+Elf::Sym const *Relocation_cache::lookup(Dependency const &dep,
+                                         unsigned sym_index, Elf::Addr *base)
+{
+	if (_mode != Mode::REPLAY || &dep.first() != _first)
+		return nullptr;
+
+	int const i = _index(dep.obj());
+	if (i < 0 || sym_index >= _nsyms[i])
+		return nullptr;
+
+	Binding const &b = _bindings[i][sym_index];
+	if (b.object == Binding::UNRESOLVED)
+		return nullptr;
+
+	Object const &obj = *_objects[b.object];
+
+	*base = obj.reloc_base();
+	return obj.dynamic().symbol(b.symbol);
+}
+
+
+void Relocation_cache::record(Dependency const &dep, unsigned sym_index,
+                              Elf::Addr base, Elf::Sym const &sym)
+{
+	if (_mode != Mode::RECORD || &dep.first() != _first)
+		return;
+
+	int const i = _index(dep.obj());
+	if (i < 0 || sym_index >= _nsyms[i])
+		return;
+
+	/* find defining object by its relocation base */
+	for (unsigned j = 0; j < _num_objects; j++) {
+
+		Object const &obj = *_objects[j];
+		if (obj.reloc_base() != base)
+			continue;
+
+		unsigned long const index = obj.dynamic().symbol_index(sym);
+		if (index < _nsyms[j])
+			_bindings[i][sym_index] = Binding { j, (uint32_t)index };
+
+		return;
+	}
+}
+
+
+void Relocation_cache::report()
+{
+	if (_mode != Mode::RECORD)
+		return;
+
+	size_t const size = sizeof(Header) + _num_objects*sizeof(Object_info)
+	                  + _num_bindings*sizeof(Binding);
+	try {
+		Report::Connection report(_env, cache_name(), size);
+		Attached_dataspace ds(_env.rm(), report.dataspace());
+
+		Header &header = *ds.local_addr<Header>();
+		header = Header { MAGIC, VERSION, _num_objects, (uint32_t)_num_bindings };
+
+		Object_info *info     = (Object_info *)(&header + 1);
+		Binding     *bindings = (Binding *)(info + _num_objects);
+
+		uint32_t first_binding = 0;
+		for (unsigned i = 0; i < _num_objects; i++) {
+
+			Object_info &o = info[i];
+			strncpy(o.name, _objects[i]->name(), NAME_LEN);
+			o.checksum      = _checksum(*_objects[i]);
+			o.nsyms         = (uint32_t)_nsyms[i];
+			o.first_binding = first_binding;
+
+			memcpy(bindings + first_binding, _bindings[i],
+			       _nsyms[i]*sizeof(Binding));
+			first_binding += o.nsyms;
+		}
+
+		report.submit(size);
+
+		if (verbose)
+			log("LD: recorded relocation cache of ", _num_objects, " objects");
+	}
+	catch (...) { warning("LD: unable to report relocation cache"); }
+
+	/* bindings resolved later on are not recorded */
+	_mode = Mode::NONE;
+}
@@ -13,6 +13,7 @@
 
 /* Genode includes */
 #include <timer/timeout.h>
+#include <util/misc_math.h>
 
 using namespace Genode;
 
@@ -106,9 +107,10 @@ void Alarm_timeout_scheduler::handle_timeout(Duration duration)
 
 
 Alarm_timeout_scheduler::Alarm_timeout_scheduler(Time_source  &time_source,
-                                                 Microseconds  min_handle_period)
+                                                 Microseconds  min_handle_period,
+                                                 Queue         queue)
 :
-	_time_source(time_source)
+	_time_source(time_source), _queue(queue)
 {
 	Alarm::Time const deadline         = _now + min_handle_period.value;
 	_min_handle_period.period          = min_handle_period.value;
@@ -118,6 +120,13 @@ Alarm_timeout_scheduler::Alarm_timeout_scheduler(Time_source  &time_source,
 }
 
 
+Alarm_timeout_scheduler::Alarm_timeout_scheduler(Time_source  &time_source,
+                                                 Microseconds  min_handle_period)
+:
+	Alarm_timeout_scheduler(time_source, min_handle_period, Queue::SORTED_LIST)
+{ }
+
+
 Alarm_timeout_scheduler::~Alarm_timeout_scheduler()
 {
 	Lock::Guard lock_guard(_lock);
@@ -126,6 +135,12 @@ Alarm_timeout_scheduler::~Alarm_timeout_scheduler()
 		_active_head->_alarm_reset();
 		_active_head = next;
 	}
+	for (Wheel_list &list : _wheel_lists) {
+		while (Alarm *alarm = list.head) {
+			list.head = alarm->_next;
+			alarm->_alarm_reset();
+		}
+	}
 }
 
 
@@ -175,6 +190,11 @@ void Alarm_timeout_scheduler::_alarm_unsynchronized_enqueue(Alarm *alarm)
 
 	alarm->_active++;
 
+	if (_queue == Queue::TIMING_WHEEL) {
+		_wheel_link(*alarm, _wheel_list_index(alarm->_raw));
+		return;
+	}
+
 	/* if active alarm list is empty add first element */
 	if (!_active_head) {
 		alarm->_next = 0;
@@ -211,6 +231,16 @@ void Alarm_timeout_scheduler::_alarm_unsynchronized_enqueue(Alarm *alarm)
 
 void Alarm_timeout_scheduler::_alarm_unsynchronized_dequeue(Alarm *alarm)
 {
+	if (_queue == Queue::TIMING_WHEEL) {
+
+		/* alarm is not enqueued */
+		if (!alarm->_active) return;
+
+		_wheel_unlink(*alarm);
+		alarm->_alarm_reset();
+		return;
+	}
+
 	if (!_active_head) return;
 
 	if (_active_head == alarm) {
@@ -236,12 +266,28 @@ Timeout::Alarm *Alarm_timeout_scheduler::_alarm_get_pending_alarm()
 {
 	Lock::Guard lock_guard(_lock);
 
-	if (!_active_head || !_active_head->_raw.is_pending_at(_now, _now_period)) {
-		return nullptr; }
+	Alarm *pending_alarm = nullptr;
+
+	if (_queue == Queue::TIMING_WHEEL) {
 
-	/* remove alarm from head of the list */
-	Alarm *pending_alarm = _active_head;
-	_active_head = _active_head->_next;
+		/* move all alarms with a deadline up to now to the due list */
+		_wheel_advance(_now);
+
+		pending_alarm = _wheel_lists[WHEEL_DUE].head;
+		if (!pending_alarm) {
+			return nullptr; }
+
+		_wheel_unlink(*pending_alarm);
+
+	} else {
+
+		if (!_active_head || !_active_head->_raw.is_pending_at(_now, _now_period)) {
+			return nullptr; }
+
+		/* remove alarm from head of the list */
+		pending_alarm = _active_head;
+		_active_head = _active_head->_next;
+	}
 
 	/*
 	 * Acquire dispatch lock to defer destruction until the call of '_on_alarm'
@@ -265,6 +311,11 @@ void Alarm_timeout_scheduler::_alarm_handle(Alarm::Time curr_time)
 	 */
 	if (_now > curr_time) {
 		_now_period = !_now_period;
+
+		if (_queue == Queue::TIMING_WHEEL) {
+			Lock::Guard lock_guard(_lock);
+			_wheel_rebase();
+		}
 	}
 	_now = curr_time;
 
@@ -412,13 +463,290 @@ bool Alarm_timeout_scheduler::_alarm_next_deadline(Alarm::Time *deadline)
 {
 	Lock::Guard alarm_list_lock_guard(_lock);
 
-	if (!_active_head) return false;
+	Alarm::Time next_deadline;
+	if (_queue == Queue::TIMING_WHEEL) {
+		if (!_wheel_next_deadline(next_deadline)) return false;
+	} else {
+		if (!_active_head) return false;
+		next_deadline = _active_head->_raw.deadline;
+	}
 
 	if (deadline)
-		*deadline = _active_head->_raw.deadline;
+		*deadline = next_deadline;
 
 	if (*deadline < _min_handle_period.deadline) {
 		*deadline = _min_handle_period.deadline;
 	}
 	return true;
 }
+
+
+bool Alarm_timeout_scheduler::_alarm_head_timeout(const Alarm * alarm)
+{
+	if (_queue == Queue::SORTED_LIST)
+		return _active_head == alarm;
+
+	Lock::Guard alarm_list_lock_guard(_lock);
+
+	if (!alarm->_active || alarm->_raw.deadline_period != _now_period)
+		return false;
+
+	if (alarm->_wheel_list == WHEEL_DUE)
+		return true;
+
+	Alarm::Time deadline;
+	return _wheel_next_deadline(deadline) && alarm->_raw.deadline <= deadline;
+}
+
+
+/*************************************************
+ ** Timing wheel of the Alarm_timeout_scheduler **
+ *************************************************/
+
+unsigned Alarm_timeout_scheduler::_wheel_list_index(Alarm::Raw const &raw) const
+{
+	/* deadline lies beyond the wrap of the time counter */
+	if (raw.deadline_period != _now_period)
+		return WHEEL_OVERFLOW;
+
+	if (raw.deadline < _wheel_time)
+		return WHEEL_DUE;
+
+	Alarm::Time const distance = raw.deadline - _wheel_time;
+	for (unsigned level = 0; level < WHEEL_LEVELS; level++) {
+
+		unsigned const shift = level * WHEEL_SLOT_BITS;
+		if (distance >> shift < WHEEL_SLOTS)
+			return level * WHEEL_SLOTS +
+			       ((raw.deadline >> shift) & (WHEEL_SLOTS - 1));
+	}
+	return WHEEL_OVERFLOW;
+}
+
+
+void Alarm_timeout_scheduler::_wheel_link(Alarm &alarm, unsigned index)
+{
+	Wheel_list &list = _wheel_lists[index];
+
+	if (!list.head || alarm._raw.deadline < list.min_deadline)
+		list.min_deadline = alarm._raw.deadline;
+
+	alarm._wheel_list = index;
+	alarm._prev       = nullptr;
+	alarm._next       = list.head;
+
+	if (list.head)
+		list.head->_prev = &alarm;
+
+	list.head = &alarm;
+
+	if (index < WHEEL_DUE)
+		_wheel_occupied[index / WHEEL_SLOTS] |= 1ULL << (index % WHEEL_SLOTS);
+}
+
+
+void Alarm_timeout_scheduler::_wheel_unlink(Alarm &alarm)
+{
+	unsigned const index = alarm._wheel_list;
+	Wheel_list    &list  = _wheel_lists[index];
+
+	if (alarm._prev)
+		alarm._prev->_next = alarm._next;
+	else
+		list.head = alarm._next;
+
+	if (alarm._next)
+		alarm._next->_prev = alarm._prev;
+
+	alarm._next = nullptr;
+	alarm._prev = nullptr;
+
+	if (!list.head && index < WHEEL_DUE)
+		_wheel_occupied[index / WHEEL_SLOTS] &= ~(1ULL << (index % WHEEL_SLOTS));
+}
+
+
+void Alarm_timeout_scheduler::_wheel_move(unsigned index)
+{
+	Alarm *alarm = _wheel_lists[index].head;
+
+	_wheel_lists[index].head = nullptr;
+	if (index < WHEEL_DUE)
+		_wheel_occupied[index / WHEEL_SLOTS] &= ~(1ULL << (index % WHEEL_SLOTS));
+
+	while (alarm) {
+		Alarm *next = alarm->_next;
+		_wheel_link(*alarm, _wheel_list_index(alarm->_raw));
+		alarm = next;
+	}
+}
+
+
+bool Alarm_timeout_scheduler::_wheel_next_slot(unsigned     level,
+                                               Alarm::Time &start,
+                                               unsigned    &slot) const
+{
+	uint64_t const occupied = _wheel_occupied[level];
+	if (!occupied)
+		return false;
+
+	unsigned const shift = level * WHEEL_SLOT_BITS;
+	unsigned const curr  = (_wheel_time >> shift) & (WHEEL_SLOTS - 1);
+
+	/*
+	 * The current slot is still ahead if the wheel time is at its start.
+	 * Otherwise, it was processed already and contains alarms of the next
+	 * rotation only.
+	 */
+	unsigned const first = (_wheel_time & ((1ULL << shift) - 1)) ? curr + 1 : curr;
+	uint64_t const ahead = first < WHEEL_SLOTS ? occupied & (~0ULL << first) : 0;
+
+	Alarm::Time rotation = _wheel_time >> shift >> WHEEL_SLOT_BITS << WHEEL_SLOT_BITS;
+	if (ahead) {
+		slot = __builtin_ctzll(ahead);
+	} else {
+		slot = __builtin_ctzll(occupied);
+		rotation += WHEEL_SLOTS;
+	}
+	start = (rotation + slot) << shift;
+	return true;
+}
+
+
+bool Alarm_timeout_scheduler::_wheel_next_event(Alarm::Time &time) const
+{
+	bool found = false;
+
+	/*
+	 * The overflow list is examined at the start of a rotation of the top
+	 * level. Rotations before the one of the earliest deadline are skipped.
+	 */
+	Alarm::Time const span     = 1ULL << (WHEEL_LEVELS * WHEEL_SLOT_BITS);
+	Alarm::Time const rotation = (_wheel_time + span - 1) & ~(span - 1);
+
+	Wheel_list const &overflow = _wheel_lists[WHEEL_OVERFLOW];
+	if (overflow.head && rotation >= _wheel_time) {
+		time  = max(rotation, overflow.min_deadline & ~(span - 1));
+		found = true;
+	}
+	/* a start before the wheel time lies beyond the wrap of the counter */
+	for (unsigned level = 0; level < WHEEL_LEVELS; level++) {
+
+		Alarm::Time start;
+		unsigned    slot;
+		if (!_wheel_next_slot(level, start, slot) || start < _wheel_time)
+			continue;
+
+		if (!found || start < time)
+			time = start;
+
+		found = true;
+	}
+	return found;
+}
+
+
+void Alarm_timeout_scheduler::_wheel_process(Alarm::Time time)
+{
+	_wheel_time = time + 1;
+
+	Alarm::Time const span = 1ULL << (WHEEL_LEVELS * WHEEL_SLOT_BITS);
+	if (!(time & (span - 1)))
+		_wheel_move(WHEEL_OVERFLOW);
+
+	/* cascade the slots that start at 'time', top level first */
+	for (unsigned level = WHEEL_LEVELS - 1; level > 0; level--) {
+
+		unsigned const shift = level * WHEEL_SLOT_BITS;
+		if (time & ((1ULL << shift) - 1))
+			continue;
+
+		_wheel_move(level * WHEEL_SLOTS + ((time >> shift) & (WHEEL_SLOTS - 1)));
+	}
+
+	/* the alarms of the level-0 slot are due */
+	_wheel_move(time & (WHEEL_SLOTS - 1));
+}
+
+
+void Alarm_timeout_scheduler::_wheel_advance(Alarm::Time now)
+{
+	while (_wheel_time <= now) {
+
+		Alarm::Time time;
+		if (!_wheel_next_event(time) || time > now) {
+			_wheel_time = now + 1;
+			return;
+		}
+		_wheel_process(time);
+	}
+}
+
+
+void Alarm_timeout_scheduler::_wheel_rebase()
+{
+	/*
+	 * The time counter wrapped. All alarms of the wheel belong to the last
+	 * period and are due. Alarms of the overflow list that belong to the new
+	 * period are re-inserted relative to the new wheel time.
+	 */
+	Alarm *overflow = _wheel_lists[WHEEL_OVERFLOW].head;
+	_wheel_lists[WHEEL_OVERFLOW].head = nullptr;
+
+	for (unsigned index = 0; index < WHEEL_DUE; index++) {
+		while (Alarm *alarm = _wheel_lists[index].head) {
+			_wheel_unlink(*alarm);
+			_wheel_link(*alarm, WHEEL_DUE);
+		}
+	}
+	_wheel_time = 0;
+
+	while (overflow) {
+		Alarm *next = overflow->_next;
+		_wheel_link(*overflow, overflow->_raw.deadline_period == _now_period ?
+		                       _wheel_list_index(overflow->_raw) : (unsigned)WHEEL_DUE);
+		overflow = next;
+	}
+}
+
+
+bool Alarm_timeout_scheduler::_wheel_next_deadline(Alarm::Time &deadline) const
+{
+	if (_wheel_lists[WHEEL_DUE].head) {
+		deadline = _wheel_lists[WHEEL_DUE].min_deadline;
+		return true;
+	}
+
+	/*
+	 * The first occupied slot of each level contains the earliest deadlines
+	 * of the level. At level 0, the start of the slot is the deadline. At the
+	 * other levels, the minimum deadline of the slot is a lower bound as it
+	 * is not raised when discarding alarms.
+	 */
+	bool found = false;
+
+	/* the overflow list may contain deadlines of the next counter period */
+	Wheel_list const &overflow = _wheel_lists[WHEEL_OVERFLOW];
+	if (overflow.head && overflow.min_deadline >= _wheel_time) {
+		deadline = overflow.min_deadline;
+		found    = true;
+	}
+
+	for (unsigned level = 0; level < WHEEL_LEVELS; level++) {
+
+		Alarm::Time start;
+		unsigned    slot;
+		if (!_wheel_next_slot(level, start, slot) || start < _wheel_time)
+			continue;
+
+		Alarm::Time const min_deadline =
+			_wheel_lists[level * WHEEL_SLOTS + slot].min_deadline;
+
+		Alarm::Time const candidate = max(start, min_deadline);
+		if (!found || candidate < deadline)
+			deadline = candidate;
+
+		found = true;
+	}
+	return found;
+}
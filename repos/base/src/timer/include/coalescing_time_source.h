@@ -0,0 +1,100 @@
+/*
+ * \brief  Time source that batches the expiries of all sessions
+ * \author Martin Stein
+ * \date   2026-10-17
+ *
+ * A session with timer slack accepts that its one-shot timeout triggers
+ * up to the slack after the requested deadline. Its timeout is scheduled
+ * at the end of this window. Whenever the timer wakes up, the sessions
+ * whose requested deadline passed already are signalled right away and
+ * their timeouts are discarded. So, the expiries of sessions with close-by
+ * deadlines are batched into one wakeup instead of one wakeup each.
+ *
+ * This has to happen before the timeout scheduler handles the wakeup.
+ * Discarding a timeout from within the handler of another timeout is not
+ * allowed, and the scheduler then programs the next wakeup with the
+ * batched timeouts removed already.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _COALESCING_TIME_SOURCE_H_
+#define _COALESCING_TIME_SOURCE_H_
+
+/* local includes */
+#include <session_component.h>
+
+namespace Timer { class Coalescing_time_source; }
+
+
+class Timer::Coalescing_time_source : public  Genode::Time_source,
+                                      private Genode::Time_source::Timeout_handler
+{
+	private:
+
+		typedef Genode::Time_source::Timeout_handler Timeout_handler;
+
+		Genode::Time_source              &_time_source;
+		Genode::List<Session_component>  &_sessions;
+		Statistics                       &_statistics;
+		Timeout_handler                  *_handler { nullptr };
+
+		/*
+		 * Noncopyable
+		 */
+		Coalescing_time_source(Coalescing_time_source const &);
+		Coalescing_time_source &operator = (Coalescing_time_source const &);
+
+
+		/**********************************
+		 ** Time_source::Timeout_handler **
+		 **********************************/
+
+		void handle_timeout(Duration curr_time) override
+		{
+			_statistics.wakeups++;
+
+			uint64_t const curr_time_us = curr_time.trunc_to_plain_us().value;
+			for (Session_component *s = _sessions.first(); s; s = s->next())
+				s->expire(curr_time_us);
+
+			if (_handler)
+				_handler->handle_timeout(curr_time);
+		}
+
+	public:
+
+		Coalescing_time_source(Genode::Time_source             &time_source,
+		                       Genode::List<Session_component> &sessions,
+		                       Statistics                      &statistics)
+		:
+			_time_source(time_source), _sessions(sessions),
+			_statistics(statistics)
+		{ }
+
+
+		/*************************
+		 ** Genode::Time_source **
+		 *************************/
+
+		Duration curr_time() override { return _time_source.curr_time(); }
+
+		Microseconds max_timeout() const override {
+			return _time_source.max_timeout(); }
+
+		void schedule_timeout(Microseconds duration, Timeout_handler &handler) override
+		{
+			_handler = &handler;
+			_time_source.schedule_timeout(duration, *this);
+		}
+
+		void scheduler(Genode::Timeout_scheduler &scheduler) override {
+			_time_source.scheduler(scheduler); }
+};
+
+#endif /* _COALESCING_TIME_SOURCE_H_ */
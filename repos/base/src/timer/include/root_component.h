@@ -17,22 +17,115 @@
 
 /* Genode includes */
 #include <root/component.h>
+#include <base/attached_rom_dataspace.h>
+#include <base/session_label.h>
 
 /* local includes */
 #include <time_source.h>
-#include <session_component.h>
+#include <coalescing_time_source.h>
 
 namespace Timer { class Root_component; }
 
 
-class Timer::Root_component : public Genode::Root_component<Session_component>
+/*
+ * The optional configuration of the timer looks as follows:
+ *
+ * <config statistics_period_ms="10000">
+ *   <default-policy slack_us="0"/>
+ *   <policy label_prefix="noux" slack_us="5000"/>
+ * </config>
+ *
+ * The 'slack_us' attribute of the first policy that matches the session
+ * label defines the timer slack of the session, i.e., the time by which its
+ * one-shot timeouts may be delayed in order to trigger together with other
+ * timeouts. Periodic timeouts are not affected. If 'statistics_period_ms'
+ * is set, the timer periodically logs the number of wakeups and signals
+ * per second.
+ */
+class Timer::Root_component : public  Genode::Root_component<Session_component>,
+                              private Genode::Timeout::Handler
 {
 	private:
 
 		enum { MIN_TIMEOUT_US = 1000 };
 
-		Time_source                     _time_source;
-		Genode::Alarm_timeout_scheduler _timeout_scheduler;
+		Genode::Constructible<Genode::Attached_rom_dataspace> _config { };
+
+		Statistics                       _statistics             { };
+		Statistics                       _last_statistics        { };
+		Genode::List<Session_component>  _sessions               { };
+		Time_source                      _time_source;
+		Coalescing_time_source           _coalescing_time_source { _time_source,
+		                                                           _sessions,
+		                                                           _statistics };
+		Genode::Alarm_timeout_scheduler  _timeout_scheduler;
+		Genode::Timeout                  _statistics_timeout     { _timeout_scheduler };
+		uint64_t                         _statistics_period_us   { 0 };
+
+		static bool _policy_matches(Genode::Xml_node             policy,
+		                            Genode::Session_label const &label)
+		{
+			typedef Genode::String<160> Label;
+
+			if (policy.has_attribute("label"))
+				return policy.attribute_value("label", Label()) == label;
+
+			if (policy.has_attribute("label_prefix")) {
+				Label const prefix = policy.attribute_value("label_prefix", Label());
+				return !Genode::strcmp(label.string(), prefix.string(),
+				                       prefix.length() - 1);
+			}
+
+			if (policy.has_attribute("label_suffix")) {
+				Label const suffix = policy.attribute_value("label_suffix", Label());
+				Genode::size_t const suffix_len = suffix.length() - 1;
+				Genode::size_t const label_len  = label.length() - 1;
+				return label_len >= suffix_len &&
+				       !Genode::strcmp(label.string() + label_len - suffix_len,
+				                       suffix.string());
+			}
+			return false;
+		}
+
+		uint64_t _slack_us(Genode::Session_label const &label) const
+		{
+			if (!_config.constructed())
+				return 0;
+
+			uint64_t slack_us = 0;
+			bool     matched  = false;
+
+			Genode::Xml_node const config = _config->xml();
+			config.for_each_sub_node("policy", [&] (Genode::Xml_node policy) {
+				if (matched || !_policy_matches(policy, label))
+					return;
+
+				slack_us = policy.attribute_value("slack_us", (uint64_t)0);
+				matched  = true;
+			});
+			if (!matched)
+				config.for_each_sub_node("default-policy", [&] (Genode::Xml_node policy) {
+					slack_us = policy.attribute_value("slack_us", (uint64_t)0); });
+
+			return slack_us;
+		}
+
+
+		/*********************
+		 ** Timeout::Handler **
+		 *********************/
+
+		void handle_timeout(Duration) override
+		{
+			auto per_second = [&] (uint64_t curr, uint64_t last) {
+				return (curr - last) * 1000000 / _statistics_period_us; };
+
+			Genode::log("wakeups/s: ",   per_second(_statistics.wakeups,   _last_statistics.wakeups),
+			            " signals/s: ",   per_second(_statistics.signals,   _last_statistics.signals),
+			            " coalesced/s: ", per_second(_statistics.coalesced, _last_statistics.coalesced));
+
+			_last_statistics = _statistics;
+		}
 
 
 		/********************
@@ -48,8 +141,18 @@ class Timer::Root_component : public Genode::Root_component<Session_component>
 			if (ram_quota < sizeof(Session_component)) {
 				throw Insufficient_ram_quota(); }
 
-			return new (md_alloc())
-				Session_component(_timeout_scheduler);
+			Session_component &session = *new (md_alloc())
+				Session_component(_timeout_scheduler, _statistics,
+				                  _slack_us(label_from_args(args)));
+
+			_sessions.insert(&session);
+			return &session;
+		}
+
+		void _destroy_session(Session_component *session) override
+		{
+			_sessions.remove(session);
+			Genode::Root_component<Session_component>::_destroy_session(session);
 		}
 
 	public:
@@ -58,9 +161,23 @@ class Timer::Root_component : public Genode::Root_component<Session_component>
 		:
 			Genode::Root_component<Session_component>(&env.ep().rpc_ep(), &md_alloc),
 			_time_source(env),
-			_timeout_scheduler(_time_source, Microseconds(MIN_TIMEOUT_US))
+			_timeout_scheduler(_coalescing_time_source, Microseconds(MIN_TIMEOUT_US))
 		{
+			try { _config.construct(env, "config"); }
+			catch (...) { }
+
 			_timeout_scheduler._enable();
+
+			if (!_config.constructed())
+				return;
+
+			uint64_t const period_ms =
+				_config->xml().attribute_value("statistics_period_ms", (uint64_t)0);
+
+			if (period_ms) {
+				_statistics_period_us = period_ms * 1000;
+				_statistics_timeout.schedule_periodic(Microseconds(_statistics_period_us), *this);
+			}
 		}
 };
 
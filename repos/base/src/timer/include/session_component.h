@@ -19,6 +19,7 @@
 
 /* Genode includes */
 #include <util/list.h>
+#include <util/misc_math.h>
 #include <timer_session/timer_session.h>
 #include <base/rpc_server.h>
 #include <timer/timeout.h>
@@ -28,10 +29,22 @@ namespace Timer {
 	using Genode::uint64_t;
 	using Microseconds = Genode::Microseconds;
 	using Duration     = Genode::Duration;
+	struct Statistics;
 	class Session_component;
+	class Coalescing_time_source;
 }
 
 
+struct Timer::Statistics
+{
+	uint64_t wakeups   { 0 };
+	uint64_t signals   { 0 };
+
+	/* signals delivered before the end of the slack of the session */
+	uint64_t coalesced { 0 };
+};
+
+
 class Timer::Session_component : public  Genode::Rpc_object<Session>,
                                  private Genode::List<Session_component>::Element,
                                  private Genode::Timeout::Handler
@@ -39,21 +52,86 @@ class Timer::Session_component : public  Genode::Rpc_object<Session>,
 	private:
 
 		friend class Genode::List<Session_component>;
+		friend class Coalescing_time_source;
 
 		Genode::Timeout                    _timeout;
 		Genode::Timeout_scheduler         &_timeout_scheduler;
+		Statistics                        &_statistics;
+		uint64_t                    const  _slack_us;
 		Genode::Signal_context_capability  _sigh { };
 
-		uint64_t const _init_time_us =
-			_timeout_scheduler.curr_time().trunc_to_plain_us().value;
+		/* power of two not greater than the slack */
+		uint64_t const _slack_align =
+			_slack_us ? (uint64_t)1 << Genode::log2(_slack_us) : 1;
+
+		/* deadlines of the pending one-shot timeout */
+		bool     _one_shot         { false };
+		uint64_t _deadline_us      { 0 };
+		uint64_t _slack_end_us     { 0 };
+
+		uint64_t const _init_time_us = _curr_time_us();
 
-		void handle_timeout(Duration) override {
-			Genode::Signal_transmitter(_sigh).submit(); }
+		uint64_t _curr_time_us() const {
+			return _timeout_scheduler.curr_time().trunc_to_plain_us().value; }
+
+		/**
+		 * Return delay of the timeout within the slack of the session
+		 *
+		 * The end of the slack window is aligned to '_slack_align'. This
+		 * way, sessions with similar slack let their timeouts end up at the
+		 * same points in time.
+		 */
+		uint64_t _slack_delay_us(uint64_t deadline_us) const
+		{
+			if (!_slack_us)
+				return 0;
+
+			return ((deadline_us + _slack_us) & ~(_slack_align - 1)) - deadline_us;
+		}
+
+		void _submit()
+		{
+			_statistics.signals++;
+			Genode::Signal_transmitter(_sigh).submit();
+		}
+
+		/**
+		 * Signal pending one-shot timeout if its deadline passed already
+		 */
+		void expire(uint64_t curr_time_us)
+		{
+			if (!_one_shot || curr_time_us < _deadline_us)
+				return;
+
+			if (curr_time_us < _slack_end_us)
+				_statistics.coalesced++;
+
+			_one_shot = false;
+			_timeout.discard();
+			_submit();
+		}
+
+		void handle_timeout(Duration) override
+		{
+			_one_shot = false;
+			_submit();
+		}
 
 	public:
 
-		Session_component(Genode::Timeout_scheduler &timeout_scheduler)
-		: _timeout(timeout_scheduler), _timeout_scheduler(timeout_scheduler) { }
+		/**
+		 * Constructor
+		 *
+		 * \param slack_us  time by which one-shot timeouts may be delayed
+		 *                  in favor of triggering together with others
+		 */
+		Session_component(Genode::Timeout_scheduler &timeout_scheduler,
+		                  Statistics                &statistics,
+		                  uint64_t                   slack_us)
+		:
+			_timeout(timeout_scheduler), _timeout_scheduler(timeout_scheduler),
+			_statistics(statistics), _slack_us(slack_us)
+		{ }
 
 
 		/********************
@@ -72,17 +150,29 @@ class Timer::Session_component : public  Genode::Rpc_object<Session>,
 			 *       remove this.
 			 */
 			Microseconds typed_us((us > ~(uint64_t)0 >> 1) ? ~(uint64_t)0 >> 1 : us);
-			_timeout.schedule_one_shot(typed_us, *this);
+
+			_one_shot     = true;
+			_deadline_us  = _curr_time_us() + typed_us.value;
+
+			uint64_t const slack_delay_us = _slack_delay_us(_deadline_us);
+			_slack_end_us = _deadline_us + slack_delay_us;
+
+			_timeout.schedule_one_shot(Microseconds(typed_us.value + slack_delay_us), *this);
 		}
 
-		void trigger_periodic(uint64_t us) override {
-			_timeout.schedule_periodic(Microseconds(us), *this); }
+		void trigger_periodic(uint64_t us) override
+		{
+			_one_shot = false;
+			_timeout.schedule_periodic(Microseconds(us), *this);
+		}
 
 		void sigh(Signal_context_capability sigh) override
 		{
 			_sigh = sigh;
-			if (!sigh.valid())
+			if (!sigh.valid()) {
+				_one_shot = false;
 				_timeout.discard();
+			}
 		}
 
 		uint64_t elapsed_ms() const override {
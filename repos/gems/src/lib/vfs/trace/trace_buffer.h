@@ -26,8 +26,7 @@ class Trace_buffer
 	private:
 
 		Genode::Trace::Buffer        &_buffer;
-		Genode::Trace::Buffer::Entry  _curr          { _buffer.first() };
-		unsigned                      _wrapped_count { 0 };
+		Genode::Trace::Buffer::Reader _reader { _buffer };
 
 	public:
 
@@ -35,41 +34,19 @@ class Trace_buffer
 
 		/**
 		 * Call functor for each entry that wasn't yet processed
+		 *
+		 * \param update  if false, the entries are not marked as processed
 		 */
 		template <typename FUNC>
 		void for_each_new_entry(FUNC && functor, bool update = true)
 		{
-			using namespace Genode;
-
-			bool wrapped = _buffer.wrapped() != _wrapped_count;
-			if (wrapped)
-				_wrapped_count = _buffer.wrapped();
-
-			/* initialize _curr if _buffer was empty until now */
-			Trace::Buffer::Entry curr { _curr };
-			if (_curr.last())
-				curr = _buffer.first();
-
-			/* iterate over all entries that were not processed yet */
-			Trace::Buffer::Entry e1 = curr;
-			for (Trace::Buffer::Entry e2 = curr; wrapped || !e2.last();
-			                          e2 = _buffer.next(e2)) {
-				/* if buffer wrapped, we pass the last entry once and continue at first entry */
-				if (wrapped && e2.last()) {
-					wrapped = false;
-					e2 = _buffer.first();
-					if (e2.last())
-						break;
-				}
-
-				e1 = e2;
-				if (!functor(e1))
-					break;
+			if (update) {
+				_reader.for_each_new_entry(functor);
+				return;
 			}
 
-			/* remember the last processed entry in _curr */
-			curr = e1;
-			if (update) _curr = curr;
+			Genode::Trace::Buffer::Reader reader { _reader };
+			reader.for_each_new_entry(functor);
 		}
 
 		void * address()        const { return &_buffer; }
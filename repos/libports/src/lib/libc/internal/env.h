@@ -23,6 +23,9 @@
 /* libc includes */
 #include <libc/component.h>  /* 'Libc::Env' */
 
+/* libc-internal includes */
+#include <internal/malloc_stats_file_system.h>
+
 namespace Libc { class Env_implementation; }
 
 
@@ -57,6 +60,8 @@ class Libc::Env_implementation : public Libc::Env, public Config_accessor
 			return Xml_node("<libc/>");
 		}
 
+		Malloc_stats_file_system::Factory _malloc_stats_fs_factory { };
+
 		Vfs::Simple_env _vfs_env;
 
 		Xml_node _config_xml() const override {
@@ -65,7 +70,13 @@ class Libc::Env_implementation : public Libc::Env, public Config_accessor
 	public:
 
 		Env_implementation(Genode::Env &env, Genode::Allocator &alloc)
-		: _env(env), _vfs_env(_env, alloc, _vfs_config()) { }
+		:
+			_env(env),
+			_vfs_env(_env, alloc, _vfs_config(),
+			         [&] (Vfs::Global_file_system_factory &fs_factory) {
+			             fs_factory.extend(Malloc_stats_file_system::name(),
+			                               _malloc_stats_fs_factory); })
+		{ }
 
 
 		Vfs::Env &vfs_env() { return _vfs_env; }
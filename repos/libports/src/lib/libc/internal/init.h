@@ -92,6 +92,13 @@ namespace Libc {
 	void init_malloc_cloned(Clone_connection &);
 	void reinit_malloc(Genode::Allocator &);
 
+	/**
+	 * Return the malloc blocks cached by the calling thread
+	 *
+	 * Called by a thread that is about to exit.
+	 */
+	void drain_malloc_thread_cache();
+
 	typedef String<Vfs::MAX_PATH_LEN> Rtc_path;
 
 	/**
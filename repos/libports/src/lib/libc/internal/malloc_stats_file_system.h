@@ -0,0 +1,136 @@
+/*
+ * \brief  VFS file that exposes the statistics of the libc malloc
+ * \author Norman Feske
+ * \date   2026-10-17
+ *
+ * The file system is built into the libc and can be mounted anywhere in the
+ * VFS of a libc component, e.g., '<dir name="dev"> <malloc_stats/> </dir>'.
+ * Each read from the start of the file yields a fresh snapshot of the
+ * statistics in XML format.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _LIBC__INTERNAL__MALLOC_STATS_FILE_SYSTEM_H_
+#define _LIBC__INTERNAL__MALLOC_STATS_FILE_SYSTEM_H_
+
+/* Genode includes */
+#include <util/xml_generator.h>
+#include <vfs/file_system_factory.h>
+#include <vfs/single_file_system.h>
+
+namespace Libc {
+
+	class Malloc_stats_file_system;
+
+	/**
+	 * Generate content of the malloc-statistics file
+	 *
+	 * Implemented in 'malloc.cc'.
+	 */
+	void generate_malloc_stats(Genode::Xml_generator &);
+}
+
+
+class Libc::Malloc_stats_file_system : public Vfs::Single_file_system
+{
+	private:
+
+		typedef Vfs::file_size file_size;
+
+		class Stats_vfs_handle : public Single_vfs_handle
+		{
+			private:
+
+				enum { MAX_LEN = 4096 };
+
+				char   _buf[MAX_LEN];
+				file_size _len = 0;
+
+			public:
+
+				Stats_vfs_handle(Directory_service &ds,
+				                 File_io_service   &fs,
+				                 Genode::Allocator &alloc)
+				: Single_vfs_handle(ds, fs, alloc, 0) { }
+
+				Read_result read(char *dst, file_size count,
+				                 file_size &out_count) override
+				{
+					/* take a new snapshot whenever the file is read from the start */
+					if (seek() == 0) {
+						try {
+							Genode::Xml_generator xml(_buf, sizeof(_buf), "malloc",
+								[&] () { generate_malloc_stats(xml); });
+							_len = xml.used();
+						}
+						catch (Genode::Xml_generator::Buffer_exceeded) {
+							return READ_ERR_IO; }
+					}
+
+					if (seek() >= _len) {
+						out_count = 0;
+						return READ_OK;
+					}
+
+					file_size const len = Genode::min(count, _len - seek());
+					Genode::memcpy(dst, _buf + seek(), len);
+					out_count = len;
+
+					return READ_OK;
+				}
+
+				Write_result write(char const *, file_size, file_size &) override
+				{
+					return WRITE_ERR_IO;
+				}
+
+				bool read_ready() override { return true; }
+		};
+
+	public:
+
+		struct Factory : Vfs::File_system_factory
+		{
+			Vfs::File_system *create(Vfs::Env &env, Genode::Xml_node config) override
+			{
+				return new (env.alloc()) Malloc_stats_file_system(config);
+			}
+		};
+
+		Malloc_stats_file_system(Genode::Xml_node config)
+		:
+			Single_file_system(Vfs::Node_type::TRANSACTIONAL_FILE, name(),
+			                   Vfs::Node_rwx::ro(), config)
+		{ }
+
+		static char const *name()   { return "malloc_stats"; }
+		char const *type() override { return "malloc_stats"; }
+
+
+		/*********************************
+		 ** Directory-service interface **
+		 *********************************/
+
+		Open_result open(char const  *path, unsigned,
+		                 Vfs::Vfs_handle **out_handle,
+		                 Genode::Allocator &alloc) override
+		{
+			if (!_single_file(path))
+				return OPEN_ERR_UNACCESSIBLE;
+
+			try {
+				*out_handle = new (alloc) Stats_vfs_handle(*this, *this, alloc);
+				return OPEN_OK;
+			}
+			catch (Genode::Out_of_ram)  { return OPEN_ERR_OUT_OF_RAM; }
+			catch (Genode::Out_of_caps) { return OPEN_ERR_OUT_OF_CAPS; }
+		}
+};
+
+#endif /* _LIBC__INTERNAL__MALLOC_STATS_FILE_SYSTEM_H_ */
@@ -249,12 +249,7 @@ struct Libc::Pthread : Noncopyable, Thread::Tls::Base
 		 */
 		void cancel();
 
-		void exit(void *retval)
-		{
-			while (cleanup_pop(1)) { }
-			_retval = retval;
-			cancel();
-		}
+		void exit(void *retval);
 
 		void   *stack_addr() const { return _stack_addr; }
 		size_t  stack_size() const { return _stack_size; }
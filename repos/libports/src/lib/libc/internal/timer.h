@@ -32,7 +32,13 @@ struct Libc::Timer
 {
 	::Timer::Connection _timer;
 
-	Timer(Genode::Env &env) : _timer(env) { }
+	/*
+	 * Each blocking libc call with a timeout, e.g., 'select' or 'nanosleep'
+	 * of any thread, holds a timeout of this connection. Schedule them
+	 * by the timing wheel to keep the costs independent of their number.
+	 */
+	Timer(Genode::Env &env)
+	: _timer(env, env.ep(), "", ::Timer::Connection::Queue::TIMING_WHEEL) { }
 
 	Duration curr_time()
 	{
@@ -16,9 +16,11 @@
 #include <base/env.h>
 #include <base/log.h>
 #include <base/slab.h>
+#include <base/thread.h>
 #include <util/reconstructible.h>
 #include <util/string.h>
 #include <util/misc_math.h>
+#include <util/xml_generator.h>
 
 /* libc includes */
 extern "C" {
@@ -32,6 +34,7 @@ extern "C" {
 /* libc-internal includes */
 #include <internal/init.h>
 #include <internal/clone_session.h>
+#include <internal/malloc_stats_file_system.h>
 
 
 namespace Libc {
@@ -72,6 +75,21 @@ class Libc::Slab_alloc : public Slab
 
 /**
  * Allocator that uses slabs for small objects sizes
+ *
+ * Small blocks are allocated from per-arena slabs. Each thread is assigned
+ * to one of the arenas by the slot of its stack within the stack area, so
+ * threads of different arenas never contend for the same lock. Blocks are
+ * always freed to the arena they were allocated from, which is recorded in
+ * the metadata of the block.
+ *
+ * In front of the arenas, each thread has a cache of free slab blocks. As a
+ * slot of the stack area is used by only one thread at a time, the cache of
+ * a slot is accessed without lock. A freed block is put into the cache of
+ * the freeing thread and handed out by the next allocation of the same size
+ * class. The arena is locked only if the cache is empty on allocation or
+ * full on free. A pthread returns its cached blocks to the arenas when it
+ * exits. Only the blocks cached by other threads that vanish stay in the
+ * cache of their slot until the slot is used by another thread.
  */
 class Libc::Malloc
 {
@@ -83,26 +101,43 @@ class Libc::Malloc
 		enum {
 			SLAB_START = 5,  /* 32 bytes (log2) */
 			SLAB_STOP  = 11, /* 2048 bytes (log2) */
-			NUM_SLABS  = (SLAB_STOP - SLAB_START) + 1
+			NUM_SLABS  = (SLAB_STOP - SLAB_START) + 1,
+			NUM_ARENAS = 8,
+
+			MAX_THREAD_CACHES = 256, /* stack-area slots with a block cache */
+			CACHED_BLOCKS     = 8,   /* blocks per size class and thread */
 		};
 
+		/*
+		 * Blocks of at least this size obtain a dataspace of their own from
+		 * the backing store, which is page-granular anyway.
+		 */
+		enum { BIG_BLOCK_SIZE = 64*1024 };
+
 		struct Metadata
 		{
-			unsigned long long value; /* bits 63..5 size and 4..0 offset */
+			unsigned long long value; /* bits 63..8 size, 7..5 arena, 4..0 offset */
 
 			/**
 			 * Allocation metadata
 			 *
 			 * \param size    allocation size
+			 * \param arena   index of arena that accounts for the block
 			 * \param offset  offset of pointer from allocation
 			 */
-			Metadata(size_t size, unsigned offset)
-			: value(((unsigned long long)size << 5) | (offset & 0x1f)) { }
-
-			size_t   size()   const { return value >> 5; }
+			Metadata(size_t size, unsigned arena, unsigned offset)
+			:
+				value(((unsigned long long)size << 8) | ((arena & 0x7) << 5)
+				      | (offset & 0x1f))
+			{ }
+
+			size_t   size()   const { return value >> 8; }
+			unsigned arena()  const { return (value >> 5) & 0x7; }
 			unsigned offset() const { return value & 0x1f; }
 		};
 
+		static_assert(NUM_ARENAS <= 8, "arena index exceeds metadata bits");
+
 		/**
 		 * Allocation overhead due to alignment and metadata storage
 		 *
@@ -118,11 +153,44 @@ class Libc::Malloc
 		 */
 		static constexpr size_t _room() { return sizeof(Metadata) + 15; }
 
+		struct Stats
+		{
+			unsigned long blocks[NUM_SLABS];  /* slab blocks in use or cached */
+			unsigned long large_blocks;
+			size_t        large_bytes;
+			unsigned long realloc_in_place;
+			unsigned long realloc_moved;
+		};
+
+		struct Arena
+		{
+			Lock                      lock      { };
+			Constructible<Slab_alloc> slabs[NUM_SLABS] { };
+			Stats                     stats     { };
+		};
+
+		/**
+		 * Free slab block kept in a thread cache
+		 */
+		struct Cached_block
+		{
+			Cached_block *next;
+			unsigned      arena;
+		};
+
+		struct Thread_cache
+		{
+			Cached_block  *blocks[NUM_SLABS];
+			unsigned       count[NUM_SLABS];
+			unsigned long  realloc_in_place;
+			unsigned long  realloc_moved;
+		};
+
 		Allocator &_backing_store; /* back-end allocator */
 
-		Constructible<Slab_alloc> _slabs[NUM_SLABS]; /* slab allocators */
+		Arena _arenas[NUM_ARENAS];
 
-		Lock _lock;
+		Thread_cache _thread_caches[MAX_THREAD_CACHES] { };
 
 		unsigned _slab_log2(size_t size) const
 		{
@@ -139,59 +207,173 @@ class Libc::Malloc
 			return msb;
 		}
 
-	public:
+		/**
+		 * Determine slot of the calling thread's stack within the stack area
+		 *
+		 * \return  false if the stack is outside the stack area
+		 */
+		static bool _stack_slot(size_t &slot)
+		{
+			int dummy = 0;
+			addr_t const sp   = (addr_t)&dummy;
+			addr_t const base = Thread::stack_area_virtual_base();
 
-		Malloc(Allocator &backing_store) : _backing_store(backing_store)
+			if (sp < base || sp >= base + Thread::stack_area_virtual_size())
+				return false;
+
+			slot = (sp - base) / Thread::stack_virtual_size();
+			return true;
+		}
+
+		static unsigned _arena_index()
 		{
-			for (unsigned i = SLAB_START; i <= SLAB_STOP; i++)
-				_slabs[i - SLAB_START].construct(1U << i, backing_store);
+			/* stacks outside the stack area share the first arena */
+			size_t slot = 0;
+			return _stack_slot(slot) ? slot % NUM_ARENAS : 0;
 		}
 
-		~Malloc() { warning(__func__, " unexpectedly called"); }
+		/**
+		 * Return block cache of the calling thread
+		 *
+		 * \return  nullptr if the thread has no cache of its own
+		 */
+		Thread_cache *_thread_cache()
+		{
+			size_t slot = 0;
+			if (!_stack_slot(slot) || slot >= MAX_THREAD_CACHES)
+				return nullptr;
+
+			return &_thread_caches[slot];
+		}
 
 		/**
-		 * Allocator interface
+		 * Account realloc, without locking if the thread has a cache
 		 */
+		void _count_realloc(Arena &arena, bool in_place)
+		{
+			Thread_cache * const cache = _thread_cache();
+			if (cache) {
+				(in_place ? cache->realloc_in_place : cache->realloc_moved)++;
+				return;
+			}
+
+			Lock::Guard lock_guard(arena.lock);
+			(in_place ? arena.stats.realloc_in_place : arena.stats.realloc_moved)++;
+		}
 
-		void * alloc(size_t size)
+		/**
+		 * Write metadata into block and return aligned pointer for the caller
+		 */
+		static void *_init_block(void *alloc_addr, size_t real_size, unsigned arena)
 		{
-			Lock::Guard lock_guard(_lock);
+			/* correctly align the allocation address */
+			Metadata * const aligned_addr =
+				(Metadata *)(((addr_t)alloc_addr + _room()) & ~15UL);
 
-			size_t   const real_size = size + _room();
-			unsigned const msb       = _slab_log2(real_size);
+			unsigned const offset = (addr_t)aligned_addr - (addr_t)alloc_addr;
+
+			*(aligned_addr - 1) = Metadata(real_size, arena, offset);
+
+			return aligned_addr;
+		}
+
+		void *_alloc(size_t real_size)
+		{
+			unsigned const msb   = _slab_log2(real_size);
+			unsigned const index = _arena_index();
+			Arena         &arena = _arenas[index];
 
 			void *alloc_addr = nullptr;
 
 			/* use backing store if requested memory is larger than largest slab */
-			if (msb > SLAB_STOP)
+			if (msb > SLAB_STOP) {
+
+				if (real_size >= BIG_BLOCK_SIZE)
+					real_size = align_addr(real_size, 12);
+
 				_backing_store.alloc(real_size, &alloc_addr);
-			else
-				alloc_addr = _slabs[msb - SLAB_START]->alloc();
+				if (!alloc_addr) return nullptr;
 
-			if (!alloc_addr) return nullptr;
+				Lock::Guard lock_guard(arena.lock);
+				arena.stats.large_blocks++;
+				arena.stats.large_bytes += real_size;
 
-			/* correctly align the allocation address */
-			Metadata * const aligned_addr =
-				(Metadata *)(((addr_t)alloc_addr + _room()) & ~15UL);
+			} else {
 
-			unsigned const offset = (addr_t)aligned_addr - (addr_t)alloc_addr;
+				unsigned const slab = msb - SLAB_START;
 
-			*(aligned_addr - 1) = Metadata(real_size, offset);
+				/* take block from the thread cache without locking */
+				Thread_cache * const cache = _thread_cache();
+				if (cache && cache->blocks[slab]) {
+					Cached_block &block = *cache->blocks[slab];
+					cache->blocks[slab] = block.next;
+					cache->count[slab]--;
 
-			return aligned_addr;
+					/* the metadata may overlap with the cached block */
+					unsigned const block_arena = block.arena;
+					return _init_block(&block, real_size, block_arena);
+				}
+
+				Lock::Guard lock_guard(arena.lock);
+
+				alloc_addr = arena.slabs[slab]->alloc();
+				if (!alloc_addr) return nullptr;
+
+				arena.stats.blocks[slab]++;
+			}
+
+			return _init_block(alloc_addr, real_size, index);
+		}
+
+	public:
+
+		Malloc(Allocator &backing_store) : _backing_store(backing_store)
+		{
+			for (Arena &arena : _arenas)
+				for (unsigned i = SLAB_START; i <= SLAB_STOP; i++)
+					arena.slabs[i - SLAB_START].construct(1U << i, backing_store);
 		}
 
+		~Malloc() { warning(__func__, " unexpectedly called"); }
+
+		/**
+		 * Allocator interface
+		 */
+
+		void * alloc(size_t size) { return _alloc(size + _room()); }
+
 		void *realloc(void *ptr, size_t size)
 		{
-			size_t const real_size     = size + _room();
-			size_t const old_real_size = ((Metadata *)ptr - 1)->size();
+			Metadata &md = *((Metadata *)ptr - 1);
+
+			size_t   const real_size     = size + _room();
+			size_t   const old_real_size = md.size();
+			unsigned const old_msb       = _slab_log2(old_real_size);
+
+			Arena &arena = _arenas[md.arena()];
 
 			/* do not reallocate if new size is less than the current size */
 			if (real_size <= old_real_size)
 				return ptr;
 
+			/* grow block in place if it still fits into its slab entry */
+			if (old_msb <= SLAB_STOP && real_size <= (1UL << old_msb)) {
+				md = Metadata(real_size, md.arena(), md.offset());
+
+				_count_realloc(arena, true);
+				return ptr;
+			}
+
+			/*
+			 * Leave headroom when moving a large block so that a block that
+			 * is grown repeatedly is moved only a logarithmic number of times.
+			 */
+			size_t new_real_size = real_size;
+			if (_slab_log2(real_size) > SLAB_STOP)
+				new_real_size = max(real_size, old_real_size + old_real_size/2);
+
 			/* allocate new block */
-			void *new_addr = alloc(size);
+			void *new_addr = _alloc(new_real_size);
 
 			if (new_addr) {
 				/* copy content from old block into new block */
@@ -199,6 +381,8 @@ class Libc::Malloc
 
 				/* free old block */
 				free(ptr);
+
+				_count_realloc(arena, false);
 			}
 
 			return new_addr;
@@ -206,20 +390,117 @@ class Libc::Malloc
 
 		void free(void *ptr)
 		{
-			Lock::Guard lock_guard(_lock);
-
 			Metadata *md = (Metadata *)ptr - 1;
 
-			size_t   const  real_size  = md->size();
-			unsigned const  msb        = _slab_log2(real_size);
+			size_t   const  real_size   = md->size();
+			unsigned const  msb         = _slab_log2(real_size);
+			unsigned const  arena_index = md->arena();
+
+			Arena &arena = _arenas[arena_index];
 
 			void *alloc_addr = (void *)((addr_t)ptr - md->offset());
 
 			if (msb > SLAB_STOP) {
+				{
+					Lock::Guard lock_guard(arena.lock);
+					arena.stats.large_blocks--;
+					arena.stats.large_bytes -= real_size;
+				}
 				_backing_store.free(alloc_addr, real_size);
+
 			} else {
-				_slabs[msb - SLAB_START]->free(alloc_addr);
+
+				unsigned const slab = msb - SLAB_START;
+
+				/* keep block in the thread cache without locking */
+				Thread_cache * const cache = _thread_cache();
+				if (cache && cache->count[slab] < CACHED_BLOCKS) {
+					Cached_block &block = *(Cached_block *)alloc_addr;
+					block = Cached_block { cache->blocks[slab], arena_index };
+					cache->blocks[slab] = &block;
+					cache->count[slab]++;
+					return;
+				}
+
+				Lock::Guard lock_guard(arena.lock);
+				arena.slabs[slab]->free(alloc_addr);
+				arena.stats.blocks[slab]--;
+			}
+		}
+
+		/**
+		 * Return the blocks cached by the calling thread to their arenas
+		 */
+		void drain_thread_cache()
+		{
+			Thread_cache * const cache = _thread_cache();
+			if (!cache)
+				return;
+
+			for (unsigned slab = 0; slab < NUM_SLABS; slab++) {
+				while (Cached_block * const block = cache->blocks[slab]) {
+					cache->blocks[slab] = block->next;
+					cache->count[slab]--;
+
+					Arena &arena = _arenas[block->arena];
+
+					Lock::Guard lock_guard(arena.lock);
+					arena.slabs[slab]->free(block);
+					arena.stats.blocks[slab]--;
+				}
+			}
+		}
+
+		void generate_stats(Xml_generator &xml)
+		{
+			Stats total { };
+
+			for (Arena &arena : _arenas) {
+				Lock::Guard lock_guard(arena.lock);
+
+				for (unsigned i = 0; i < NUM_SLABS; i++)
+					total.blocks[i] += arena.stats.blocks[i];
+
+				total.large_blocks     += arena.stats.large_blocks;
+				total.large_bytes      += arena.stats.large_bytes;
+				total.realloc_in_place += arena.stats.realloc_in_place;
+				total.realloc_moved    += arena.stats.realloc_moved;
+			}
+
+			/*
+			 * The thread caches are read without lock while their threads
+			 * keep modifying them. Hence, the 'cached' and 'realloc' counts
+			 * are approximate and may not add up with the per-arena counts
+			 * taken under the arena locks before.
+			 */
+			unsigned long cached[NUM_SLABS] { };
+			for (Thread_cache const &cache : _thread_caches) {
+				for (unsigned i = 0; i < NUM_SLABS; i++)
+					cached[i] += cache.count[i];
+
+				total.realloc_in_place += cache.realloc_in_place;
+				total.realloc_moved    += cache.realloc_moved;
 			}
+
+			xml.attribute("arenas",   (unsigned)NUM_ARENAS);
+			xml.attribute("consumed", _backing_store.consumed());
+
+			for (unsigned i = 0; i < NUM_SLABS; i++)
+				xml.node("size_class", [&] () {
+					xml.attribute("size",   1UL << (i + SLAB_START));
+					xml.attribute("blocks", total.blocks[i]);
+					xml.attribute("cached", cached[i]);
+				});
+
+			xml.node("large", [&] () {
+				xml.attribute("blocks", total.large_blocks);
+				xml.attribute("bytes",  total.large_bytes);
+			});
+
+			xml.node("realloc", [&] () {
+				xml.attribute("in_place", total.realloc_in_place);
+				xml.attribute("moved",    total.realloc_moved);
+			});
 		}
 };
 
@@ -264,12 +545,26 @@ extern "C" void *realloc(void *ptr, size_t size)
 }
 
 
+void Libc::generate_malloc_stats(Xml_generator &xml)
+{
+	if (mallocator)
+		mallocator->generate_stats(xml);
+}
+
+
 static Genode::Constructible<Malloc> &constructible_malloc()
 {
 	return *unmanaged_singleton<Genode::Constructible<Malloc> >();
 }
 
 
+void Libc::drain_malloc_thread_cache()
+{
+	if (mallocator)
+		mallocator->drain_thread_cache();
+}
+
+
 void Libc::init_malloc(Genode::Allocator &heap)
 {
 
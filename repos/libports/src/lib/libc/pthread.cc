@@ -101,6 +101,18 @@ void Libc::Pthread::join(void **retval)
 }
 
 
+void Libc::Pthread::exit(void *retval)
+{
+	while (cleanup_pop(1)) { }
+
+	/* the stack of the thread may be released as soon as it is joined */
+	drain_malloc_thread_cache();
+
+	_retval = retval;
+	cancel();
+}
+
+
 void Libc::Pthread::cancel()
 {
 	_exiting = true;
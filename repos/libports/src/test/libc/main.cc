@@ -123,6 +123,24 @@ int main(int argc, char **argv)
 		}
 	}
 
+	printf("Malloc: check statistics\n");
+	{
+		static char buf[4096];
+
+		FILE *file = fopen("/dev/malloc_stats", "r");
+		size_t const len = file ? fread(buf, 1, sizeof(buf) - 1, file) : 0;
+		if (file)
+			fclose(file);
+
+		buf[len] = 0;
+		if (strncmp(buf, "<malloc", 7) || !strstr(buf, "<realloc")) {
+			printf("reading /dev/malloc_stats returned '%s' - ERROR\n", buf);
+			++error_count;
+		} else {
+			printf("%s\n", buf);
+		}
+	}
+
 	printf("Malloc: check really large allocation\n");
 	for (unsigned i = 0; i < 4; ++i) {
 		size_t const size = 250*1024*1024;
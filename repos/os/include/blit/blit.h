@@ -14,6 +14,8 @@
 #ifndef _INCLUDE__BLIT__BLIT_H_
 #define _INCLUDE__BLIT__BLIT_H_
 
+#include <base/stdint.h>
+
 /**
  * Blit memory from source buffer to destination buffer
  *
@@ -31,4 +33,68 @@
 extern "C" void blit(void const *src, unsigned src_w,
                      void *dst, unsigned dst_w, int w, int h);
 
+
+/*
+ * The functions of the 'Blit' namespace operate on pixels in the RGB888
+ * format (32 bits per pixel) and the RGB565 format (16 bits per pixel) as
+ * defined by 'os/pixel_rgb888.h' and 'os/pixel_rgb565.h'. Line lengths are
+ * given in bytes and must be multiples of the pixel size. Like 'blit', the
+ * functions use the vector unit of the CPU if available. The source and
+ * destination must not overlap.
+ */
+namespace Blit {
+
+	using Genode::uint16_t;
+	using Genode::uint32_t;
+
+	/**
+	 * Clockwise rotation
+	 */
+	enum Rotation { ROTATE_0, ROTATE_90, ROTATE_180, ROTATE_270 };
+
+	/**
+	 * Copy block of RGB888 pixels while rotating it
+	 *
+	 * \param src    address of source buffer
+	 * \param src_w  line length of source buffer in bytes
+	 * \param dst    address of destination buffer
+	 * \param dst_w  line length of destination buffer in bytes
+	 * \param w      width of the source block in pixels
+	 * \param h      height of the source block in pixels
+	 *
+	 * For 'ROTATE_90' and 'ROTATE_270', the destination block is 'h' pixels
+	 * wide and 'w' pixels high.
+	 */
+	void rotate(uint32_t const *src, unsigned src_w,
+	            uint32_t *dst, unsigned dst_w, int w, int h, Rotation);
+
+	/**
+	 * Convert block of RGB888 pixels to RGB565
+	 *
+	 * The lower bits of each color channel are truncated.
+	 *
+	 * \param w  width of the block in pixels
+	 * \param h  height of the block in pixels
+	 */
+	void rgb888_to_rgb565(uint32_t const *src, unsigned src_w,
+	                      uint16_t *dst, unsigned dst_w, int w, int h);
+
+	/**
+	 * Convert block of RGB565 pixels to RGB888
+	 *
+	 * The lower bits of each color channel and the alpha channel of the
+	 * resulting pixels are zero.
+	 *
+	 * \param w  width of the block in pixels
+	 * \param h  height of the block in pixels
+	 */
+	void rgb565_to_rgb888(uint16_t const *src, unsigned src_w,
+	                      uint32_t *dst, unsigned dst_w, int w, int h);
+
+	/**
+	 * Return name of the implementation selected for the CPU
+	 */
+	char const *kernels();
+}
+
 #endif /* _INCLUDE__BLIT__BLIT_H_ */
@@ -1,5 +1,5 @@
 /*
- * \brief  Computing the Internet Checksum (conforms to RFC 1071)
+ * \brief  Computing the Internet Checksum (conforms to RFC 1071 and RFC 1624)
  * \author Martin Stein
  * \date   2018-03-23
  */
@@ -32,4 +32,51 @@ namespace Net {
 	                                             Ipv4_address           &ip_dst);
 }
 
+
+/**
+ * Difference of checksummed data for the incremental update of a checksum
+ *
+ * Instead of re-calculating the checksum over the whole data after
+ * modifying some fields, the old and new values of the modified fields are
+ * added up and the difference is applied to the old checksum (RFC 1624).
+ * A difference can be applied to any number of checksums, for instance, to
+ * the checksums of the IP header and the transport header after rewriting
+ * the IP addresses.
+ *
+ * The data is handled in the byte order of the packet, i.e., the checksum
+ * passed to 'apply_to' is the checksum as stored in the packet.
+ */
+class Net::Internet_checksum_diff
+{
+	private:
+
+		Genode::uint64_t _value { 0 };
+
+	public:
+
+		/**
+		 * Add up difference between the old and new value of a field
+		 *
+		 * \param new_data  new value of the field
+		 * \param old_data  old value of the field
+		 * \param size      size of the field in bytes, which must be even
+		 *                  unless the field is at the end of the data
+		 */
+		void add_up_diff(void const     *new_data,
+		                 void const     *old_data,
+		                 Genode::size_t  size);
+
+		/**
+		 * Add up another difference, e.g., that of the IP addresses to the
+		 * difference of a transport header with a pseudo-header checksum
+		 */
+		void add_up_diff(Internet_checksum_diff const &icd) {
+			_value += icd._value; }
+
+		/**
+		 * Return checksum adapted by the difference
+		 */
+		Genode::uint16_t apply_to(Genode::uint16_t checksum) const;
+};
+
 #endif /* _NET__INTERNET_CHECKSUM_H_ */
@@ -75,6 +75,14 @@ class Net::Udp_packet
 		void update_checksum(Ipv4_address ip_src,
 		                     Ipv4_address ip_dst);
 
+		/**
+		 * Adapt checksum to modified header fields
+		 *
+		 * A zero checksum, which indicates that the sender omitted the
+		 * checksum, is left untouched.
+		 */
+		void update_checksum(Internet_checksum_diff const &icd);
+
 		bool checksum_error(Ipv4_address ip_src,
 		                    Ipv4_address ip_dst) const;
 
@@ -92,6 +100,12 @@ class Net::Udp_packet
 		void src_port(Port p)           { _src_port = host_to_big_endian(p.value); }
 		void dst_port(Port p)           { _dst_port = host_to_big_endian(p.value); }
 
+		/*
+		 * Modify port and add up the difference to 'icd'
+		 */
+		void src_port(Port p, Internet_checksum_diff &icd);
+		void dst_port(Port p, Internet_checksum_diff &icd);
+
 
 		/*********
 		 ** log **
@@ -16,6 +16,7 @@
 
 #include <blit/blit.h>
 #include <os/texture.h>
+#include <os/pixel_row.h>
 
 
 struct Texture_painter
@@ -77,7 +78,6 @@ struct Texture_painter
 		int i, j;
 		PT            const *s;
 		PT                  *d;
-		unsigned char const *a;
 
 		switch (mode) {
 
@@ -98,18 +98,13 @@ struct Texture_painter
 			 * Copy texture with alpha blending
 			 */
 			for (j = clipped.h(); j--; src += src_w, alpha += src_w, dst += dst_w)
-				for (i = clipped.w(), s = src, a = alpha, d = dst; i--; s++, d++, a++) {
-					unsigned char const alpha_value = *a;
-					if (__builtin_expect(alpha_value != 0, true))
-						*d = PT::mix(*d, *s, alpha_value + 1);
-				}
+				Genode::Pixel_row<PT>::blend(dst, src, alpha, clipped.w());
 			break;
 
 		case MIXED:
 
 			for (j = clipped.h(); j--; src += src_w, dst += dst_w)
-				for (i = clipped.w(), s = src, d = dst; i--; s++, d++)
-					*d = PT::avr(mix_pixel, *s);
+				Genode::Pixel_row<PT>::avr(dst, src, mix_pixel, clipped.w());
 			break;
 
 		case MASKED:
@@ -61,6 +61,13 @@
  * acknowledge buffers using the methods 'packet_avail',
  * 'ready_to_submit', 'ready_to_ack', and 'ack_avail'.
  *
+ * Bursts of packets can be transferred via the batch operations
+ * 'submit_packets', 'get_packets', 'acknowledge_packets', and
+ * 'get_acked_packets'. They never block and deliver at most one signal per
+ * batch. The signal is omitted if the peer is still busy with packets queued
+ * before the batch, i.e., if the peer cannot have observed the queue
+ * condition it might be waiting for.
+ *
  * If bidirectional data exchange between two processes is desired, two pairs
  * of 'Packet_stream_source' and 'Packet_stream_sink' should be instantiated.
  */
@@ -247,6 +254,15 @@ class Genode::Packet_descriptor_queue
 		bool single_element() { return (_tail + 1)%QUEUE_SIZE == _head; }
 
 
+		/**
+		 * Return number of packet descriptors stored in the queue
+		 */
+		unsigned count()
+		{
+			unsigned const head = _head, tail = _tail;
+			return (head + QUEUE_SIZE - tail)%QUEUE_SIZE;
+		}
+
 		/**
 		 * Return true if a single slot is left to be put into the queue
 		 */
@@ -380,6 +396,30 @@ class Genode::Packet_descriptor_transmitter
 			return signal_submitted;
 		}
 
+		/**
+		 * Place up to 'count' packets into the tx queue without blocking
+		 *
+		 * \return number of transmitted packets
+		 *
+		 * The receiver is signalled at most once for the whole batch. The
+		 * signal is needed only if the receiver may have found the queue
+		 * empty while the batch was added, which is the case if no more
+		 * than the packets of the batch are left in the queue.
+		 */
+		unsigned tx_batch(typename TX_QUEUE::Packet_descriptor const *packets,
+		                  unsigned count)
+		{
+			Genode::Lock::Guard lock_guard(_tx_queue_lock);
+
+			unsigned n = 0;
+			for (; n < count && _tx_queue->add(packets[n]); n++);
+
+			if (n && _tx_queue->count() <= n)
+				_rx_ready.submit();
+
+			return n;
+		}
+
 		/**
 		 * Return number of slots left to be put into the tx queue
 		 */
@@ -499,6 +539,31 @@ class Genode::Packet_descriptor_receiver
 			return signal_submitted;
 		}
 
+		/**
+		 * Take up to 'max' packets from the rx queue without blocking
+		 *
+		 * \return number of received packets
+		 *
+		 * The transmitter is signalled at most once for the whole batch. The
+		 * signal is needed only if the transmitter may have found the queue
+		 * full, which is the case if no more than the slots freed by the
+		 * batch are left in the queue.
+		 */
+		unsigned rx_batch(typename RX_QUEUE::Packet_descriptor *packets,
+		                  unsigned max)
+		{
+			Genode::Lock::Guard lock_guard(_rx_queue_lock);
+
+			unsigned n = 0;
+			for (; n < max && !_rx_queue->empty(); n++)
+				packets[n] = _rx_queue->get();
+
+			if (n && _rx_queue->slots_free() <= n)
+				_tx_ready.submit();
+
+			return n;
+		}
+
 		typename RX_QUEUE::Packet_descriptor rx_peek() const
 		{
 			Genode::Lock::Guard lock_guard(_rx_queue_lock);
@@ -811,6 +876,19 @@ class Genode::Packet_stream_source : private Packet_stream_base
 			return _submit_transmitter.try_tx(packet);
 		}
 
+		/**
+		 * Submit a batch of packets
+		 *
+		 * \return number of submitted packets, which is smaller than 'count'
+		 *         if the submit queue is congested
+		 *
+		 * This method never blocks and wakes up the sink at most once.
+		 */
+		unsigned submit_packets(Packet_descriptor const *packets, unsigned count)
+		{
+			return _submit_transmitter.tx_batch(packets, count);
+		}
+
 		/**
 		 * Wake up the packet sink if needed
 		 *
@@ -848,6 +926,20 @@ class Genode::Packet_stream_source : private Packet_stream_base
 			return _ack_receiver.try_rx();
 		}
 
+		/**
+		 * Get a batch of acknowledged packets
+		 *
+		 * \param packets  destination array
+		 * \param max      capacity of 'packets'
+		 * \return         number of packets stored in 'packets'
+		 *
+		 * This method never blocks and wakes up the sink at most once.
+		 */
+		unsigned get_acked_packets(Packet_descriptor *packets, unsigned max)
+		{
+			return _ack_receiver.rx_batch(packets, max);
+		}
+
 		/**
 		 * Release bulk-buffer space consumed by the packet
 		 */
@@ -971,6 +1063,20 @@ class Genode::Packet_stream_sink : private Packet_stream_base
 			return _submit_receiver.try_rx();
 		}
 
+		/**
+		 * Get a batch of packets from source
+		 *
+		 * \param packets  destination array
+		 * \param max      capacity of 'packets'
+		 * \return         number of packets stored in 'packets'
+		 *
+		 * This method never blocks and wakes up the source at most once.
+		 */
+		unsigned get_packets(Packet_descriptor *packets, unsigned max)
+		{
+			return _submit_receiver.rx_batch(packets, max);
+		}
+
 		/**
 		 * Wake up the packet source if needed
 		 *
@@ -1035,6 +1141,20 @@ class Genode::Packet_stream_sink : private Packet_stream_base
 			return _ack_transmitter.try_tx(packet);
 		}
 
+		/**
+		 * Acknowledge a batch of packets
+		 *
+		 * \return number of acknowledged packets, which is smaller than
+		 *         'count' if the acknowledgement queue is congested
+		 *
+		 * This method never blocks and wakes up the source at most once.
+		 */
+		unsigned acknowledge_packets(Packet_descriptor const *packets,
+		                             unsigned count)
+		{
+			return _ack_transmitter.tx_batch(packets, count);
+		}
+
 		void debug_print_buffers() {
 			Packet_stream_base::_debug_print_buffers(); }
 
@@ -15,6 +15,7 @@
 #define _INCLUDE__OS__PIXEL_RGB565_H_
 
 #include <os/pixel_rgba.h>
+#include <os/pixel_row.h>
 
 namespace Genode {
 
@@ -56,6 +57,126 @@ namespace Genode {
 		res.pixel = blend(p1, 264 - alpha).pixel + blend(p2, alpha).pixel;
 		return res;
 	}
+
+
+#ifdef PIXEL_ROW_VECTORIZED
+
+	template <>
+	struct Pixel_row<Pixel_rgb565> : Pixel_row_scalar<Pixel_rgb565>
+	{
+		typedef Pixel_rgb565                 PT;
+		typedef Pixel_row_scalar<PT>         Scalar;
+		typedef Pixel_vector::u16            u16;
+
+		enum { LANES = 8 };
+
+		static u16 _load(PT const *p)     { return Pixel_vector::load<u16>(p); }
+		static void _store(PT *p, u16 v)  { Pixel_vector::store(p, v); }
+
+		static u16 _broadcast(uint16_t v) { return Pixel_vector::broadcast<u16>(v); }
+
+		static u16 _load(unsigned char const *v) { return Pixel_vector::widen_8(v); }
+
+		/**
+		 * 'Pixel_rgb565::blend' for alpha values 0...264
+		 *
+		 * Each color channel is weighted separately so that all products
+		 * fit into 16 bits.
+		 */
+		static u16 _blend(u16 p, u16 alpha)
+		{
+			u16 const a = alpha >> 3;
+			u16 const r = ((a * (p >> 11)) >> 5) & 0x1f;
+			u16 const b = ((a * (p & 0x1f)) >> 5) & 0x1f;
+			u16 const g = ((alpha * ((p >> 6) & 0x1f)) >> 2) & 0x07c0;
+
+			return (r << 11) | g | b;
+		}
+
+		/**
+		 * 'Pixel_rgb565::mix' for alpha values 0...264
+		 */
+		static u16 _mix(u16 p1, u16 p2, u16 alpha) {
+			return _blend(p1, 264 - alpha) + _blend(p2, alpha); }
+
+		static void fill(PT *dst, PT color, unsigned n)
+		{
+			u16 const c = _broadcast(color.pixel);
+
+			for (; n >= LANES; n -= LANES, dst += LANES)
+				_store(dst, c);
+
+			Scalar::fill(dst, color, n);
+		}
+
+		static void mix(PT *dst, PT color, int alpha, unsigned n)
+		{
+			if (alpha >= 0 && alpha <= 264) {
+
+				u16 const a = _broadcast(264 - alpha);
+				u16 const c = _broadcast(PT::blend(color, alpha).pixel);
+
+				for (; n >= LANES; n -= LANES, dst += LANES)
+					_store(dst, _blend(_load(dst), a) + c);
+			}
+			Scalar::mix(dst, color, alpha, n);
+		}
+
+		static void mix(PT *dst, PT color, int alpha,
+		                unsigned char const *opacity, unsigned n)
+		{
+			if (alpha >= 0 && alpha <= 255) {
+
+				u16 const c      = _broadcast(color.pixel);
+				u16 const a      = _broadcast(alpha);
+				u16 const opaque = _broadcast(alpha == 255 ? 255 : 256);
+
+				for (; n >= LANES; n -= LANES, dst += LANES, opacity += LANES) {
+
+					u16 const v = _load(opacity);
+					u16 const d = _load(dst);
+
+					u16 const mixed = _mix(d, c, (v * a) >> 8);
+
+					_store(dst, Pixel_vector::select((u16)(v == 0), d,
+					            Pixel_vector::select((u16)(v == opaque), c, mixed)));
+				}
+			}
+			Scalar::mix(dst, color, alpha, opacity, n);
+		}
+
+		static void blend(PT *dst, PT const *src, unsigned char const *alpha,
+		                  unsigned n)
+		{
+			for (; n >= LANES; n -= LANES, dst += LANES, src += LANES, alpha += LANES) {
+
+				uint64_t octet;
+				__builtin_memcpy(&octet, alpha, sizeof(octet));
+
+				/* skip transparent parts of the texture */
+				if (octet == 0)
+					continue;
+
+				u16 const a = _load(alpha);
+				u16 const d = _load(dst);
+
+				_store(dst, Pixel_vector::select((u16)(a != 0),
+				                                 _mix(d, _load(src), a + 1), d));
+			}
+			Scalar::blend(dst, src, alpha, n);
+		}
+
+		static void avr(PT *dst, PT const *src, PT color, unsigned n)
+		{
+			u16 const c = (_broadcast(color.pixel) & 0xf7df) >> 1;
+
+			for (; n >= LANES; n -= LANES, dst += LANES, src += LANES)
+				_store(dst, c + ((_load(src) & 0xf7df) >> 1));
+
+			Scalar::avr(dst, src, color, n);
+		}
+	};
+#endif /* PIXEL_ROW_VECTORIZED */
 }
 
 #endif /* _INCLUDE__OS__PIXEL_RGB565_H_ */
@@ -15,6 +15,7 @@
 #define _INCLUDE__OS__PIXEL_RGB888_H_
 
 #include <os/pixel_rgba.h>
+#include <os/pixel_row.h>
 
 namespace Genode {
 
@@ -40,6 +41,155 @@ namespace Genode {
 		res.pixel = blend(p1, 255 - alpha).pixel + blend(p2, alpha).pixel;
 		return res;
 	}
+
+
+	template <>
+	inline Pixel_rgb888 Pixel_rgb888::avr(Pixel_rgb888 p1, Pixel_rgb888 p2)
+	{
+		Pixel_rgb888 res;
+		res.pixel = ((p1.pixel & 0xfefefe) >> 1) + ((p2.pixel & 0xfefefe) >> 1);
+		return res;
+	}
+
+
+#ifdef PIXEL_ROW_VECTORIZED
+
+	template <>
+	struct Pixel_row<Pixel_rgb888> : Pixel_row_scalar<Pixel_rgb888>
+	{
+		typedef Pixel_rgb888                 PT;
+		typedef Pixel_row_scalar<PT>         Scalar;
+		typedef Pixel_vector::u32            u32;
+		typedef Pixel_vector::u16            u16;
+
+		enum { LANES = 4 };
+
+		static u32 _load(PT const *p)     { return Pixel_vector::load<u32>(p); }
+		static void _store(PT *p, u32 v)  { Pixel_vector::store(p, v); }
+
+		static u32 _broadcast(uint32_t v) { return Pixel_vector::broadcast<u32>(v); }
+
+		static u32 _load(unsigned char const *v) { return Pixel_vector::widen_4(v); }
+
+		/**
+		 * 'Pixel_rgb888::blend' for alpha values 0...256
+		 *
+		 * The products of the color channels and the alpha value fit into
+		 * the 16-bit lanes, which are multiplied at once.
+		 */
+		static u32 _blend(u32 p, u32 alpha)
+		{
+			u16 const a  = (u16)(alpha | (alpha << 16));
+			u32 const g  = (u32)((u16)((p >> 8) & 0xff) * a);
+			u32 const rb = (u32)((u16)(p & 0xff00ff) * a);
+
+			return (g & 0xff00) | ((rb >> 8) & 0xff00ff);
+		}
+
+		/**
+		 * 'Pixel_rgb888::blend' for an alpha value of -1
+		 *
+		 * 'Pixel_rgb888::mix' blends the first pixel with an alpha value of
+		 * -1 if called with an alpha value of 256.
+		 */
+		static u32 _blend_minus_one(u32 p)
+		{
+			return ((-((p >> 8) & 0xff)) & 0xff00)
+			     | (((-(p & 0xff00ff)) >> 8) & 0xff00ff);
+		}
+
+		/**
+		 * 'Pixel_rgb888::mix' for alpha values 0...256
+		 */
+		static u32 _mix(u32 p1, u32 p2, u32 alpha)
+		{
+			u32 const minus_one = (u32)(alpha == 256);
+
+			return Pixel_vector::select(minus_one, _blend_minus_one(p1),
+			                            _blend(p1, 255 - alpha))
+			     + _blend(p2, alpha);
+		}
+
+		static void fill(PT *dst, PT color, unsigned n)
+		{
+			u32 const c = _broadcast(color.pixel);
+
+			for (; n >= LANES; n -= LANES, dst += LANES)
+				_store(dst, c);
+
+			Scalar::fill(dst, color, n);
+		}
+
+		static void mix(PT *dst, PT color, int alpha, unsigned n)
+		{
+			if (alpha >= 0 && alpha <= 255) {
+
+				u32 const a = _broadcast(255 - alpha);
+				u32 const c = _broadcast(PT::blend(color, alpha).pixel);
+
+				for (; n >= LANES; n -= LANES, dst += LANES)
+					_store(dst, _blend(_load(dst), a) + c);
+			}
+			Scalar::mix(dst, color, alpha, n);
+		}
+
+		static void mix(PT *dst, PT color, int alpha,
+		                unsigned char const *opacity, unsigned n)
+		{
+			if (alpha >= 0 && alpha <= 255) {
+
+				u32 const c      = _broadcast(color.pixel);
+				u16 const a      = (u16)_broadcast(alpha);
+				u32 const opaque = _broadcast(alpha == 255 ? 255 : 256);
+
+				for (; n >= LANES; n -= LANES, dst += LANES, opacity += LANES) {
+
+					u32 const v = _load(opacity);
+					u32 const d = _load(dst);
+
+					/* the alpha values are below 256 */
+					u32 const w     = (u32)((u16)v * a) >> 8;
+					u32 const mixed = _blend(d, 255 - w) + _blend(c, w);
+
+					_store(dst, Pixel_vector::select((u32)(v == 0), d,
+					            Pixel_vector::select((u32)(v == opaque), c, mixed)));
+				}
+			}
+			Scalar::mix(dst, color, alpha, opacity, n);
+		}
+
+		static void blend(PT *dst, PT const *src, unsigned char const *alpha,
+		                  unsigned n)
+		{
+			for (; n >= LANES; n -= LANES, dst += LANES, src += LANES, alpha += LANES) {
+
+				uint32_t quad;
+				__builtin_memcpy(&quad, alpha, sizeof(quad));
+
+				/* skip transparent parts of the texture */
+				if (quad == 0)
+					continue;
+
+				u32 const a = _load(alpha);
+				u32 const d = _load(dst);
+
+				_store(dst, Pixel_vector::select((u32)(a != 0),
+				                                 _mix(d, _load(src), a + 1), d));
+			}
+			Scalar::blend(dst, src, alpha, n);
+		}
+
+		static void avr(PT *dst, PT const *src, PT color, unsigned n)
+		{
+			u32 const c = (_broadcast(color.pixel) & 0xfefefe) >> 1;
+
+			for (; n >= LANES; n -= LANES, dst += LANES, src += LANES)
+				_store(dst, c + ((_load(src) & 0xfefefe) >> 1));
+
+			Scalar::avr(dst, src, color, n);
+		}
+	};
+#endif /* PIXEL_ROW_VECTORIZED */
 }
 
 #endif /* _INCLUDE__OS__PIXEL_RGB888_H_ */
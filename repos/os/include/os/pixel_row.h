@@ -0,0 +1,168 @@
+/*
+ * \brief  Operations on lines of pixels
+ * \author Norman Feske
+ * \date   2026-10-17
+ *
+ * The painters of 'nitpicker_gfx' spend most of their time in loops over
+ * the pixels of a line. The 'Pixel_row' template bundles these loops so
+ * that pixel types with a layout known to the vector unit can provide
+ * specialized implementations, see 'pixel_rgb565.h' and 'pixel_rgb888.h'.
+ * All specializations yield exactly the same pixels as the plain loops of
+ * 'Pixel_row_scalar'.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__OS__PIXEL_ROW_H_
+#define _INCLUDE__OS__PIXEL_ROW_H_
+
+#include <base/stdint.h>
+
+namespace Genode {
+
+	template <typename PT> struct Pixel_row_scalar;
+	template <typename PT> struct Pixel_row;
+}
+
+
+/*
+ * The specializations are used only if the CPU is known to have a 128-bit
+ * vector unit, e.g., SSE2 on x86_64 and NEON on ARMv8. Otherwise, the
+ * compiler would emulate the vector operations.
+ */
+#if defined(__SSE2__) || defined(__ARM_NEON)
+#define PIXEL_ROW_VECTORIZED
+
+namespace Genode {
+
+	namespace Pixel_vector {
+
+		typedef uint32_t u32 __attribute__((vector_size(16)));
+		typedef uint16_t u16 __attribute__((vector_size(16)));
+
+		template <typename V, typename T>
+		static inline V load(T const *p) { V v; __builtin_memcpy(&v, (void const *)p, sizeof(v)); return v; }
+
+		template <typename V, typename T>
+		static inline void store(T *p, V v) { __builtin_memcpy((void *)p, &v, sizeof(v)); }
+
+		template <typename V, typename T>
+		static inline V broadcast(T value) { return V { } + value; }
+
+		typedef uint8_t  u8  __attribute__((vector_size(16)));
+		typedef uint64_t u64 __attribute__((vector_size(16)));
+
+		/**
+		 * Zero-extend eight bytes to 16-bit lanes
+		 */
+		static inline u16 widen_8(unsigned char const *p)
+		{
+			uint64_t v;
+			__builtin_memcpy(&v, p, sizeof(v));
+			return (u16)__builtin_shuffle((u8)(u64 { v }), u8 { },
+			                              u8 { 0, 16, 1, 17, 2, 18, 3, 19,
+			                                   4, 20, 5, 21, 6, 22, 7, 23 });
+		}
+
+		/**
+		 * Zero-extend four bytes to 32-bit lanes
+		 */
+		static inline u32 widen_4(unsigned char const *p)
+		{
+			uint32_t v;
+			__builtin_memcpy(&v, p, sizeof(v));
+			u16 const w = (u16)__builtin_shuffle((u8)(u32 { v }), u8 { },
+			                                     u8 { 0, 16, 1, 17, 2, 18, 3, 19,
+			                                          4, 20, 5, 21, 6, 22, 7, 23 });
+			return (u32)__builtin_shuffle(w, u16 { }, u16 { 0, 8, 1, 9, 2, 10, 3, 11 });
+		}
+
+		/**
+		 * Return 'a' for lanes where 'mask' is set, 'b' otherwise
+		 */
+		template <typename V>
+		static inline V select(V mask, V a, V b) { return (mask & a) | (~mask & b); }
+	}
+}
+
+#endif /* __SSE2__ || __ARM_NEON */
+
+
+/**
+ * Plain pixel-wise implementation of the row operations
+ */
+template <typename PT>
+struct Genode::Pixel_row_scalar
+{
+	/**
+	 * Fill 'n' pixels with 'color'
+	 */
+	static void fill(PT *dst, PT color, unsigned n)
+	{
+		for (; n--; dst++)
+			*dst = color;
+	}
+
+	/**
+	 * Mix 'n' pixels with 'color' at the ratio 'alpha'
+	 */
+	static void mix(PT *dst, PT color, int alpha, unsigned n)
+	{
+		for (; n--; dst++)
+			*dst = PT::mix(*dst, color, alpha);
+	}
+
+	/**
+	 * Mix 'n' pixels with 'color' weighted by per-pixel opacity values
+	 *
+	 * Pixels with an opacity of 0 stay untouched. Pixels with an opacity of
+	 * 255 are set to 'color' if 'alpha' is 255.
+	 */
+	static void mix(PT *dst, PT color, int alpha,
+	                unsigned char const *opacity, unsigned n)
+	{
+		for (; n--; dst++, opacity++) {
+			int const value = *opacity;
+			if (value)
+				*dst = (value == 255 && alpha == 255)
+				     ? color : PT::mix(*dst, color, (alpha*value) >> 8);
+		}
+	}
+
+	/**
+	 * Blend 'n' source pixels onto the destination according to their
+	 * alpha values
+	 */
+	static void blend(PT *dst, PT const *src, unsigned char const *alpha,
+	                  unsigned n)
+	{
+		for (; n--; dst++, src++, alpha++) {
+			unsigned char const alpha_value = *alpha;
+			if (__builtin_expect(alpha_value != 0, true))
+				*dst = PT::mix(*dst, *src, alpha_value + 1);
+		}
+	}
+
+	/**
+	 * Set 'n' pixels to the average of the source pixel and 'color'
+	 */
+	static void avr(PT *dst, PT const *src, PT color, unsigned n)
+	{
+		for (; n--; dst++, src++)
+			*dst = PT::avr(color, *src);
+	}
+};
+
+
+/**
+ * Row operations, specialized for pixel types supported by the vector unit
+ */
+template <typename PT>
+struct Genode::Pixel_row : Pixel_row_scalar<PT> { };
+
+#endif /* _INCLUDE__OS__PIXEL_ROW_H_ */
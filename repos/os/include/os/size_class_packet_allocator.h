@@ -0,0 +1,404 @@
+/*
+ * \brief  Size-class allocator for packet streams
+ * \author Sebastian Sumpf
+ * \date   2026-10-17
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__OS__SIZE_CLASS_PACKET_ALLOCATOR_H_
+#define _INCLUDE__OS__SIZE_CLASS_PACKET_ALLOCATOR_H_
+
+#include <base/allocator.h>
+#include <util/misc_math.h>
+#include <util/string.h>
+
+namespace Genode { class Size_class_packet_allocator; }
+
+
+/**
+ * Packet allocator with constant-time allocation and release
+ *
+ * This allocator can be used in place of the 'Packet_allocator' for packet
+ * streams with high packet rates. The bulk buffer is divided into pages of
+ * equal size. Each page is either free, assigned to one size class, or part
+ * of a large allocation. A page assigned to a size class is split into
+ * slots of the class size, which are power-of-two multiples of the minimal
+ * packet size. For each size class, the pages with free slots are kept in a
+ * list so that an allocation takes the first of those pages and picks a
+ * free slot from the page's bitmap. Releasing a packet clears the slot's
+ * bit and returns the page to the free pages once it becomes empty.
+ *
+ * Packets larger than a page are allocated as contiguous run of free pages,
+ * which requires a linear search through the page table.
+ *
+ * All meta data is kept outside of the bulk buffer. Hence, the peer of a
+ * packet stream, which has write access to the bulk buffer, cannot corrupt
+ * the allocator state. Releasing packets with bogus offsets is ignored.
+ */
+class Genode::Size_class_packet_allocator : public Genode::Range_allocator
+{
+	public:
+
+		enum { MAX_SIZE_CLASSES = 16 };
+
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Size_class_packet_allocator(Size_class_packet_allocator const &);
+		Size_class_packet_allocator &operator = (Size_class_packet_allocator const &);
+
+		enum { NONE = ~0U };
+
+		enum Page_state : unsigned char { FREE, SLOTS, LARGE_HEAD, LARGE_TAIL };
+
+		enum { BITS_PER_WORD = sizeof(addr_t)*8 };
+
+		struct Page
+		{
+			unsigned   next;        /* link within free or partial list */
+			unsigned   prev;
+			unsigned   free_slots;  /* of a page in state SLOTS */
+			unsigned   run;         /* number of pages of a large allocation */
+			Page_state state;
+			unsigned char size_class;
+		};
+
+		Allocator     *_md_alloc;
+		unsigned const _min_log2;        /* log2 of smallest slot size */
+		unsigned const _page_log2;       /* log2 of page size */
+		unsigned const _num_classes;
+		unsigned const _words_per_page;  /* bitmap words per page */
+
+		addr_t   _base      = 0;
+		size_t   _size      = 0;
+		unsigned _num_pages = 0;
+		Page    *_pages     = nullptr;
+		addr_t  *_bits      = nullptr;
+		size_t   _avail     = 0;
+
+		unsigned _free_pages = NONE;                /* list of free pages */
+		unsigned _partial[MAX_SIZE_CLASSES] { };    /* pages with free slots */
+
+		static unsigned _log2_ceil(size_t value)
+		{
+			if (value <= 1) return 0;
+			return BITS_PER_WORD - __builtin_clzl((unsigned long)(value - 1));
+		}
+
+		size_t   _page_size()                const { return (size_t)1 << _page_log2; }
+		unsigned _slots(unsigned size_class) const {
+			return 1U << (_page_log2 - _min_log2 - size_class); }
+
+		addr_t *_page_bits(unsigned page) {
+			return &_bits[(size_t)page*_words_per_page]; }
+
+		addr_t _page_addr(unsigned page) const {
+			return _base + ((addr_t)page << _page_log2); }
+
+		/*
+		 * Doubly-linked page lists
+		 */
+
+		void _push(unsigned &head, unsigned page)
+		{
+			_pages[page].prev = NONE;
+			_pages[page].next = head;
+			if (head != NONE) _pages[head].prev = page;
+			head = page;
+		}
+
+		void _unlink(unsigned &head, unsigned page)
+		{
+			Page &p = _pages[page];
+			if (p.prev != NONE) _pages[p.prev].next = p.next;
+			else                head = p.next;
+			if (p.next != NONE) _pages[p.next].prev = p.prev;
+			p.next = p.prev = NONE;
+		}
+
+		bool _alloc_slot(unsigned size_class, void **out_addr)
+		{
+			unsigned &head = _partial[size_class];
+
+			/* assign free page to size class */
+			if (head == NONE) {
+				unsigned const page = _free_pages;
+				if (page == NONE)
+					return false;
+
+				_unlink(_free_pages, page);
+
+				Page &p = _pages[page];
+				p.state      = SLOTS;
+				p.size_class = (unsigned char)size_class;
+				p.free_slots = _slots(size_class);
+				memset(_page_bits(page), 0, _words_per_page*sizeof(addr_t));
+
+				_push(head, page);
+			}
+
+			unsigned const page  = head;
+			Page          &p     = _pages[page];
+			addr_t * const bits  = _page_bits(page);
+			unsigned const words = (_slots(size_class) + BITS_PER_WORD - 1)
+			                     / BITS_PER_WORD;
+
+			for (unsigned w = 0; w < words; w++) {
+
+				if (bits[w] == ~(addr_t)0) continue;
+
+				unsigned const bit  = __builtin_ctzl(~(unsigned long)bits[w]);
+				unsigned const slot = w*BITS_PER_WORD + bit;
+
+				if (slot >= _slots(size_class)) break;
+
+				bits[w] |= (addr_t)1 << bit;
+
+				if (--p.free_slots == 0)
+					_unlink(head, page);
+
+				size_t const slot_size = (size_t)1 << (_min_log2 + size_class);
+				_avail -= slot_size;
+
+				*out_addr = (void *)(_page_addr(page) + slot*slot_size);
+				return true;
+			}
+
+			/* inconsistent free-slot count, should never happen */
+			return false;
+		}
+
+		bool _alloc_large(size_t size, void **out_addr)
+		{
+			unsigned const count =
+				(unsigned)((size + _page_size() - 1) >> _page_log2);
+
+			for (unsigned first = 0, n = 0; first + count <= _num_pages; ) {
+
+				if (_pages[first + n].state != FREE) {
+					first += n + 1;
+					n = 0;
+					continue;
+				}
+
+				if (++n < count) continue;
+
+				for (unsigned i = 0; i < count; i++) {
+					_unlink(_free_pages, first + i);
+					_pages[first + i].state = i ? LARGE_TAIL : LARGE_HEAD;
+				}
+				_pages[first].run = count;
+				_avail -= (size_t)count << _page_log2;
+
+				*out_addr = (void *)_page_addr(first);
+				return true;
+			}
+			return false;
+		}
+
+		void _free_page(unsigned page)
+		{
+			_pages[page].state = FREE;
+			_push(_free_pages, page);
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param md_alloc   meta-data allocator
+		 * \param min_size   size of the smallest size class
+		 * \param page_size  size of the pages assigned to size classes,
+		 *                   which is also the largest size class
+		 *
+		 * Both sizes are rounded up to powers of two.
+		 */
+		Size_class_packet_allocator(Allocator *md_alloc,
+		                            size_t     min_size  = 64,
+		                            size_t     page_size = 16*1024)
+		:
+			_md_alloc(md_alloc),
+			_min_log2(_log2_ceil(max(min_size, (size_t)sizeof(addr_t)))),
+			_page_log2(max(_log2_ceil(page_size), _min_log2)),
+			_num_classes(min(_page_log2 - _min_log2 + 1,
+			                 (unsigned)MAX_SIZE_CLASSES)),
+			_words_per_page(max((1U << (_page_log2 - _min_log2)) / BITS_PER_WORD, 1U))
+		{
+			for (unsigned i = 0; i < MAX_SIZE_CLASSES; i++)
+				_partial[i] = NONE;
+		}
+
+		~Size_class_packet_allocator()
+		{
+			if (_pages) remove_range(_base, _size);
+		}
+
+
+		/*******************************
+		 ** Range-allocator interface **
+		 *******************************/
+
+		int add_range(addr_t base, size_t size) override
+		{
+			if (_pages) return -1;
+
+			unsigned const num_pages = (unsigned)(size >> _page_log2);
+			if (!num_pages) return -1;
+
+			_pages = (Page *)_md_alloc->alloc(num_pages*sizeof(Page));
+			_bits  = (addr_t *)_md_alloc->alloc((size_t)num_pages*_words_per_page
+			                                    *sizeof(addr_t));
+			_base      = base;
+			_size      = size;
+			_num_pages = num_pages;
+			_avail     = (size_t)num_pages << _page_log2;
+
+			/* push in reverse order to hand out low addresses first */
+			for (unsigned i = num_pages; i > 0; i--) {
+				_pages[i - 1] = Page { NONE, NONE, 0, 0, FREE, 0 };
+				_push(_free_pages, i - 1);
+			}
+			return 0;
+		}
+
+		int remove_range(addr_t base, size_t) override
+		{
+			if (!_pages || base != _base) return -1;
+
+			_md_alloc->free(_pages, _num_pages*sizeof(Page));
+			_md_alloc->free(_bits, (size_t)_num_pages*_words_per_page
+			                       *sizeof(addr_t));
+			_pages      = nullptr;
+			_bits       = nullptr;
+			_base       = 0;
+			_size       = 0;
+			_num_pages  = 0;
+			_avail      = 0;
+			_free_pages = NONE;
+			for (unsigned i = 0; i < MAX_SIZE_CLASSES; i++)
+				_partial[i] = NONE;
+
+			return 0;
+		}
+
+		/**
+		 * Allocate packet
+		 *
+		 * Slots are aligned to their size relative to the base of the
+		 * allocator's range. Hence, an alignment requirement is satisfied
+		 * by selecting a size class of at least the alignment. Alignments
+		 * beyond the page size cannot be satisfied.
+		 */
+		Alloc_return alloc_aligned(size_t size, void **out_addr, int align,
+		                           addr_t, addr_t) override
+		{
+			if (align > 0 && (unsigned)align > _page_log2)
+				return Alloc_return::RANGE_CONFLICT;
+
+			if (align > 0)
+				size = max(size, (size_t)1 << align);
+
+			return alloc(size, out_addr) ? Alloc_return::OK
+			                             : Alloc_return::RANGE_CONFLICT;
+		}
+
+		bool alloc(size_t size, void **out_addr) override
+		{
+			if (!_pages) return false;
+
+			if (size > _page_size())
+				return _alloc_large(size, out_addr);
+
+			unsigned const log2 = max(_log2_ceil(size), _min_log2);
+			unsigned const size_class = log2 - _min_log2;
+			if (size_class >= _num_classes)
+				return _alloc_large(size, out_addr);
+
+			return _alloc_slot(size_class, out_addr);
+		}
+
+		void free(void *addr) override
+		{
+			addr_t const a = (addr_t)addr;
+			if (a < _base || a >= _base + ((addr_t)_num_pages << _page_log2))
+				return;
+
+			unsigned const page = (unsigned)((a - _base) >> _page_log2);
+			Page &p = _pages[page];
+
+			switch (p.state) {
+
+			case SLOTS:
+				{
+					unsigned const slot_log2 = _min_log2 + p.size_class;
+					addr_t   const local     = a - _page_addr(page);
+					if (local & (((addr_t)1 << slot_log2) - 1))
+						return;
+
+					unsigned const slot = (unsigned)(local >> slot_log2);
+					addr_t  &word = _page_bits(page)[slot / BITS_PER_WORD];
+					addr_t const mask = (addr_t)1 << (slot % BITS_PER_WORD);
+
+					/* ignore double release */
+					if (!(word & mask))
+						return;
+
+					word &= ~mask;
+					_avail += (size_t)1 << slot_log2;
+
+					unsigned &head = _partial[p.size_class];
+					if (p.free_slots++ == 0)
+						_push(head, page);
+
+					if (p.free_slots == _slots(p.size_class)) {
+						_unlink(head, page);
+						_free_page(page);
+					}
+					return;
+				}
+
+			case LARGE_HEAD:
+				{
+					if (a != _page_addr(page))
+						return;
+
+					unsigned const run = p.run;
+					for (unsigned i = 0; i < run; i++)
+						_free_page(page + i);
+
+					_avail += (size_t)run << _page_log2;
+					return;
+				}
+
+			case FREE:
+			case LARGE_TAIL:
+				return;
+			}
+		}
+
+		void free(void *addr, size_t) override { free(addr); }
+
+		bool   need_size_for_free() const override { return false; }
+		size_t overhead(size_t)     const override { return 0; }
+		size_t avail()              const override { return _avail; }
+
+		bool valid_addr(addr_t addr) const override
+		{
+			return addr >= _base
+			    && addr <  _base + ((addr_t)_num_pages << _page_log2);
+		}
+
+		Alloc_return alloc_addr(size_t, addr_t) override {
+			return Alloc_return(Alloc_return::OUT_OF_METADATA); }
+};
+
+#endif /* _INCLUDE__OS__SIZE_CLASS_PACKET_ALLOCATOR_H_ */
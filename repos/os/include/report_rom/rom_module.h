@@ -17,6 +17,7 @@
 /* Genode includes */
 #include <util/reconstructible.h>
 #include <os/session_policy.h>
+#include <base/allocator.h>
 #include <base/attached_ram_dataspace.h>
 
 namespace Rom {
@@ -35,6 +36,7 @@ namespace Rom {
 	typedef Genode::List<Module> Module_list;
 	typedef Genode::List<Reader> Reader_list;
 	typedef Genode::List<Writer> Writer_list;
+	typedef Genode::List<Buffer> Buffer_list;
 }
 
 
@@ -57,6 +59,40 @@ struct Rom::Reader : private Reader_list::Element, Interface
 };
 
 
+/**
+ * Backing store of one version of the module content
+ *
+ * Buffers that are mapped by readers are never modified.
+ */
+class Rom::Buffer : private Buffer_list::Element
+{
+	private:
+
+		friend class Module;
+		friend class Genode::List<Buffer>;
+
+		Attached_ram_dataspace _ds;
+
+		size_t   _size     = 0;  /* content size, excluding the zero termination */
+		unsigned _mappings = 0;  /* number of readers that map the buffer */
+
+		Buffer(Genode::Ram_allocator &ram, Genode::Region_map &rm, size_t capacity)
+		: _ds(ram, rm, capacity) { }
+
+		/*
+		 * Noncopyable
+		 */
+		Buffer(Buffer const &);
+		Buffer &operator = (Buffer const &);
+
+	public:
+
+		Genode::Ram_dataspace_capability cap() const { return _ds.cap(); }
+
+		size_t size() const { return _size; }
+};
+
+
 struct Rom::Readable_module : Interface
 {
 	/**
@@ -75,6 +111,23 @@ struct Rom::Readable_module : Interface
 	                            size_t dst_len) const = 0;
 
 	virtual size_t size() const = 0;
+
+	/**
+	 * Map buffer of the current content
+	 *
+	 * Instead of copying the content, a reader may hand out the buffer
+	 * to its client. The buffer stays unmodified until it is unmapped.
+	 *
+	 * \return  buffer or nullptr if the content is not readable
+	 */
+	virtual Buffer const *map_content(Reader const &reader) = 0;
+
+	virtual void unmap_content(Buffer const &buffer) = 0;
+
+	/**
+	 * Return true if buffer holds the current content
+	 */
+	virtual bool up_to_date(Buffer const &buffer) const = 0;
 };
 
 
@@ -136,6 +189,7 @@ struct Rom::Module : private Module_list::Element, Readable_module
 
 		Name _name;
 
+		Genode::Allocator     &_alloc;
 		Genode::Ram_allocator &_ram;
 		Genode::Region_map    &_rm;
 
@@ -150,19 +204,71 @@ struct Rom::Module : private Module_list::Element, Readable_module
 		 */
 		Writer const *_last_writer = nullptr;
 
-		/**
-		 * Dataspace used as backing store
+		/*
+		 * Buffers used as backing store
 		 *
-		 * The buffer for the content is not allocated from the heap to
-		 * allow for the immediate release of the underlying backing store when
-		 * the module gets destructed.
+		 * The buffers for the content are dataspaces rather than heap
+		 * allocations to allow for the immediate release of the underlying
+		 * backing store when the module gets destructed.
+		 *
+		 * New content is written in place unless readers map the current
+		 * buffer. In this case, the content goes to a spare buffer and the
+		 * current one is retired until its last reader unmaps it. Once
+		 * unmapped, a retired buffer becomes the spare buffer. So, as long
+		 * as readers keep up with the updates, two buffers take turns.
+		 */
+		Buffer      *_curr  = nullptr;
+		Buffer      *_spare = nullptr;
+		Buffer_list  _retired { };
+
+		void _destroy(Buffer *buffer) {
+			Genode::destroy(&_alloc, buffer); }
+
+		void _retire_curr()
+		{
+			_retired.insert(_curr);
+			_curr = nullptr;
+		}
+
+		/**
+		 * Return buffer for new content of the given capacity
 		 */
-		Constructible<Attached_ram_dataspace> _ds { };
+		Buffer &_writable_buffer(size_t capacity)
+		{
+			if (_curr && _curr->_mappings)
+				_retire_curr();
+
+			if (_curr && _curr->_ds.size() >= capacity)
+				return *_curr;
+
+			if (_curr) {
+				_destroy(_curr);
+				_curr = nullptr;
+			}
+
+			if (_spare && _spare->_ds.size() >= capacity) {
+				_curr  = _spare;
+				_spare = nullptr;
+				return *_curr;
+			}
+
+			if (_spare) {
+				_destroy(_spare);
+				_spare = nullptr;
+			}
+
+			_curr = new (&_alloc) Buffer(_ram, _rm, capacity);
+			return *_curr;
+		}
 
 		/**
-		 * Content size, which may less than the capacilty of '_ds'.
+		 * Return true if writing the content would not change the module
 		 */
-		size_t _size = 0;
+		bool _unchanged(Writer const &writer, char const *src, size_t len) const
+		{
+			return _curr && _last_writer == &writer && _curr->_size == len
+			    && !Genode::memcmp(_curr->_ds.local_addr<char const>(), src, len);
+		}
 
 
 		/********************************
@@ -174,6 +280,7 @@ struct Rom::Module : private Module_list::Element, Readable_module
 		/**
 		 * Constructor
 		 *
+		 * \param alloc         allocator for the buffer meta data
 		 * \param ram           allocator for the module's backing store
 		 * \param rm            region map of the local address space, needed
 		 *                      to access the allocated backing store
@@ -183,13 +290,14 @@ struct Rom::Module : private Module_list::Element, Readable_module
 		 * \param write_policy  policy hook function that is evaluated each
 		 *                      time when the module content is changed
 		 */
-		Module(Genode::Ram_allocator &ram,
+		Module(Genode::Allocator     &alloc,
+		       Genode::Ram_allocator &ram,
 		       Genode::Region_map    &rm,
 		       Name            const &name,
 		       Read_policy     const &read_policy,
 		       Write_policy    const &write_policy)
 		:
-			_name(name), _ram(ram), _rm(rm),
+			_name(name), _alloc(alloc), _ram(ram), _rm(rm),
 			_read_policy(read_policy), _write_policy(write_policy)
 		{ }
 
@@ -222,8 +330,13 @@ struct Rom::Module : private Module_list::Element, Readable_module
 
 			/* clear content if its origin disappears */
 			if (_last_writer == &writer) {
-				Genode::memset(_ds->local_addr<char>(), 0, _size);
-				_size = 0;
+				if (_curr && _curr->_mappings)
+					_retire_curr();
+
+				if (_curr) {
+					Genode::memset(_curr->_ds.local_addr<char>(), 0, _curr->_size);
+					_curr->_size = 0;
+				}
 				_last_writer = nullptr;
 			}
 		}
@@ -246,6 +359,16 @@ struct Rom::Module : private Module_list::Element, Readable_module
 
 	public:
 
+		/*
+		 * Readers unmap their buffers before they unregister, hence no
+		 * retired buffers are left at this point.
+		 */
+		~Module()
+		{
+			if (_curr)  _destroy(_curr);
+			if (_spare) _destroy(_spare);
+		}
+
 		/**
 		 * Assign new content to the ROM module
 		 *
@@ -256,26 +379,27 @@ struct Rom::Module : private Module_list::Element, Readable_module
 			if (!_write_policy.write_permitted(*this, writer))
 				return;
 
-			_size = 0;
+			/* spare the readers from updating to the same content */
+			if (_unchanged(writer, src, src_len))
+				return;
 
 			_last_writer = &writer;
 
 			/*
-			 * Realloc backing store if needed
-			 *
 			 * Take a terminating zero into account, which we append to each
 			 * report. This way, we do not need to trust report clients to
 			 * append a zero termination to textual reports.
 			 */
-			if (!_ds.constructed() || _ds->size() < (src_len + 1))
-				_ds.construct(_ram, _rm, (src_len + 1));
+			Buffer &buffer = _writable_buffer(src_len + 1);
+			char * const dst = buffer._ds.local_addr<char>();
 
 			/* copy content into backing store */
-			_size = src_len;
-			Genode::memcpy(_ds->local_addr<char>(), src, _size);
+			Genode::memcpy(dst, src, src_len);
 
-			/* append zero termination */
-			_ds->local_addr<char>()[src_len] = 0;
+			/* append zero termination and clear remainder of old content */
+			Genode::memset(dst + src_len, 0,
+			               Genode::max(buffer._size, src_len) - src_len + 1);
+			buffer._size = src_len;
 
 			/* notify ROM clients that access the module */
 			for (Reader *r = _readers.first(); r; r = r->next()) {
@@ -292,20 +416,60 @@ struct Rom::Module : private Module_list::Element, Readable_module
 		 */
 		size_t read_content(Reader const &reader, char *dst, size_t dst_len) const override
 		{
-			if (!_ds.constructed() || !_last_writer)
+			if (!_curr || !_last_writer)
 				return 0;
 
 			if (!_read_policy.read_permitted(*this, *_last_writer, reader))
 				return 0;
 
-			if (dst_len < _size)
+			if (dst_len < _curr->_size)
 				throw Buffer_too_small();
 
-			Genode::memcpy(dst, _ds->local_addr<char>(), _size);
-			return _size;
+			Genode::memcpy(dst, _curr->_ds.local_addr<char>(), _curr->_size);
+			return _curr->_size;
 		}
 
-		virtual size_t size() const override { return _size; }
+		virtual size_t size() const override { return _curr ? _curr->_size : 0; }
+
+		/**
+		 * Readable_module interface
+		 */
+		Buffer const *map_content(Reader const &reader) override
+		{
+			if (!_curr || !_last_writer)
+				return nullptr;
+
+			if (!_read_policy.read_permitted(*this, *_last_writer, reader))
+				return nullptr;
+
+			_curr->_mappings++;
+			return _curr;
+		}
+
+		/**
+		 * Readable_module interface
+		 */
+		void unmap_content(Buffer const &mapped) override
+		{
+			Buffer &buffer = const_cast<Buffer &>(mapped);
+
+			if (--buffer._mappings || &buffer == _curr)
+				return;
+
+			/* last reader of a retired buffer is gone */
+			_retired.remove(&buffer);
+
+			if (_spare)
+				_destroy(&buffer);
+			else
+				_spare = &buffer;
+		}
+
+		/**
+		 * Readable_module interface
+		 */
+		bool up_to_date(Buffer const &buffer) const override {
+			return &buffer == _curr; }
 
 		Name name() const { return _name; }
 };
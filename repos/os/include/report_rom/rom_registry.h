@@ -38,6 +38,14 @@ struct Rom::Registry_for_reader : Interface
 	                                Module::Name const &rom_label) = 0;
 
 	virtual void release(Reader &reader, Readable_module &module) = 0;
+
+	/**
+	 * Return true if the reader may map the buffer of the module content
+	 *
+	 * Readers that map the same buffer can modify the content seen by
+	 * each other. Hence, sharing must be explicitly permitted.
+	 */
+	virtual bool shared_content(Module::Name const &) { return false; }
 };
 
 
@@ -51,6 +51,22 @@ class Rom::Session_component : public Genode::Rpc_object<Genode::Rom_session>,
 				throw Genode::Service_denied(); }
 		}
 
+		/*
+		 * If permitted by the registry, the session hands out the module's
+		 * buffer instead of a private copy of the content
+		 */
+		bool const _shared = _registry.shared_content(_label.string());
+
+		Buffer const *_mapped = nullptr;
+
+		void _unmap()
+		{
+			if (_mapped)
+				_module.unmap_content(*_mapped);
+
+			_mapped = nullptr;
+		}
+
 		Constructible<Genode::Attached_ram_dataspace> _ds { };
 
 		size_t _content_size = 0;
@@ -69,6 +85,12 @@ class Rom::Session_component : public Genode::Rpc_object<Genode::Rom_session>,
 				Genode::Signal_transmitter(_sigh).submit();
 		}
 
+		/*
+		 * Noncopyable
+		 */
+		Session_component(Session_component const &);
+		Session_component &operator = (Session_component const &);
+
 	public:
 
 		Session_component(Genode::Ram_allocator &ram, Genode::Region_map &rm,
@@ -81,6 +103,7 @@ class Rom::Session_component : public Genode::Rpc_object<Genode::Rom_session>,
 
 		~Session_component()
 		{
+			_unmap();
 			_registry.release(*this, _module);
 		}
 
@@ -90,6 +113,20 @@ class Rom::Session_component : public Genode::Rpc_object<Genode::Rom_session>,
 		{
 			using namespace Genode;
 
+				if (_shared) {
+					_unmap();
+					_mapped = _module.map_content(*this);
+				}
+
+				if (_mapped) {
+					_ds.destruct();
+					_content_size = _mapped->size();
+					_valid        = _content_size > 0;
+
+					Dataspace_capability ds_cap = static_cap_cast<Dataspace>(_mapped->cap());
+					return static_cap_cast<Rom_dataspace>(ds_cap);
+				}
+
 				/* replace dataspace by new one */
 				/* XXX we could keep the old dataspace if the size fits */
 				_ds.construct(_ram, _rm, _module.size());
@@ -107,6 +144,10 @@ class Rom::Session_component : public Genode::Rpc_object<Genode::Rom_session>,
 
 		bool update() override
 		{
+			/* a mapped buffer is never modified, new content needs a new one */
+			if (_mapped)
+				return _module.up_to_date(*_mapped);
+
 			if (!_ds.constructed() || _module.size() > _ds->size())
 				return false;
 
@@ -25,6 +25,11 @@ namespace Genode { template <typename, unsigned> class Dirty_rect; }
  * \param RECT       rectangle type (as defined in 'util/geometry.h')
  * \param NUM_RECTS  number of rectangles used to represent the dirty area
  *
+ * The rectangles are coalesced whenever a rectangle is marked as dirty.
+ * Hence, no pair of the tracked rectangles overlaps to an extent that makes
+ * processing their compound cheaper than processing both rectangles. Only if
+ * all 'NUM_RECTS' rectangles are in use, a new rectangle is merged with the
+ * rectangle that grows the least.
  */
 template <typename RECT, unsigned NUM_RECTS>
 class Genode::Dirty_rect
@@ -38,6 +43,11 @@ class Genode::Dirty_rect
 
 		/**
 		 * Return true if it is worthwhile to merge 'r1' and 'r2' into one
+		 *
+		 * This is the case if the compound is smaller than the sum of the
+		 * areas, i.e., if both rectangles overlap. It is cheaper to process
+		 * the compound (including some portions that aren't actually dirty)
+		 * instead of processing the overlap twice.
 		 */
 		static bool _should_be_merged(Rect const &r1, Rect const &r2)
 		{
@@ -50,7 +60,7 @@ class Genode::Dirty_rect
 		/**
 		 * Return the costs of adding a new to an existing rectangle
 		 */
-		static unsigned _costs(Rect const &existing, Rect const &added)
+		static size_t _costs(Rect const &existing, Rect const &added)
 		{
 			/*
 			 * If 'existing' is unused, using it will cost the area of the
@@ -69,8 +79,47 @@ class Genode::Dirty_rect
 			     - existing.area().count();
 		}
 
+		/**
+		 * Merge the rectangle at index 'i' with all rectangles worth merging
+		 *
+		 * Each merge enlarges the rectangle, which may make it overlap with
+		 * further rectangles. Hence, we repeat until no merge happens.
+		 */
+		void _coalesce(unsigned i)
+		{
+			for (bool merged = true; merged; ) {
+
+				merged = false;
+
+				for (unsigned j = 0; j < NUM_RECTS; j++) {
+
+					Rect &r = _rects[j];
+
+					if (j == i || !r.valid() || !_should_be_merged(_rects[i], r))
+						continue;
+
+					_rects[i] = Rect::compound(_rects[i], r);
+					r         = Rect();
+					merged    = true;
+				}
+			}
+		}
+
 	public:
 
+		/**
+		 * Call functor for each dirty area
+		 *
+		 * The functor 'fn' takes a 'Rect const &' as argument.
+		 */
+		template <typename FN>
+		void for_each_rect(FN const &fn) const
+		{
+			for (unsigned i = 0; i < NUM_RECTS; i++)
+				if (_rects[i].valid())
+					fn(_rects[i]);
+		}
+
 		/**
 		 * Call functor for each dirty area
 		 *
@@ -80,62 +129,51 @@ class Genode::Dirty_rect
 		template <typename FN>
 		void flush(FN const &fn)
 		{
-			/*
-			 * Merge rectangles if their compound is smaller than sum of their
-			 * areas. This happens if both rectangles overlap. In this case, it
-			 * is cheaper to process the compound (including some portions that
-			 * aren't actually dirty) instead of processing the overlap twice.
-			 */
-			for (unsigned i = 0; i < NUM_RECTS - 1; i++) {
-				for (unsigned j = i + 1; j < NUM_RECTS; j++) {
+			for_each_rect(fn);
 
-					Rect &r1 = _rects[i];
-					Rect &r2 = _rects[j];
-
-					if (r1.valid() && r2.valid() && _should_be_merged(r1, r2)) {
-						r1 = Rect::compound(r1, r2);
-						r2 = Rect();
-					}
-				}
-			}
-
-			/*
-			 * Apply functor to each dirty rectangle and mark rectangle as
-			 * clear.
-			 */
-			for (unsigned i = 0; i < NUM_RECTS; i++) {
-				if (_rects[i].valid()) {
-					fn(_rects[i]);
-					_rects[i] = Rect();
-				}
-			}
+			for (unsigned i = 0; i < NUM_RECTS; i++)
+				_rects[i] = Rect();
 		}
 
 		void mark_as_dirty(Rect added)
 		{
+			if (!added.valid())
+				return;
+
 			/* index of best matching rectangle in '_rects' array */
 			unsigned best = 0;
 
 			/* value to optimize */
-			size_t highest_costs = ~0;
+			size_t lowest_costs = ~(size_t)0;
 
 			/*
-			 * Determine the most efficient rectangle to expand.
+			 * Determine the most efficient rectangle to expand. On equal
+			 * costs, we prefer expanding a populated rectangle over using
+			 * an unused one.
 			 */
 			for (unsigned i = 0; i < NUM_RECTS; i++) {
 
 				size_t const costs = _costs(_rects[i], added);
 
-				if (costs > highest_costs)
+				if (costs > lowest_costs)
+					continue;
+
+				if (costs == lowest_costs && !_rects[i].valid())
 					continue;
 
-				best          = i;
-				highest_costs = costs;
+				best         = i;
+				lowest_costs = costs;
 			}
 
 			Rect &rect = _rects[best];
 
+			/* rectangle is already covered */
+			if (rect.valid() && lowest_costs == 0)
+				return;
+
 			rect = rect.valid() ? Rect::compound(rect, added) : added;
+
+			_coalesce(best);
 		}
 };
 
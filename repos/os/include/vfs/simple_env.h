@@ -31,6 +31,13 @@ class Vfs::Simple_env : public Vfs::Env
 
 		Vfs::Dir_file_system _root_dir;
 
+		template <typename FN>
+		Vfs::File_system_factory &_extended_fs_factory(FN const &fn)
+		{
+			fn(_fs_factory);
+			return _fs_factory;
+		}
+
 	public:
 
 		Simple_env(Genode::Env       &env,
@@ -40,6 +47,24 @@ class Vfs::Simple_env : public Vfs::Env
 			_env(env), _alloc(alloc), _root_dir(*this, config, _fs_factory)
 		{ }
 
+		/**
+		 * Constructor
+		 *
+		 * \param extend_fn  functor that is called with the
+		 *                   'Global_file_system_factory' as argument before
+		 *                   the root directory is created, which allows the
+		 *                   component to add file-system types of its own
+		 */
+		template <typename FN>
+		Simple_env(Genode::Env       &env,
+		           Genode::Allocator &alloc,
+		           Genode::Xml_node   config,
+		           FN          const &extend_fn)
+		:
+			_env(env), _alloc(alloc),
+			_root_dir(*this, config, _extended_fs_factory(extend_fn))
+		{ }
+
 		void apply_config(Genode::Xml_node const &config)
 		{
 			_root_dir.apply_config(config);
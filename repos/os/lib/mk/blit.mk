@@ -1,4 +1,5 @@
-SRC_CC   = blit.cc
+SRC_CC   = blit.cc kernels.cc
 INC_DIR += $(REP_DIR)/src/lib/blit
 
-vpath blit.cc $(REP_DIR)/src/lib/blit
+vpath blit.cc    $(REP_DIR)/src/lib/blit
+vpath kernels.cc $(REP_DIR)/src/lib/blit
@@ -1,4 +1,5 @@
-SRC_CC += ethernet.cc ipv4.cc dhcp.cc arp.cc udp.cc tcp.cc
-SRC_CC += icmp.cc internet_checksum.cc
+SRC_CC  += ethernet.cc ipv4.cc dhcp.cc arp.cc udp.cc tcp.cc
+SRC_CC  += icmp.cc internet_checksum.cc checksum_kernel.cc
+INC_DIR += $(REP_DIR)/src/lib/net
 
 vpath %.cc $(REP_DIR)/src/lib/net
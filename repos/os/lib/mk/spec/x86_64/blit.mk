@@ -1,6 +1,10 @@
-SRC_CC  = blit.cc
+SRC_CC  = blit.cc kernels.cc kernels_avx2.cc
 REQUIRES = x86 64bit
 INC_DIR += $(REP_DIR)/src/lib/blit/spec/x86_64 \
-           $(REP_DIR)/src/lib/blit/spec/x86
+           $(REP_DIR)/src/lib/blit/spec/x86 \
+           $(REP_DIR)/src/lib/blit
 
-vpath blit.cc $(REP_DIR)/src/lib/blit
+CC_OPT_kernels_avx2 = -mavx2
+
+vpath blit.cc      $(REP_DIR)/src/lib/blit
+vpath kernels%.cc  $(REP_DIR)/src/lib/blit/spec/x86_64
@@ -0,0 +1,10 @@
+SRC_CC  += ethernet.cc ipv4.cc dhcp.cc arp.cc udp.cc tcp.cc
+SRC_CC  += icmp.cc internet_checksum.cc
+SRC_CC  += checksum_kernel.cc checksum_kernel_avx2.cc
+REQUIRES = x86 64bit
+INC_DIR += $(REP_DIR)/src/lib/net
+
+CC_OPT_checksum_kernel_avx2 = -mavx2
+
+vpath checksum_kernel%.cc $(REP_DIR)/src/lib/net/spec/x86_64
+vpath %.cc                $(REP_DIR)/src/lib/net
@@ -131,6 +131,17 @@ void Monitor::print(bool activity, bool affinity)
 		}
 		log(Cstring(_curr_entry_data));
 	});
+
+	/* report entries that were overwritten before we could print them */
+	unsigned long const lost = _buffer.take_lost();
+	if (lost) {
+		if (!printed_buf_entries) {
+			log("   <buffer>");
+			printed_buf_entries = true;
+		}
+		log("   <lost entries=\"", lost, "\"/>");
+	}
+
 	/* print end tags */
 	if (printed_buf_entries)
 		log("   </buffer>");
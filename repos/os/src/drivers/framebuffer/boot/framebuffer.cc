@@ -13,6 +13,7 @@
 
 #include <framebuffer.h>
 #include <base/component.h>
+#include <blit/blit.h>
 
 using namespace Framebuffer;
 
@@ -80,18 +81,14 @@ void Session_component::refresh(int const x, int const y, int const w, int const
 	uint32_t const u_w = min(_core_fb.width,  max(c_w, 0U) + u_x);
 	uint32_t const u_h = min(_core_fb.height, max(c_h, 0U) + u_y);
 
-	Pixel_rgb888       * const pixel_32 = _fb_mem->local_addr<Pixel_rgb888>();
-	Pixel_rgb565 const * const pixel_16 = _fb_ram->local_addr<Pixel_rgb565>();
+	/* the pixels are accessed as plain words as the pixel types are packed */
+	uint32_t       * const pixel_32 = _fb_mem->local_addr<uint32_t>();
+	uint16_t const * const pixel_16 = _fb_ram->local_addr<uint16_t>();
 
-	for (uint32_t r = u_y; r < u_h; ++r) {
-		for (uint32_t c = u_x; c < u_w; ++c) {
-			uint32_t const s = c + r * _core_fb.width;
-			uint32_t const d = c + r * (_core_fb.pitch / (_core_fb.bpp / 8));
-
-			pixel_32[d].rgba(pixel_16[s].r(), pixel_16[s].g(),
-			                 pixel_16[s].b(), 0);
-		}
-	}
+	Blit::rgb565_to_rgb888(pixel_16 + u_x + u_y * _core_fb.width,
+	                       _core_fb.width * sizeof(Pixel_rgb565),
+	                       pixel_32 + u_x + u_y * (_core_fb.pitch / (_core_fb.bpp / 8)),
+	                       _core_fb.pitch, u_w - u_x, u_h - u_y);
 }
 
 Genode::Dataspace_capability Session_component::dataspace()
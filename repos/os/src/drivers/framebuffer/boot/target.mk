@@ -1,4 +1,4 @@
 TARGET   = fb_boot_drv
-LIBS     = base
+LIBS     = base blit
 SRC_CC   = main.cc framebuffer.cc
 INC_DIR += $(PRG_DIR)/include
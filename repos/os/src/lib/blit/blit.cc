@@ -13,6 +13,14 @@
 
 #include <blit/blit.h>
 #include <blit_helper.h>
+#include <blit_kernels.h>
+
+
+static Blit::Kernels const &_kernels()
+{
+	static Blit::Kernels const &kernels = Blit::select_kernels();
+	return kernels;
+}
 
 
 extern "C" void blit(void const *s, unsigned src_w,
@@ -37,7 +45,7 @@ extern "C" void blit(void const *s, unsigned src_w,
 
 	/* copy 32byte chunks */
 	if (w >> 5) {
-		copy_block_32byte(src, src_w, dst, dst_w, w >> 5, h);
+		_kernels().copy_32byte(src, src_w, dst, dst_w, w >> 5, h);
 		src += w & ~31;
 		dst += w & ~31;
 		w    = w &  31;
@@ -54,3 +62,41 @@ extern "C" void blit(void const *s, unsigned src_w,
 	/* handle trailing row */
 	if (w >> 1) copy_16bit_column(src, src_w, dst, dst_w, h);
 }
+
+
+void Blit::rotate(uint32_t const *src, unsigned src_w,
+                  uint32_t *dst, unsigned dst_w, int w, int h, Rotation rotation)
+{
+	if (w <= 0 || h <= 0) return;
+
+	if (rotation == ROTATE_0) {
+		blit(src, src_w, dst, dst_w, w*4, h);
+		return;
+	}
+	_kernels().rotate(src, src_w, dst, dst_w, w, h, rotation);
+}
+
+
+void Blit::rgb888_to_rgb565(uint32_t const *src, unsigned src_w,
+                            uint16_t *dst, unsigned dst_w, int w, int h)
+{
+	if (w <= 0) return;
+
+	for (int y = 0; y < h; y++)
+		_kernels().rgb888_to_rgb565(Scalar::pixel(src, src_w, 0, y),
+		                            Scalar::pixel(dst, dst_w, 0, y), w);
+}
+
+
+void Blit::rgb565_to_rgb888(uint16_t const *src, unsigned src_w,
+                            uint32_t *dst, unsigned dst_w, int w, int h)
+{
+	if (w <= 0) return;
+
+	for (int y = 0; y < h; y++)
+		_kernels().rgb565_to_rgb888(Scalar::pixel(src, src_w, 0, y),
+		                            Scalar::pixel(dst, dst_w, 0, y), w);
+}
+
+
+char const *Blit::kernels() { return _kernels().name; }
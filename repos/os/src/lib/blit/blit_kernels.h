@@ -0,0 +1,120 @@
+/*
+ * \brief  Interface between the blit front end and the CPU-specific kernels
+ * \author Norman Feske
+ * \date   2026-10-17
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _LIB__BLIT__BLIT_KERNELS_H_
+#define _LIB__BLIT__BLIT_KERNELS_H_
+
+#include <blit/blit.h>
+
+namespace Blit {
+
+	struct Kernels;
+
+	/**
+	 * Return kernels best suited for the CPU
+	 *
+	 * Implemented once per CPU architecture. The function is called once
+	 * by the front end.
+	 */
+	Kernels const &select_kernels();
+}
+
+
+struct Blit::Kernels
+{
+	char const *name;
+
+	/**
+	 * Copy 'h' lines of 'w' 32-byte chunks to a 32bit-aligned destination
+	 */
+	void (*copy_32byte)(char const *src, int src_w, char *dst, int dst_w,
+	                    int w, int h);
+
+	/**
+	 * Rotate block by 90, 180, or 270 degrees
+	 */
+	void (*rotate)(uint32_t const *src, unsigned src_w,
+	               uint32_t *dst, unsigned dst_w, int w, int h, Rotation);
+
+	/**
+	 * Convert one line of 'n' pixels
+	 */
+	void (*rgb888_to_rgb565)(uint32_t const *src, uint16_t *dst, int n);
+	void (*rgb565_to_rgb888)(uint16_t const *src, uint32_t *dst, int n);
+};
+
+
+/*
+ * The scalar functions are used by the generic kernels and for the parts of
+ * a block that are too small for the vector unit. They have internal linkage
+ * so that kernels built with different compiler flags never share code.
+ */
+namespace Blit { namespace Scalar {
+
+	/**
+	 * Return address of pixel at position 'x', 'y' of a buffer
+	 */
+	template <typename T>
+	static inline T *pixel(T *base, unsigned line, int x, int y)
+	{
+		return (T *)((Genode::addr_t)base + (long)y*line) + x;
+	}
+
+	static inline uint16_t rgb565(uint32_t p)
+	{
+		return (uint16_t)(((p >> 8) & 0xf800) | ((p >> 5) & 0x07e0)
+		                | ((p >> 3) & 0x001f));
+	}
+
+	static inline uint32_t rgb888(uint16_t p)
+	{
+		return ((p & 0xf800) << 8) | ((p & 0x07e0) << 5) | ((p & 0x001f) << 3);
+	}
+
+	static inline void rgb888_to_rgb565(uint32_t const *src, uint16_t *dst, int n)
+	{
+		for (int i = 0; i < n; i++)
+			dst[i] = rgb565(src[i]);
+	}
+
+	static inline void rgb565_to_rgb888(uint16_t const *src, uint32_t *dst, int n)
+	{
+		for (int i = 0; i < n; i++)
+			dst[i] = rgb888(src[i]);
+	}
+
+	/**
+	 * Rotate the part 'x0'...'x1', 'y0'...'y1' (exclusive) of a 'w' x 'h'
+	 * source block
+	 */
+	static inline void rotate(uint32_t const *src, unsigned src_w,
+	                          uint32_t *dst, unsigned dst_w, int w, int h,
+	                          Rotation rotation, int x0, int y0, int x1, int y1)
+	{
+		for (int y = y0; y < y1; y++) {
+
+			uint32_t const *s = pixel(src, src_w, 0, y);
+
+			for (int x = x0; x < x1; x++) {
+				switch (rotation) {
+				case ROTATE_0:   *pixel(dst, dst_w, x,         y)         = s[x]; break;
+				case ROTATE_90:  *pixel(dst, dst_w, h - 1 - y, x)         = s[x]; break;
+				case ROTATE_180: *pixel(dst, dst_w, w - 1 - x, h - 1 - y) = s[x]; break;
+				case ROTATE_270: *pixel(dst, dst_w, y,         w - 1 - x) = s[x]; break;
+				}
+			}
+		}
+	}
+} }
+
+#endif /* _LIB__BLIT__BLIT_KERNELS_H_ */
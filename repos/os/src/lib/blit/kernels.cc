@@ -0,0 +1,34 @@
+/*
+ * \brief  Generic blitting kernels
+ * \author Norman Feske
+ * \date   2026-10-17
+ *
+ * Used on CPUs without a vector unit known to the blit library.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#include <blit_helper.h>
+#include <blit_kernels.h>
+
+
+static void rotate_block(Blit::uint32_t const *src, unsigned src_w,
+                         Blit::uint32_t *dst, unsigned dst_w, int w, int h,
+                         Blit::Rotation rotation)
+{
+	Blit::Scalar::rotate(src, src_w, dst, dst_w, w, h, rotation, 0, 0, w, h);
+}
+
+
+Blit::Kernels const &Blit::select_kernels()
+{
+	static Kernels const kernels { "generic", copy_block_32byte, rotate_block,
+	                               Scalar::rgb888_to_rgb565,
+	                               Scalar::rgb565_to_rgb888 };
+	return kernels;
+}
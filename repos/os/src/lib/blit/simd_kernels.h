@@ -0,0 +1,201 @@
+/*
+ * \brief  Blitting kernels based on the vector extension of the compiler
+ * \author Norman Feske
+ * \date   2026-10-17
+ *
+ * The kernels are written in terms of generic vector types, which the
+ * compiler maps to SSE2 or AVX2 on x86 and to NEON on ARMv8. The vector size
+ * is a template argument so that the same code serves 128-bit and 256-bit
+ * vector units. The 'Vector' type for 128-bit vectors is defined here, wider
+ * ones are defined by the kernels compiled for the respective CPU feature.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _LIB__BLIT__SIMD_KERNELS_H_
+#define _LIB__BLIT__SIMD_KERNELS_H_
+
+#include <blit_kernels.h>
+
+namespace Blit {
+
+	template <unsigned BYTES> struct Vector;
+	template <unsigned BYTES> struct Simd_kernels;
+}
+
+
+template <>
+struct Blit::Vector<16>
+{
+	typedef uint32_t u32 __attribute__((vector_size(16)));
+	typedef uint16_t u16 __attribute__((vector_size(16)));
+
+	/**
+	 * Return lower halves of the 32-bit lanes of 'a' and 'b'
+	 */
+	static u16 pack(u32 a, u32 b) {
+		return __builtin_shuffle((u16)a, (u16)b, u16 { 0, 2, 4, 6, 8, 10, 12, 14 }); }
+
+	/**
+	 * Zero-extend the lower and upper half of 'v' to 32-bit lanes
+	 */
+	static u32 unpack_low(u16 v) {
+		return (u32)__builtin_shuffle(v, u16 { }, u16 { 0, 8, 1, 9, 2, 10, 3, 11 }); }
+
+	static u32 unpack_high(u16 v) {
+		return (u32)__builtin_shuffle(v, u16 { }, u16 { 4, 12, 5, 13, 6, 14, 7, 15 }); }
+};
+
+
+template <unsigned BYTES>
+struct Blit::Simd_kernels
+{
+	typedef Vector<BYTES> V;
+	typedef typename V::u32 u32;
+	typedef typename V::u16 u16;
+
+	enum { LANES = BYTES/4 };
+
+	template <typename VT, typename T>
+	static VT _load(T const *p) { VT v; __builtin_memcpy(&v, p, sizeof(v)); return v; }
+
+	template <typename VT, typename T>
+	static void _store(T *p, VT v) { __builtin_memcpy(p, &v, sizeof(v)); }
+
+	static void copy_32byte(char const *src, int src_w, char *dst, int dst_w,
+	                        int w, int h)
+	{
+		for (; h-- > 0; src += src_w, dst += dst_w)
+			for (int i = 0; i < w*32; i += BYTES)
+				_store(dst + i, _load<u32>(src + i));
+	}
+
+	static void rgb888_to_rgb565(uint32_t const *src, uint16_t *dst, int n)
+	{
+		for (; n >= 2*LANES; n -= 2*LANES, src += 2*LANES, dst += 2*LANES) {
+
+			u32 a = _load<u32>(src), b = _load<u32>(src + LANES);
+
+			a = ((a >> 8) & 0xf800) | ((a >> 5) & 0x07e0) | ((a >> 3) & 0x001f);
+			b = ((b >> 8) & 0xf800) | ((b >> 5) & 0x07e0) | ((b >> 3) & 0x001f);
+
+			_store(dst, V::pack(a, b));
+		}
+		Scalar::rgb888_to_rgb565(src, dst, n);
+	}
+
+	static void rgb565_to_rgb888(uint16_t const *src, uint32_t *dst, int n)
+	{
+		for (; n >= 2*LANES; n -= 2*LANES, src += 2*LANES, dst += 2*LANES) {
+
+			u16 const v = _load<u16>(src);
+
+			u32 a = V::unpack_low(v), b = V::unpack_high(v);
+
+			a = ((a & 0xf800) << 8) | ((a & 0x07e0) << 5) | ((a & 0x001f) << 3);
+			b = ((b & 0xf800) << 8) | ((b & 0x07e0) << 5) | ((b & 0x001f) << 3);
+
+			_store(dst, a);
+			_store(dst + LANES, b);
+		}
+		Scalar::rgb565_to_rgb888(src, dst, n);
+	}
+
+	/*
+	 * The rotation works on tiles of 4x4 pixels, which are transposed in
+	 * 128-bit registers. Wider vectors do not pay off because each line of a
+	 * tile is stored to a different destination line anyway.
+	 */
+
+	typedef typename Vector<16>::u32 u32x4;
+
+	static void _transpose(u32x4 &r0, u32x4 &r1, u32x4 &r2, u32x4 &r3)
+	{
+		u32x4 const t0 = __builtin_shuffle(r0, r1, u32x4 { 0, 4, 1, 5 });
+		u32x4 const t1 = __builtin_shuffle(r0, r1, u32x4 { 2, 6, 3, 7 });
+		u32x4 const t2 = __builtin_shuffle(r2, r3, u32x4 { 0, 4, 1, 5 });
+		u32x4 const t3 = __builtin_shuffle(r2, r3, u32x4 { 2, 6, 3, 7 });
+
+		r0 = __builtin_shuffle(t0, t2, u32x4 { 0, 1, 4, 5 });
+		r1 = __builtin_shuffle(t0, t2, u32x4 { 2, 3, 6, 7 });
+		r2 = __builtin_shuffle(t1, t3, u32x4 { 0, 1, 4, 5 });
+		r3 = __builtin_shuffle(t1, t3, u32x4 { 2, 3, 6, 7 });
+	}
+
+	static void _rotate_180(uint32_t const *src, unsigned src_w,
+	                        uint32_t *dst, unsigned dst_w, int w, int h)
+	{
+		int const bw = w & ~3;
+
+		for (int y = 0; y < h; y++) {
+
+			uint32_t const *s = Scalar::pixel(src, src_w, 0, y);
+			uint32_t       *d = Scalar::pixel(dst, dst_w, w - 4, h - 1 - y);
+
+			for (int x = 0; x < bw; x += 4)
+				_store(d - x, __builtin_shuffle(_load<u32x4>(s + x),
+				                                u32x4 { 3, 2, 1, 0 }));
+		}
+		Scalar::rotate(src, src_w, dst, dst_w, w, h, ROTATE_180, bw, 0, w, h);
+	}
+
+	static void rotate(uint32_t const *src, unsigned src_w,
+	                   uint32_t *dst, unsigned dst_w, int w, int h,
+	                   Rotation rotation)
+	{
+		if (rotation == ROTATE_180) {
+			_rotate_180(src, src_w, dst, dst_w, w, h);
+			return;
+		}
+
+		/*
+		 * Walk the source in columns of 16 pixels, i.e., one cache line, so
+		 * that each source line is loaded only once.
+		 */
+		enum { COLUMN = 16 };
+
+		int const bw = w & ~3, bh = h & ~3;
+
+		for (int x0 = 0; x0 < bw; x0 += COLUMN) {
+			for (int y = 0; y < bh; y += 4) {
+				for (int x = x0; x < x0 + COLUMN && x < bw; x += 4) {
+
+					u32x4 r0 = _load<u32x4>(Scalar::pixel(src, src_w, x, y));
+					u32x4 r1 = _load<u32x4>(Scalar::pixel(src, src_w, x, y + 1));
+					u32x4 r2 = _load<u32x4>(Scalar::pixel(src, src_w, x, y + 2));
+					u32x4 r3 = _load<u32x4>(Scalar::pixel(src, src_w, x, y + 3));
+
+					if (rotation == ROTATE_90) {
+
+						/* column 'x + i' becomes line 'x + i' in reverse order */
+						_transpose(r3, r2, r1, r0);
+						_store(Scalar::pixel(dst, dst_w, h - 4 - y, x),     r3);
+						_store(Scalar::pixel(dst, dst_w, h - 4 - y, x + 1), r2);
+						_store(Scalar::pixel(dst, dst_w, h - 4 - y, x + 2), r1);
+						_store(Scalar::pixel(dst, dst_w, h - 4 - y, x + 3), r0);
+
+					} else {
+
+						/* column 'x + i' becomes line 'w - 1 - x - i' */
+						_transpose(r0, r1, r2, r3);
+						_store(Scalar::pixel(dst, dst_w, y, w - 1 - x), r0);
+						_store(Scalar::pixel(dst, dst_w, y, w - 2 - x), r1);
+						_store(Scalar::pixel(dst, dst_w, y, w - 3 - x), r2);
+						_store(Scalar::pixel(dst, dst_w, y, w - 4 - x), r3);
+					}
+				}
+			}
+		}
+
+		/* right border and bottom border */
+		Scalar::rotate(src, src_w, dst, dst_w, w, h, rotation, bw, 0, w, h);
+		Scalar::rotate(src, src_w, dst, dst_w, w, h, rotation, 0, bh, bw, h);
+	}
+};
+
+#endif /* _LIB__BLIT__SIMD_KERNELS_H_ */
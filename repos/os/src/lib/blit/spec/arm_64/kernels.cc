@@ -0,0 +1,28 @@
+/*
+ * \brief  Blitting kernels for ARMv8
+ * \author Norman Feske
+ * \date   2026-10-17
+ *
+ * NEON is an integral part of ARMv8-A. So the vector kernels are used
+ * unconditionally.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#include <simd_kernels.h>
+
+
+Blit::Kernels const &Blit::select_kernels()
+{
+	typedef Simd_kernels<16> Neon;
+
+	static Kernels const kernels { "neon", Neon::copy_32byte, Neon::rotate,
+	                               Neon::rgb888_to_rgb565,
+	                               Neon::rgb565_to_rgb888 };
+	return kernels;
+}
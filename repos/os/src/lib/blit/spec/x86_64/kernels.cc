@@ -0,0 +1,115 @@
+/*
+ * \brief  Blitting kernels for x86_64
+ * \author Norman Feske
+ * \date   2026-10-17
+ *
+ * SSE2 is part of the x86_64 base architecture. The AVX2 kernels are used
+ * if supported by the CPU and if the kernel has enabled the saving of the
+ * AVX register state.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#include <simd_kernels.h>
+
+namespace Blit { namespace Avx2 {
+
+	/* implemented in 'kernels_avx2.cc' */
+	void copy_32byte(char const *, int, char *, int, int, int);
+	void rgb888_to_rgb565(uint32_t const *, uint16_t *, int);
+	void rgb565_to_rgb888(uint16_t const *, uint32_t *, int);
+} }
+
+
+/**
+ * Copy block using non-temporal stores
+ *
+ * The destination is usually a frame buffer, which is not read back. The
+ * non-temporal stores keep it from evicting the source from the cache.
+ */
+static void copy_32byte(char const *src, int src_w, char *dst, int dst_w,
+                        int w, int h)
+{
+	typedef long long v2di __attribute__((vector_size(16)));
+
+	for (; h-- > 0; src += src_w, dst += dst_w) {
+
+		char const *s = src;
+		char       *d = dst;
+		long        n = 32L*w;
+
+		/* align the 32bit-aligned destination to 16 bytes */
+		for (; ((Genode::addr_t)d & 15) && n; n -= 4, s += 4, d += 4)
+			__builtin_memcpy(d, s, 4);
+
+		for (; n >= 64; n -= 64, s += 64, d += 64) {
+			v2di v0, v1, v2, v3;
+			__builtin_memcpy(&v0, s,      16);
+			__builtin_memcpy(&v1, s + 16, 16);
+			__builtin_memcpy(&v2, s + 32, 16);
+			__builtin_memcpy(&v3, s + 48, 16);
+			__builtin_ia32_movntdq((v2di *)d,        v0);
+			__builtin_ia32_movntdq((v2di *)(d + 16), v1);
+			__builtin_ia32_movntdq((v2di *)(d + 32), v2);
+			__builtin_ia32_movntdq((v2di *)(d + 48), v3);
+		}
+
+		for (; n; n -= 4, s += 4, d += 4)
+			__builtin_memcpy(d, s, 4);
+	}
+	__builtin_ia32_sfence();
+}
+
+
+static bool avx2_usable()
+{
+	auto cpuid = [] (unsigned leaf, unsigned &a, unsigned &b, unsigned &c) {
+		unsigned d = 0;
+		asm volatile ("cpuid" : "=a" (a), "=b" (b), "=c" (c), "=d" (d)
+		                      : "a" (leaf), "c" (0));
+	};
+
+	unsigned a = 0, b = 0, c = 0;
+
+	cpuid(0, a, b, c);
+	if (a < 7)
+		return false;
+
+	enum { OSXSAVE = 1 << 27, AVX = 1 << 28 };
+
+	cpuid(1, a, b, c);
+	if ((c & (OSXSAVE | AVX)) != (OSXSAVE | AVX))
+		return false;
+
+	/* the SSE and AVX state must be enabled in XCR0 */
+	unsigned xcr0 = 0, xcr0_high = 0;
+	asm volatile ("xgetbv" : "=a" (xcr0), "=d" (xcr0_high) : "c" (0));
+	if ((xcr0 & 6) != 6)
+		return false;
+
+	enum { AVX2 = 1 << 5 };
+
+	cpuid(7, a, b, c);
+	return b & AVX2;
+}
+
+
+Blit::Kernels const &Blit::select_kernels()
+{
+	typedef Simd_kernels<16> Sse2;
+
+	static Kernels const sse2 { "sse2", copy_32byte, Sse2::rotate,
+	                            Sse2::rgb888_to_rgb565,
+	                            Sse2::rgb565_to_rgb888 };
+
+	static Kernels const avx2 { "avx2", Avx2::copy_32byte, Sse2::rotate,
+	                            Avx2::rgb888_to_rgb565,
+	                            Avx2::rgb565_to_rgb888 };
+
+	return avx2_usable() ? avx2 : sse2;
+}
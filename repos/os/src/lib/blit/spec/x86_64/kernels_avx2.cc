@@ -0,0 +1,102 @@
+/*
+ * \brief  Blitting kernels for x86_64 CPUs with AVX2
+ * \author Norman Feske
+ * \date   2026-10-17
+ *
+ * This file is compiled with '-mavx2'. Hence, it must not instantiate any
+ * template or inline function that is used by code executed on CPUs
+ * without AVX2. The linker might otherwise pick the AVX2 variant.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#include <simd_kernels.h>
+
+
+template <>
+struct Blit::Vector<32>
+{
+	typedef uint32_t u32 __attribute__((vector_size(32)));
+	typedef uint16_t u16 __attribute__((vector_size(32)));
+
+	static u16 pack(u32 a, u32 b) {
+		return __builtin_shuffle((u16)a, (u16)b,
+		                         u16 {  0,  2,  4,  6,  8, 10, 12, 14,
+		                               16, 18, 20, 22, 24, 26, 28, 30 }); }
+
+	static u32 unpack_low(u16 v) {
+		return (u32)__builtin_shuffle(v, u16 { },
+		                              u16 { 0, 16, 1, 17, 2, 18, 3, 19,
+		                                    4, 20, 5, 21, 6, 22, 7, 23 }); }
+
+	static u32 unpack_high(u16 v) {
+		return (u32)__builtin_shuffle(v, u16 { },
+		                              u16 {  8, 24,  9, 25, 10, 26, 11, 27,
+		                                    12, 28, 13, 29, 14, 30, 15, 31 }); }
+};
+
+
+namespace Blit { namespace Avx2 {
+
+	typedef Simd_kernels<32> Kernels;
+
+	void copy_32byte(char const *, int, char *, int, int, int);
+	void rgb888_to_rgb565(uint32_t const *, uint16_t *, int);
+	void rgb565_to_rgb888(uint16_t const *, uint32_t *, int);
+} }
+
+
+/**
+ * Copy block using non-temporal stores
+ */
+void Blit::Avx2::copy_32byte(char const *src, int src_w, char *dst, int dst_w,
+                             int w, int h)
+{
+	typedef long long v4di __attribute__((vector_size(32)));
+
+	for (; h-- > 0; src += src_w, dst += dst_w) {
+
+		char const *s = src;
+		char       *d = dst;
+		long        n = 32L*w;
+
+		/* align the 32bit-aligned destination to 32 bytes */
+		for (; ((Genode::addr_t)d & 31) && n; n -= 4, s += 4, d += 4)
+			__builtin_memcpy(d, s, 4);
+
+		for (; n >= 128; n -= 128, s += 128, d += 128) {
+			v4di v0, v1, v2, v3;
+			__builtin_memcpy(&v0, s,      32);
+			__builtin_memcpy(&v1, s + 32, 32);
+			__builtin_memcpy(&v2, s + 64, 32);
+			__builtin_memcpy(&v3, s + 96, 32);
+			__builtin_ia32_movntdq256((v4di *)d,        v0);
+			__builtin_ia32_movntdq256((v4di *)(d + 32), v1);
+			__builtin_ia32_movntdq256((v4di *)(d + 64), v2);
+			__builtin_ia32_movntdq256((v4di *)(d + 96), v3);
+		}
+
+		for (; n >= 32; n -= 32, s += 32, d += 32) {
+			v4di v;
+			__builtin_memcpy(&v, s, 32);
+			__builtin_ia32_movntdq256((v4di *)d, v);
+		}
+
+		for (; n; n -= 4, s += 4, d += 4)
+			__builtin_memcpy(d, s, 4);
+	}
+	__builtin_ia32_sfence();
+}
+
+
+void Blit::Avx2::rgb888_to_rgb565(uint32_t const *src, uint16_t *dst, int n) {
+	Kernels::rgb888_to_rgb565(src, dst, n); }
+
+
+void Blit::Avx2::rgb565_to_rgb888(uint16_t const *src, uint32_t *dst, int n) {
+	Kernels::rgb565_to_rgb888(src, dst, n); }
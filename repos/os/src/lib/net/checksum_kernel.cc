@@ -0,0 +1,33 @@
+/*
+ * \brief  Internet Checksum kernel using the CPU features enabled by default
+ * \author Martin Stein
+ * \date   2026-10-17
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* local includes */
+#include <checksum_kernel.h>
+
+using namespace Genode;
+
+
+#if defined(__SSE2__) || defined(__ARM_NEON)
+
+Net::Checksum_kernel Net::select_checksum_kernel() {
+	return add_up_vectors<Vector_16>; }
+
+#else
+
+static uint64_t add_up_nothing(uint8_t const *&, size_t &, uint64_t sum) {
+	return sum; }
+
+Net::Checksum_kernel Net::select_checksum_kernel() {
+	return add_up_nothing; }
+
+#endif /* __SSE2__ || __ARM_NEON */
@@ -0,0 +1,92 @@
+/*
+ * \brief  Interface between the Internet Checksum and CPU-specific kernels
+ * \author Martin Stein
+ * \date   2026-10-17
+ *
+ * The bulk of the data is added up in vector registers. Each 32-bit lane of
+ * a vector accumulates the lower and the upper 16-bit words of the loaded
+ * 32-bit words separately. This way, a lane cannot overflow within 2^15
+ * rounds of two vectors each, after which the lanes are flushed into the
+ * scalar sum. The vectors are declared via the generic vector extension of
+ * the compiler, which translates them to the vector instructions enabled
+ * for the compilation unit, e.g., SSE2 or AVX2 on x86 and NEON on ARM.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _LIB__NET__CHECKSUM_KERNEL_H_
+#define _LIB__NET__CHECKSUM_KERNEL_H_
+
+/* Genode includes */
+#include <base/stdint.h>
+
+namespace Net {
+
+	/**
+	 * Add up the bulk of the data in 32-bit words
+	 *
+	 * The function advances 'data' and decreases 'size' by the amount of
+	 * data added up and returns the new sum. The remainder is left to the
+	 * caller.
+	 */
+	typedef Genode::uint64_t (*Checksum_kernel)(Genode::uint8_t const *&data,
+	                                            Genode::size_t         &size,
+	                                            Genode::uint64_t        sum);
+
+	/**
+	 * Return kernel best suited for the CPU
+	 *
+	 * Implemented once per CPU architecture. The function is called once
+	 * on the first checksum calculation.
+	 */
+	Checksum_kernel select_checksum_kernel();
+
+	typedef Genode::uint32_t Vector_16 __attribute__((vector_size(16)));
+	typedef Genode::uint32_t Vector_32 __attribute__((vector_size(32)));
+
+	/*
+	 * The template has internal linkage, so that an instance compiled for
+	 * an optional CPU feature cannot replace the instance of the same
+	 * vector type used by default.
+	 */
+	template <typename VECTOR>
+	static Genode::uint64_t add_up_vectors(Genode::uint8_t const *&data,
+	                                       Genode::size_t         &size,
+	                                       Genode::uint64_t        sum)
+	{
+		using namespace Genode;
+
+		typedef VECTOR Vector;
+
+		enum { VECTOR_SIZE = sizeof(Vector) };
+		enum { LANES = VECTOR_SIZE / sizeof(uint32_t), MAX_ROUNDS = 1 << 15 };
+
+		while (size >= 2*VECTOR_SIZE) {
+
+			Vector lo { };
+			Vector hi { };
+			for (unsigned rounds = 0;
+			     size >= 2*VECTOR_SIZE && rounds < MAX_ROUNDS;
+			     rounds++, data += 2*VECTOR_SIZE, size -= 2*VECTOR_SIZE)
+			{
+				/* the data is not necessarily aligned to the vector size */
+				Vector a, b;
+				__builtin_memcpy(&a, data, VECTOR_SIZE);
+				__builtin_memcpy(&b, data + VECTOR_SIZE, VECTOR_SIZE);
+
+				lo += (a & 0xffff) + (b & 0xffff);
+				hi += (a >> 16)    + (b >> 16);
+			}
+			for (unsigned i = 0; i < LANES; i++)
+				sum += (uint64_t)lo[i] + hi[i];
+		}
+		return sum;
+	}
+}
+
+#endif /* _LIB__NET__CHECKSUM_KERNEL_H_ */
@@ -34,6 +34,21 @@ void Icmp_packet::update_checksum(size_t data_sz)
 }
 
 
+void Icmp_packet::update_checksum(Internet_checksum_diff const &icd)
+{
+	_checksum = icd.apply_to(_checksum);
+}
+
+
+void Icmp_packet::query_id(uint16_t v, Internet_checksum_diff &icd)
+{
+	uint16_t const v_be   = host_to_big_endian(v);
+	uint16_t const old_be = _rest_of_header_u16[0];
+	icd.add_up_diff(&v_be, &old_be, 2);
+	_rest_of_header_u16[0] = v_be;
+}
+
+
 bool Icmp_packet::checksum_error(size_t data_sz) const
 {
 	return internet_checksum((uint16_t *)this, sizeof(Icmp_packet) + data_sz);
@@ -1,5 +1,5 @@
 /*
- * \brief  Computing the Internet Checksum (conforms to RFC 1071)
+ * \brief  Computing the Internet Checksum (conforms to RFC 1071 and RFC 1624)
  * \author Martin Stein
  * \date   2018-03-23
  */
@@ -14,16 +14,43 @@
 /* Genode includes */
 #include <net/internet_checksum.h>
 
+/* local includes */
+#include <checksum_kernel.h>
+
 using namespace Net;
 using namespace Genode;
 
 
+static uint16_t _fold(uint64_t sum)
+{
+	while (uint64_t const sum_rsh = sum >> 16)
+		sum = (sum & 0xffff) + sum_rsh;
+
+	return (uint16_t)sum;
+}
+
+
+/*
+ * The kernel is selected once on the first use because the selection may
+ * query the CPU features at runtime.
+ */
+static Checksum_kernel _checksum_kernel()
+{
+	static Checksum_kernel const kernel = select_checksum_kernel();
+	return kernel;
+}
+
+
 uint16_t Net::internet_checksum(uint16_t const *addr,
                                 size_t          size,
                                 addr_t          init_sum)
 {
-	/* add up bytes in pairs */
-	addr_t sum = init_sum;
+	/* add up the bulk of the data with the vector unit if available */
+	uint8_t const *data = (uint8_t const *)addr;
+	uint64_t sum = _checksum_kernel()(data, size, init_sum);
+	addr = (uint16_t const *)data;
+
+	/* add up remaining bytes in pairs */
 	for (; size > 1; size -= 2)
 		sum += *addr++;
 
@@ -31,12 +58,8 @@ uint16_t Net::internet_checksum(uint16_t const *addr,
 	if (size > 0)
 		sum += *(uint8_t *)addr;
 
-	/* fold sum to 16-bit value */
-	while (addr_t const sum_rsh = sum >> 16)
-		sum = (sum & 0xffff) + sum_rsh;
-
-	/* return one's complement */
-	return ~sum;
+	/* fold sum to 16-bit value and return one's complement */
+	return (uint16_t)~_fold(sum);
 }
 
 
@@ -62,3 +85,32 @@ uint16_t Net::internet_checksum_pseudo_ip(uint16_t        const *ip_data,
 	/* add up IP data bytes */
 	return internet_checksum(ip_data, ip_data_sz, sum);
 }
+
+
+/****************************
+ ** Internet_checksum_diff **
+ ****************************/
+
+void Internet_checksum_diff::add_up_diff(void const *new_data,
+                                         void const *old_data,
+                                         size_t      size)
+{
+	uint16_t const *new_word = (uint16_t const *)new_data;
+	uint16_t const *old_word = (uint16_t const *)old_data;
+
+	/* a modified word adds up as its new value plus the complement of the old */
+	for (; size > 1; size -= 2)
+		_value += (uint16_t)~*old_word++ + (uint64_t)*new_word++;
+
+	/* handle left-over byte like 'internet_checksum' does */
+	if (size > 0)
+		_value += (uint16_t)~*(uint8_t const *)old_word
+		        + (uint64_t)*(uint8_t const *)new_word;
+}
+
+
+uint16_t Internet_checksum_diff::apply_to(uint16_t checksum) const
+{
+	/* RFC 1624, eqn. 3: HC' = ~(~HC + ~m + m') */
+	return (uint16_t)~_fold((uint16_t)~checksum + _value);
+}
@@ -0,0 +1,65 @@
+/*
+ * \brief  Internet Checksum kernels for x86_64
+ * \author Martin Stein
+ * \date   2026-10-17
+ *
+ * SSE2 is part of the x86_64 base architecture. The AVX2 kernel is used if
+ * supported by the CPU and if the kernel has enabled the saving of the AVX
+ * register state.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* local includes */
+#include <checksum_kernel.h>
+
+namespace Net { namespace Avx2 {
+
+	/* implemented in 'checksum_kernel_avx2.cc' */
+	Genode::uint64_t add_up_vectors(Genode::uint8_t const *&,
+	                                Genode::size_t &, Genode::uint64_t);
+} }
+
+
+static bool avx2_usable()
+{
+	auto cpuid = [] (unsigned leaf, unsigned &a, unsigned &b, unsigned &c) {
+		unsigned d = 0;
+		asm volatile ("cpuid" : "=a" (a), "=b" (b), "=c" (c), "=d" (d)
+		                      : "a" (leaf), "c" (0));
+	};
+
+	unsigned a = 0, b = 0, c = 0;
+
+	cpuid(0, a, b, c);
+	if (a < 7)
+		return false;
+
+	enum { OSXSAVE = 1 << 27, AVX = 1 << 28 };
+
+	cpuid(1, a, b, c);
+	if ((c & (OSXSAVE | AVX)) != (OSXSAVE | AVX))
+		return false;
+
+	/* the SSE and AVX state must be enabled in XCR0 */
+	unsigned xcr0 = 0, xcr0_high = 0;
+	asm volatile ("xgetbv" : "=a" (xcr0), "=d" (xcr0_high) : "c" (0));
+	if ((xcr0 & 6) != 6)
+		return false;
+
+	enum { AVX2 = 1 << 5 };
+
+	cpuid(7, a, b, c);
+	return b & AVX2;
+}
+
+
+Net::Checksum_kernel Net::select_checksum_kernel()
+{
+	return avx2_usable() ? Avx2::add_up_vectors : add_up_vectors<Vector_16>;
+}
@@ -0,0 +1,28 @@
+/*
+ * \brief  Internet Checksum kernel using AVX2
+ * \author Martin Stein
+ * \date   2026-10-17
+ *
+ * This file is compiled with '-mavx2'. It must only be called if the CPU
+ * supports AVX2.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* local includes */
+#include <checksum_kernel.h>
+
+namespace Net { namespace Avx2 {
+
+	Genode::uint64_t add_up_vectors(Genode::uint8_t const *&data,
+	                                Genode::size_t         &size,
+	                                Genode::uint64_t        sum)
+	{
+		return Net::add_up_vectors<Vector_32>(data, size, sum);
+	}
+} }
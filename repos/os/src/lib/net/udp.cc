@@ -41,6 +41,36 @@ void Net::Udp_packet::update_checksum(Ipv4_address ip_src,
 }
 
 
+void Net::Udp_packet::update_checksum(Internet_checksum_diff const &icd)
+{
+	if (!_checksum) {
+		return; }
+
+	/* a calculated checksum of zero is transmitted as all ones */
+	_checksum = icd.apply_to(_checksum);
+	if (!_checksum) {
+		_checksum = 0xffff; }
+}
+
+
+void Net::Udp_packet::src_port(Port p, Internet_checksum_diff &icd)
+{
+	uint16_t const p_be = host_to_big_endian(p.value);
+	uint16_t const old_be = _src_port;
+	icd.add_up_diff(&p_be, &old_be, 2);
+	_src_port = p_be;
+}
+
+
+void Net::Udp_packet::dst_port(Port p, Internet_checksum_diff &icd)
+{
+	uint16_t const p_be = host_to_big_endian(p.value);
+	uint16_t const old_be = _dst_port;
+	icd.add_up_diff(&p_be, &old_be, 2);
+	_dst_port = p_be;
+}
+
+
 bool Net::Udp_packet::checksum_error(Ipv4_address ip_src,
                                      Ipv4_address ip_dst) const
 {
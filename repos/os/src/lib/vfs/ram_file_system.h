@@ -14,11 +14,12 @@
 #ifndef _INCLUDE__VFS__RAM_FILE_SYSTEM_H_
 #define _INCLUDE__VFS__RAM_FILE_SYSTEM_H_
 
-#include <ram_fs/chunk.h>
-#include <ram_fs/param.h>
 #include <vfs/file_system.h>
 #include <dataspace/client.h>
+#include <region_map/client.h>
+#include <rm_session/connection.h>
 #include <util/avl_tree.h>
+#include <util/reconstructible.h>
 
 namespace Vfs { class Ram_file_system; }
 
@@ -26,13 +27,14 @@ namespace Vfs_ram {
 
 	using namespace Genode;
 	using namespace Vfs;
-	using namespace Ram_fs;
-	using File_system::Chunk;
-	using File_system::Chunk_index;
 
 	struct Io_handle;
 	struct Watch_handle;
 
+	class Extent;
+	class Extent_tree;
+	class View;
+	class Backing_store;
 	class Node;
 	class File;
 	class Symlink;
@@ -252,54 +254,436 @@ class Vfs_ram::Node : private Genode::Avl_node<Node>, private Genode::Lock
 };
 
 
+/**
+ * Contiguous run of file data
+ *
+ * Small extents are allocated from the heap of the file system. Larger
+ * extents are backed by a RAM dataspace of their own, which can be handed
+ * out as read-only view of the file content without copying.
+ */
+class Vfs_ram::Extent : private Genode::Avl_node<Extent>
+{
+	private:
+
+		friend class Genode::Avl_node<Extent>;
+		friend class Genode::Avl_tree<Extent>;
+		friend class Extent_tree;
+		friend class Backing_store;
+		friend class File;
+
+		/*
+		 * Noncopyable
+		 */
+		Extent(Extent const &);
+		Extent &operator = (Extent const &);
+
+		Ram_dataspace_capability const _ds;
+
+		unsigned _views    { 0 };      /* dataspace views handed out */
+		bool     _orphaned { false };  /* no longer part of a file */
+
+	public:
+
+		file_size const offset;
+		size_t    const size;
+		char    * const data;
+
+		Extent(file_size offset, size_t size, char *data,
+		       Ram_dataspace_capability ds)
+		: _ds(ds), offset(offset), size(size), data(data) { }
+
+		file_size end()   const { return offset + size; }
+		bool      heap()  const { return !_ds.valid(); }
+		bool      viewed() const { return _views > 0; }
+
+		bool contains(file_size pos) const {
+			return pos >= offset && pos < end(); }
+
+		/************************
+		 ** Avl node interface **
+		 ************************/
+
+		bool higher(Extent *e) { return e->offset > offset; }
+};
+
+
+/**
+ * Extents of a file ordered by their offset
+ */
+class Vfs_ram::Extent_tree : public Genode::Avl_tree<Extent>
+{
+	public:
+
+		/**
+		 * Return extent with the highest offset not above 'pos'
+		 */
+		Extent *floor(file_size pos) const
+		{
+			Extent *result = nullptr;
+			for (Extent *e = first(); e; ) {
+				bool const right = e->offset <= pos;
+				if (right) result = e;
+				e = e->child(right);
+			}
+			return result;
+		}
+
+		/**
+		 * Return extent with the lowest offset not below 'pos'
+		 */
+		Extent *ceiling(file_size pos) const
+		{
+			Extent *result = nullptr;
+			for (Extent *e = first(); e; ) {
+				bool const right = e->offset < pos;
+				if (!right) result = e;
+				e = e->child(right);
+			}
+			return result;
+		}
+
+		/**
+		 * Return extent that contains 'pos'
+		 */
+		Extent *at(file_size pos) const
+		{
+			Extent *e = floor(pos);
+			return e && e->contains(pos) ? e : nullptr;
+		}
+
+		/**
+		 * Return true if the tree consists of a single extent
+		 */
+		bool single() const
+		{
+			Extent *e = first();
+			return e && !e->child(Extent::LEFT) && !e->child(Extent::RIGHT);
+		}
+};
+
+
+/**
+ * Read-only dataspace of an extent handed out as view
+ *
+ * The RAM dataspace of the extent is attached read-only to a region map of
+ * its own. The managed dataspace of this region map is handed out, so a
+ * client that attaches the view cannot modify the file content.
+ */
+class Vfs_ram::View : public Genode::Avl_node<View>
+{
+	public:
+
+		Extent                       &extent;
+		Capability<Region_map> const  map;
+		Dataspace_capability   const  ds;
+
+		View(Extent &extent, Capability<Region_map> map)
+		:
+			extent(extent), map(map), ds(Region_map_client(map).dataspace())
+		{ }
+
+		long key() const { return ds.local_name(); }
+
+		View *find(long key)
+		{
+			if (key == this->key()) return this;
+
+			View *v = child(key > this->key());
+			return v ? v->find(key) : nullptr;
+		}
+
+		/************************
+		 ** Avl node interface **
+		 ************************/
+
+		bool higher(View *v) { return v->key() > key(); }
+};
+
+
+/**
+ * Allocator of extents shared by all files of a file system
+ *
+ * Extents with dataspace views outlive the file data they belong to. When a
+ * file modifies or drops such an extent, the extent is orphaned and freed
+ * with the release of its last view.
+ */
+class Vfs_ram::Backing_store
+{
+	public:
+
+		/*
+		 * Extents below this size are allocated from the heap. Each larger
+		 * extent uses a RAM dataspace and thereby a capability.
+		 */
+		enum { MIN_EXTENT      = 256,
+		       MAX_HEAP_EXTENT = 64*1024,
+		       MAX_EXTENT      = 32*1024*1024 };
+
+	private:
+
+		Genode::Env                  &_env;
+		Allocator                    &_alloc;
+		Genode::Lock                  _lock  { };
+		Genode::Avl_tree<View>        _views { };
+
+		/* session for the region maps of views, opened on first use */
+		Constructible<Rm_connection>  _rm_connection { };
+
+		void _free(Extent &e)
+		{
+			if (e.heap()) {
+				_alloc.free(e.data, e.size);
+			} else {
+				_env.rm().detach(e.data);
+				_env.ram().free(e._ds);
+			}
+			destroy(_alloc, &e);
+		}
+
+	public:
+
+		Backing_store(Genode::Env &env, Allocator &alloc)
+		: _env(env), _alloc(alloc) { }
+
+		Allocator &alloc() { return _alloc; }
+
+		/**
+		 * Allocate zero-initialized extent
+		 *
+		 * \param dataspace  back extent by a dataspace regardless of its size
+		 *
+		 * \throw Out_of_memory
+		 * \throw Out_of_ram
+		 * \throw Out_of_caps
+		 */
+		Extent &alloc(file_size offset, size_t size, bool dataspace = false)
+		{
+			if (!dataspace && size < MAX_HEAP_EXTENT) {
+				char *data = (char *)_alloc.alloc(size);
+				memset(data, 0, size);
+				try { return *new (_alloc) Extent(offset, size, data,
+				                                  Ram_dataspace_capability()); }
+				catch (...) { _alloc.free(data, size); throw; }
+			}
+
+			Ram_dataspace_capability ds = _env.ram().alloc(size);
+			char *data = nullptr;
+			try {
+				data = _env.rm().attach(ds);
+				return *new (_alloc) Extent(offset, size, data, ds);
+			}
+			catch (...) {
+				if (data) _env.rm().detach(data);
+				_env.ram().free(ds);
+				throw;
+			}
+		}
+
+		/**
+		 * Free extent that was removed from its file
+		 */
+		void retire(Extent &e)
+		{
+			Genode::Lock::Guard guard(_lock);
+
+			if (e.viewed())
+				e._orphaned = true;
+			else
+				_free(e);
+		}
+
+		/**
+		 * Hand out read-only view of dataspace-backed extent
+		 *
+		 * \throw Out_of_ram
+		 * \throw Out_of_caps
+		 * \throw Region_map::Region_conflict
+		 */
+		Dataspace_capability view(Extent &e)
+		{
+			Genode::Lock::Guard guard(_lock);
+
+			if (!_rm_connection.constructed())
+				_rm_connection.construct(_env);
+
+			Capability<Region_map> map =
+				_rm_connection->create(align_addr(e.size, 12));
+			try {
+				Region_map_client(map).attach(e._ds, 0, 0, true, (addr_t)0,
+				                              false, false);
+
+				View &view = *new (_alloc) View(e, map);
+				_views.insert(&view);
+				e._views++;
+				return view.ds;
+			}
+			catch (...) {
+				_rm_connection->destroy(map);
+				throw;
+			}
+		}
+
+		/**
+		 * Release view handed out by 'view'
+		 *
+		 * \return  false if 'ds' is not a view
+		 */
+		bool release(Dataspace_capability ds)
+		{
+			Genode::Lock::Guard guard(_lock);
+
+			View *view = _views.first() ? _views.first()->find(ds.local_name())
+			                            : nullptr;
+			if (!view)
+				return false;
+
+			Extent &e = view->extent;
+
+			_views.remove(view);
+			_rm_connection->destroy(view->map);
+			destroy(_alloc, view);
+
+			if (--e._views == 0 && e._orphaned)
+				_free(e);
+
+			return true;
+		}
+
+		bool viewed(Extent const &e)
+		{
+			Genode::Lock::Guard guard(_lock);
+			return e.viewed();
+		}
+};
+
+
 class Vfs_ram::File : public Vfs_ram::Node
 {
 	private:
 
-		typedef Chunk      <num_level_3_entries()>                Chunk_level_3;
-		typedef Chunk_index<num_level_2_entries(), Chunk_level_3> Chunk_level_2;
-		typedef Chunk_index<num_level_1_entries(), Chunk_level_2> Chunk_level_1;
-		typedef Chunk_index<num_level_0_entries(), Chunk_level_1> Chunk_level_0;
+		Backing_store &_store;
+		Extent_tree    _extents { };
+		file_size      _length = 0;
+
+		void _replace(Extent &old_extent, Extent &new_extent)
+		{
+			_extents.remove(&old_extent);
+			_extents.insert(&new_extent);
+			_store.retire(old_extent);
+		}
+
+		/**
+		 * Return extent for modification
+		 *
+		 * An extent with dataspace views is copied before modifying it so
+		 * that the views keep showing the content at the time they were
+		 * handed out.
+		 */
+		Extent &_writeable(Extent &e)
+		{
+			if (!_store.viewed(e))
+				return e;
+
+			Extent &copy = _store.alloc(e.offset, e.size);
+			memcpy(copy.data, e.data, e.size);
+			_replace(e, copy);
+			return copy;
+		}
+
+		/**
+		 * Create extent for writing 'len' bytes at 'pos'
+		 *
+		 * When appending to an extent, the new extent doubles the size of
+		 * the previous one, so that sequentially written files end up in a
+		 * small number of large extents. Small extents are grown by copying
+		 * instead to keep small files contiguous.
+		 */
+		Extent &_new_extent(file_size pos, size_t len)
+		{
+			enum { MIN_EXTENT      = Backing_store::MIN_EXTENT,
+			       MAX_HEAP_EXTENT = Backing_store::MAX_HEAP_EXTENT,
+			       MAX_EXTENT      = Backing_store::MAX_EXTENT };
+
+			Extent *prev = _extents.floor(pos);
+			Extent *next = _extents.ceiling(pos);
+
+			bool const append = prev && prev->end() == pos;
 
-		Chunk_level_0 _chunk;
-		file_size     _length = 0;
+			if (append && prev->heap() && !_store.viewed(*prev)) {
+
+				size_t const size = max(2*prev->size, prev->size + len);
+				if (size < MAX_HEAP_EXTENT
+				 && (!next || prev->offset + size <= next->offset)) {
+
+					Extent &grown = _store.alloc(prev->offset, size);
+					memcpy(grown.data, prev->data, prev->size);
+					_replace(*prev, grown);
+					return grown;
+				}
+			}
+
+			size_t size = max(len, (size_t)MIN_EXTENT);
+			if (append)
+				size = max(size, 2*prev->size);
+
+			size = min(size, (size_t)MAX_EXTENT);
+
+			/* use the whole last page of a dataspace-backed extent */
+			if (size >= MAX_HEAP_EXTENT)
+				size = align_addr(size, 12);
+
+			if (next)
+				size = (size_t)min((file_size)size, next->offset - pos);
+
+			Extent &e = _store.alloc(pos, size);
+			_extents.insert(&e);
+			return e;
+		}
+
+		void _remove_extents_from(file_size pos)
+		{
+			while (Extent *e = _extents.ceiling(pos)) {
+				_extents.remove(e);
+				_store.retire(*e);
+			}
+		}
 
 	public:
 
-		File(char const *name, Allocator &alloc)
-		: Node(name), _chunk(alloc, 0) { }
+		File(char const *name, Backing_store &store)
+		: Node(name), _store(store) { }
+
+		~File() { _remove_extents_from(0); }
 
 		size_t read(char *dst, size_t len, file_size seek_offset) override
 		{
-			file_size const chunk_used_size = _chunk.used_size();
-
 			if (seek_offset >= _length)
 				return 0;
 
-			/*
-			 * Constrain read transaction to available chunk data
-			 *
-			 * Note that 'chunk_used_size' may be lower than '_length'
-			 * because 'Chunk' may have truncated tailing zeros.
-			 */
+			/* constrain read transaction to the file length */
 			if (seek_offset + len >= _length)
 				len = _length - seek_offset;
 
-			file_size read_len = len;
-
-			if (seek_offset + read_len > chunk_used_size) {
-				if (chunk_used_size >= seek_offset)
-					read_len = chunk_used_size - seek_offset;
-				else
-					read_len = 0;
-			}
+			for (size_t done = 0; done < len; ) {
 
-			_chunk.read(dst, read_len, seek_offset);
+				file_size const pos = seek_offset + done;
 
-			/* add zero padding if needed */
-			if (read_len < len)
-				memset(dst + read_len, 0, len - read_len);
+				if (Extent *e = _extents.at(pos)) {
+					size_t const n = (size_t)min((file_size)(len - done),
+					                             e->end() - pos);
+					memcpy(dst + done, e->data + (pos - e->offset), n);
+					done += n;
+					continue;
+				}
 
+				/* fill hole with zeros */
+				Extent *next = _extents.ceiling(pos);
+				size_t const n = next ? (size_t)min((file_size)(len - done),
+				                                    next->offset - pos)
+				                      : len - done;
+				memset(dst + done, 0, n);
+				done += n;
+			}
 			return len;
 		}
 
@@ -315,33 +699,80 @@ class Vfs_ram::File : public Vfs_ram::Node
 		size_t write(char const *src, size_t len, file_size seek_offset) override
 		{
 			if (seek_offset == (file_size)(~0))
-				seek_offset = _chunk.used_size();
+				seek_offset = _length;
 
-			if (seek_offset + len >= Chunk_level_0::SIZE)
-				len = Chunk_level_0::SIZE - (seek_offset + len);
+			size_t done = 0;
+			try {
+				while (done < len) {
 
-			try { _chunk.write(src, len, (size_t)seek_offset); }
-			catch (Out_of_memory) { return 0; }
+					file_size const pos = seek_offset + done;
 
-			/*
-			 * Keep track of file length. We cannot use 'chunk.used_size()'
-			 * as file length because trailing zeros may by represented
-			 * by zero chunks, which do not contribute to 'used_size()'.
-			 */
-			_length = max(_length, seek_offset + len);
+					Extent *e = _extents.at(pos);
+					Extent &extent = e ? _writeable(*e)
+					                   : _new_extent(pos, len - done);
 
-			return len;
+					size_t const n = (size_t)min((file_size)(len - done),
+					                             extent.end() - pos);
+					memcpy(extent.data + (pos - extent.offset), src + done, n);
+					done += n;
+				}
+			}
+			catch (Out_of_memory)       { }
+			catch (Genode::Out_of_caps) { }
+
+			_length = max(_length, seek_offset + done);
+
+			return done;
 		}
 
 		file_size length() override { return _length; }
 
 		void truncate(file_size size) override
 		{
-			if (size < _chunk.used_size())
-				_chunk.truncate(size);
+			/*
+			 * Data beyond the file length is kept zeroed so that the file
+			 * reads as zeros when extended later on.
+			 */
+			if (size < _length) {
+				_remove_extents_from(size);
 
+				if (Extent *e = _extents.at(size)) {
+					Extent &extent = _writeable(*e);
+					file_size const local = size - extent.offset;
+					memset(extent.data + local, 0, (size_t)(extent.size - local));
+				}
+			}
 			_length = size;
 		}
+
+		/**
+		 * Return read-only view of the file content
+		 *
+		 * If the file content is not yet located in a single dataspace, it
+		 * is moved into one first. Modifications of the file after handing
+		 * out the view are not visible through the view.
+		 *
+		 * \throw Out_of_ram
+		 * \throw Out_of_caps
+		 * \throw Region_map::Region_conflict
+		 */
+		Dataspace_capability view()
+		{
+			if (!_length)
+				return Dataspace_capability();
+
+			Extent *e = _extents.first();
+			bool const contiguous = _extents.single() && e->offset == 0
+			                     && !e->heap() && e->size >= _length;
+			if (!contiguous) {
+				Extent &compact = _store.alloc(0, (size_t)_length, true);
+				read(compact.data, (size_t)_length, 0);
+				_remove_extents_from(0);
+				_extents.insert(&compact);
+				e = &compact;
+			}
+			return _store.view(*e);
+		}
 };
 
 
@@ -504,8 +935,9 @@ class Vfs::Ram_file_system : public Vfs::File_system
 
 		friend class Genode::List<Vfs_ram::Watch_handle>;
 
-		Vfs::Env           &_env;
-		Vfs_ram::Directory  _root = { "" };
+		Vfs::Env               &_env;
+		Vfs_ram::Backing_store  _store { _env.env(), _env.alloc() };
+		Vfs_ram::Directory      _root = { "" };
 
 		Vfs_ram::Node *lookup(char const *path, bool return_parent = false)
 		{
@@ -624,7 +1056,7 @@ class Vfs::Ram_file_system : public Vfs::File_system
 				if (strlen(name) >= MAX_NAME_LEN)
 					return OPEN_ERR_NAME_TOO_LONG;
 
-				try { file = new (_env.alloc()) File(name, _env.alloc()); }
+				try { file = new (_env.alloc()) File(name, _store); }
 				catch (Out_of_memory) { return OPEN_ERR_NO_SPACE; }
 				parent->adopt(file);
 				parent->notify();
@@ -897,20 +1329,27 @@ class Vfs::Ram_file_system : public Vfs::File_system
 		{
 			using namespace Vfs_ram;
 
-			Ram_dataspace_capability ds_cap;
-
 			Node *node = lookup(path);
-			if (!node) return ds_cap;
+			if (!node) return Dataspace_capability();
 			Node::Guard guard(node);
 
 			File *file = dynamic_cast<File *>(node);
-			if (!file) return ds_cap;
-
-			size_t len = file->length();
-
+			if (!file) return Dataspace_capability();
+
+			try { return file->view(); }
+			catch (Genode::Out_of_ram)                    { }
+			catch (Genode::Out_of_caps)                   { }
+			catch (Genode::Region_map::Region_conflict)   { }
+			catch (Genode::Region_map::Invalid_dataspace) { }
+			catch (Genode::Service_denied)                { }
+			catch (Genode::Insufficient_ram_quota)        { }
+			catch (Genode::Insufficient_cap_quota)        { }
+
+			/* fall back to a copy of the file content */
+			Ram_dataspace_capability ds_cap;
 			char *local_addr = nullptr;
 			try {
-				ds_cap = _env.env().ram().alloc(len);
+				ds_cap = _env.env().ram().alloc(file->length());
 
 				local_addr = _env.env().rm().attach(ds_cap);
 				file->read(local_addr, file->length(), 0);
@@ -924,9 +1363,12 @@ class Vfs::Ram_file_system : public Vfs::File_system
 			return ds_cap;
 		}
 
-		void release(char const *, Dataspace_capability ds_cap) override {
-			_env.env().ram().free(
-				static_cap_cast<Genode::Ram_dataspace>(ds_cap)); }
+		void release(char const *, Dataspace_capability ds_cap) override
+		{
+			if (!_store.release(ds_cap))
+				_env.env().ram().free(
+					static_cap_cast<Genode::Ram_dataspace>(ds_cap));
+		}
 
 
 		Watch_result watch(char const      *path,
@@ -0,0 +1,191 @@
+/*
+ * \brief  Adaptive replacement cache (ARC) strategy
+ * \author Stefan Kalkowski
+ * \date   2026-10-17
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#include <util/reconstructible.h>
+
+#include "arc.h"
+#include "ghost_list.h"
+#include "driver.h"
+
+typedef Driver<Arc_policy>::Chunk_level_4 Chunk;
+typedef Arc_policy::Element               Element;
+
+static Cache::Queue<Element>                    t1, t2;
+static Genode::Constructible<Cache::Ghost_list> b1, b2;
+
+static unsigned         target_t1;   /* adaptation parameter 'p' */
+static Genode::uint64_t insertions;
+static Genode::uint64_t ghost_hits;
+static Genode::uint64_t evictions;
+
+
+static void arc_adapt(bool grow_t1)
+{
+	unsigned const b1_count = b1->count() + 1;
+	unsigned const b2_count = b2->count() + 1;
+	unsigned const cached   = t1.count() + t2.count();
+
+	if (grow_t1) {
+		unsigned const delta = Genode::max(b2_count / b1_count, 1U);
+		target_t1 = Genode::min(target_t1 + delta, cached);
+	} else {
+		unsigned const delta = Genode::max(b1_count / b2_count, 1U);
+		target_t1 = target_t1 > delta ? target_t1 - delta : 0;
+	}
+}
+
+
+/*
+ * Insert chunk that is not cached yet
+ */
+static void arc_insert(Element const *e)
+{
+	Cache::offset_t const off = static_cast<Chunk const *>(e)->base_offset();
+
+	insertions++;
+
+	/* a ghost hit reveals that the evicted chunk is part of the working set */
+	bool const b1_hit = b1->remove(off);
+	bool const b2_hit = !b1_hit && b2->remove(off);
+
+	if (b1_hit || b2_hit) {
+		ghost_hits++;
+		arc_adapt(b1_hit);
+		t2.enqueue(*e);
+		e->list = Element::T2;
+		return;
+	}
+
+	t1.enqueue(*e);
+	e->list     = Element::T1;
+	e->inserted = insertions;
+}
+
+
+static void arc_access(Element const *e)
+{
+	if (e->list == Element::NONE) {
+		arc_insert(e);
+		return;
+	}
+
+	/*
+	 * Populating a chunk from the device, on demand or by read ahead, is
+	 * no reference. The correlation window starts with the first one.
+	 */
+	if (e->unreferenced) {
+		e->unreferenced = false;
+		e->inserted     = insertions;
+		if (e->list == Element::T1) t1.touch(*e);
+		else                        t2.touch(*e);
+		return;
+	}
+
+	switch (e->list) {
+	case Element::T2:
+		t2.touch(*e);
+		return;
+
+	case Element::T1:
+		if (insertions - e->inserted < Arc_policy::CORRELATION_WINDOW) {
+			t1.touch(*e);
+			return;
+		}
+		t1.remove(*e);
+		t2.enqueue(*e);
+		e->list = Element::T2;
+		return;
+
+	case Element::NONE:
+		break;
+	}
+}
+
+
+/*
+ * Select the list to evict from according to the target size of T1
+ */
+static Cache::Queue<Element> &arc_victim_list()
+{
+	if (t1.empty()) return t2;
+	if (t2.empty()) return t1;
+
+	return (t1.count() > target_t1) ? t1 : t2;
+}
+
+
+void Arc_policy::init(Genode::Allocator &alloc, unsigned ghost_entries)
+{
+	b1.construct(alloc, ghost_entries);
+	b2.construct(alloc, ghost_entries);
+}
+
+
+void Arc_policy::fill(const Element *e)
+{
+	if (e->list != Element::NONE) return;
+
+	arc_insert(e);
+	e->unreferenced = true;
+}
+
+
+void Arc_policy::read(const Element *e) {
+	arc_access(e); }
+
+
+void Arc_policy::write(const Element *e) {
+	arc_access(e); }
+
+
+void Arc_policy::flush(Cache::size_t size)
+{
+	Cache::size_t s = 0;
+	while ((size == 0) || (s < size)) {
+
+		Cache::Queue<Element> &list = arc_victim_list();
+		Element *e = list.lru();
+		if (!e) break;
+
+		Chunk *cb = static_cast<Chunk*>(e);
+		Cache::offset_t const off = cb->base_offset();
+
+		/* write back dirty content, the chunk stays queued on failure */
+		cb->sync(Driver<Arc_policy>::CACHE_BLK_SIZE, off);
+
+		/* the chunk gets destroyed by 'free', dequeue it beforehand */
+		list.remove(*e);
+		if (e->list == Element::T1) b1->insert(off);
+		else                        b2->insert(off);
+		e->list         = Element::NONE;
+		e->unreferenced = false;
+		evictions++;
+
+		cb->free(Driver<Arc_policy>::CACHE_BLK_SIZE, off);
+		s += sizeof(Chunk);
+	}
+
+	if (s < size) throw Block::Driver::Request_congestion();
+}
+
+
+void Arc_policy::report(Genode::Xml_generator &xml)
+{
+	xml.attribute("t1",         t1.count());
+	xml.attribute("t2",         t2.count());
+	xml.attribute("b1",         b1->count());
+	xml.attribute("b2",         b2->count());
+	xml.attribute("target_t1",  target_t1);
+	xml.attribute("ghost_hits", ghost_hits);
+	xml.attribute("evictions",  evictions);
+}
@@ -0,0 +1,65 @@
+/*
+ * \brief  Adaptive replacement cache (ARC) strategy
+ * \author Stefan Kalkowski
+ * \date   2026-10-17
+ *
+ * The policy splits the cached chunks into a recency list T1 of chunks that
+ * were referenced once and a frequency list T2 of chunks that were referenced
+ * repeatedly. The ghost lists B1 and B2 remember chunks recently evicted from
+ * T1 and T2 and steer the target size of T1. A sequential scan therefore only
+ * displaces chunks of T1 while the working set in T2 stays cached.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _ARC_H_
+#define _ARC_H_
+
+#include <base/allocator.h>
+#include <util/xml_generator.h>
+
+#include "chunk.h"
+#include "queue.h"
+
+struct Arc_policy
+{
+	class Element : public Cache::Queue<Element>::Element
+	{
+		public:
+
+			enum List { NONE, T1, T2 };
+
+			List mutable list { NONE };
+
+			/* chunk was populated from the device but not yet referenced */
+			bool mutable unreferenced { false };
+
+			/* value of the insertion counter at the first reference */
+			Genode::uint64_t mutable inserted { 0 };
+	};
+
+	/*
+	 * Number of chunk insertions during which further references to a
+	 * freshly inserted chunk are regarded as correlated, e.g., a client
+	 * reading a chunk in several small requests, and thus do not promote
+	 * the chunk to T2
+	 */
+	enum { CORRELATION_WINDOW = 16 };
+
+	static char const *name() { return "arc"; }
+
+	static void init(Genode::Allocator &alloc, unsigned ghost_entries);
+
+	static void fill(const Element  *e);
+	static void read(const Element  *e);
+	static void write(const Element *e);
+	static void flush(Cache::size_t size = 0);
+	static void report(Genode::Xml_generator &xml);
+};
+
+#endif /* _ARC_H_ */
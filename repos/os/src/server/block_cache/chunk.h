@@ -21,6 +21,7 @@
 #include <util/noncopyable.h>
 #include <base/allocator.h>
 #include <base/exception.h>
+#include <util/avl_tree.h>
 #include <util/list.h>
 #include <util/string.h>
 
@@ -110,15 +111,21 @@ namespace Cache {
 
 	/**
 	 * Chunk of bytes used as leaf in hierarchy of chunk indices
+	 *
+	 * Dirty chunks are additionally organized in an AVL tree sorted by
+	 * their offset, which allows for writing back contiguous ranges of
+	 * dirty chunks with a single request.
 	 */
 	template <unsigned CHUNK_SIZE, typename POLICY>
 	class Chunk : public Chunk_base,
-	              public POLICY::Element
+	              public POLICY::Element,
+	              public Genode::Avl_node<Chunk<CHUNK_SIZE, POLICY> >
 	{
 		private:
 
 			char        _data[CHUNK_SIZE];
-			unsigned    _writes;
+			bool        _valid;  /* content was read or completely written */
+			bool        _dirty;  /* content differs from backend device */
 
 		public:
 
@@ -136,12 +143,12 @@ namespace Cache {
 			 * of 'Chunk_index'.
 			 */
 			Chunk(Genode::Allocator &, offset_t base_offset, Chunk_base *p)
-			: Chunk_base(base_offset, p), _writes(0) { }
+			: Chunk_base(base_offset, p), _valid(false), _dirty(false) { }
 
 			/**
 			 * Construct zero chunk
 			 */
-			Chunk() : _writes(0) { }
+			Chunk() : _valid(false), _dirty(false) { }
 
 			/**
 			 * Return number of used entries
@@ -152,6 +159,11 @@ namespace Cache {
 			 */
 			size_t used_size() const { return _num_entries; }
 
+			bool dirty() const { return _dirty; }
+
+			/**
+			 * Write data supplied by the client
+			 */
 			void write(char const *src, size_t len, offset_t seek_offset)
 			{
 				assert_valid_range(seek_offset, len, SIZE);
@@ -165,7 +177,35 @@ namespace Cache {
 
 				_num_entries = Genode::max(_num_entries, local_offset + len);
 
-				_writes++;
+				if (len == SIZE) _valid = true;
+
+				if (!_dirty) {
+					_dirty = true;
+					POLICY::dirty(this);
+				}
+			}
+
+			/**
+			 * Populate chunk with data read from the backend device
+			 *
+			 * Content written by the client in the meantime is newer than the
+			 * content of the device and is therefore retained.
+			 */
+			void fill(char const *src, size_t len, offset_t seek_offset)
+			{
+				assert_valid_range(seek_offset, len, SIZE);
+
+				POLICY::fill(this);
+
+				if (_dirty) return;
+
+				offset_t const local_offset = seek_offset - base_offset();
+
+				Genode::memcpy(&_data[local_offset], src, len);
+
+				_num_entries = Genode::max(_num_entries, local_offset + len);
+
+				_valid = true;
 			}
 
 			void read(char *dst, size_t len, offset_t seek_offset) const
@@ -181,16 +221,29 @@ namespace Cache {
 			{
 				assert_valid_range(seek_offset, len, SIZE);
 
-				if (_writes == 0)
+				if (!_valid)
 					throw Range_incomplete(base_offset(), SIZE);
 			}
 
 			void sync(size_t len, offset_t seek_offset)
 			{
-				if (_writes > 1) {
+				if (_dirty)
 					POLICY::sync(this, (char*)_data);
-					_writes = 1;
-				}
+			}
+
+			/**
+			 * Copy content to write-back buffer and mark chunk as clean
+			 *
+			 * \param len  number of bytes to copy, which is smaller than the
+			 *             chunk size only for the last chunk of a device
+			 *
+			 * The caller is responsible for removing the chunk from the
+			 * AVL tree of dirty chunks.
+			 */
+			void write_back(char *dst, size_t len)
+			{
+				Genode::memcpy(dst, _data, Genode::min(len, SIZE));
+				_dirty = false;
 			}
 
 			void alloc(size_t len, offset_t seek_offset) { }
@@ -215,11 +268,35 @@ namespace Cache {
 
 			void free(size_t, offset_t)
 			{
-				if (_writes > 1) throw Dirty_chunk(_base_offset, SIZE);
+				if (_dirty) throw Dirty_chunk(_base_offset, SIZE);
 
 				_num_entries = 0;
 				if (_parent) _parent->free(SIZE, _base_offset);
 			}
+
+
+			/************************
+			 ** Avl node interface **
+			 ************************/
+
+			bool higher(Chunk *c) const { return c->_base_offset > _base_offset; }
+
+			/**
+			 * Return dirty chunk with the lowest offset at or above 'off'
+			 */
+			Chunk *find_at_or_above(offset_t off)
+			{
+				typedef Genode::Avl_node<Chunk> Node;
+
+				if (_base_offset < off) {
+					Chunk *c = Node::child(Node::RIGHT);
+					return c ? c->find_at_or_above(off) : nullptr;
+				}
+
+				Chunk *c = Node::child(Node::LEFT);
+				Chunk *lower = c ? c->find_at_or_above(off) : nullptr;
+				return lower ? lower : this;
+			}
 	};
 
 
@@ -409,6 +486,20 @@ namespace Cache {
 				}
 			};
 
+			struct Fill_func
+			{
+				typedef ENTRY_TYPE Entry;
+
+				static Entry &lookup(Chunk_index &chunk, unsigned i) {
+					return chunk._entry(i); }
+
+				void operator () (Entry &entry, char const *src, size_t len,
+				                  offset_t seek_offset) const
+				{
+					entry.fill(src, len, seek_offset);
+				}
+			};
+
 			struct Read_func
 			{
 				typedef ENTRY_TYPE const Entry;
@@ -515,6 +606,12 @@ namespace Cache {
 			void write(char const *src, size_t len, offset_t seek_offset) {
 				_range_op(*this, src, len, seek_offset, Write_func()); }
 
+			/**
+			 * Populate chunks with data read from the backend device
+			 */
+			void fill(char const *src, size_t len, offset_t seek_offset) {
+				_range_op(*this, src, len, seek_offset, Fill_func()); }
+
 			/**
 			 * Allocate needed chunks
 			 */
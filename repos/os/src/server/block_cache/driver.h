@@ -15,8 +15,10 @@
 #include <block_session/connection.h>
 #include <block/component.h>
 #include <os/packet_allocator.h>
+#include <os/reporter.h>
 
 #include "chunk.h"
+#include "read_ahead.h"
 
 /**
  * Cache driver used by the generic block driver framework
@@ -43,6 +45,14 @@ class Driver : public Block::Driver
 			        char * const              b)
 				: srv(s), cli(c), buffer(b) {}
 
+			/**
+			 * Constructor for read-ahead requests without client packet
+			 */
+			Request(Block::Packet_descriptor &s)
+				: srv(s), cli(), buffer(nullptr) {}
+
+			bool read_ahead() const { return buffer == nullptr; }
+
 			/*
 			 * \return true when the given response packet matches
 			 *         the request send to the backend device
@@ -92,8 +102,11 @@ class Driver : public Block::Driver
 		 * The given policy class is extended by a synchronization routine,
 		 * used by the cache chunk structure
 		 */
-		struct Policy : POLICY {
-			static void sync(const typename POLICY::Element *e, char *src); };
+		struct Policy : POLICY
+		{
+			static void sync(const typename POLICY::Element *e, char *src);
+			static void dirty(const typename POLICY::Element *e);
+		};
 
 	public:
 
@@ -114,7 +127,48 @@ class Driver : public Block::Driver
 
 	private:
 
+		/*
+		 * Parameters of the write-back engine
+		 */
+		struct Write_back_config
+		{
+			Genode::size_t tx_buf_size;  /* backend packet-stream buffer */
+			Genode::size_t max_write;    /* maximum bytes per write request */
+			unsigned       dirty_high;   /* dirty chunks triggering write-back */
+			unsigned       dirty_low;    /* dirty chunks ending write-back */
+			Genode::size_t read_ahead;   /* maximum read-ahead window */
+
+			static Write_back_config from_xml(Genode::Xml_node config)
+			{
+				using Genode::Number_of_bytes;
+
+				Genode::size_t const tx_buf_size =
+					config.attribute_value("tx_buf", Number_of_bytes(1024*1024));
+
+				Genode::size_t const max_write = Genode::max(
+					(Genode::size_t)config.attribute_value("max_write",
+					                                       Number_of_bytes(tx_buf_size/2)),
+					(Genode::size_t)CACHE_BLK_SIZE);
+
+				Genode::size_t const high =
+					config.attribute_value("dirty_high", Number_of_bytes(2*max_write));
+				Genode::size_t const low =
+					config.attribute_value("dirty_low", Number_of_bytes(high/2));
+
+				Genode::size_t const read_ahead = Genode::min(
+					(Genode::size_t)config.attribute_value("read_ahead",
+					                                       Number_of_bytes(128*1024)),
+					max_write);
+
+				return { tx_buf_size, max_write,
+				         (unsigned)(high / CACHE_BLK_SIZE),
+				         (unsigned)(Genode::min(low, high) / CACHE_BLK_SIZE),
+				         read_ahead };
+			}
+		};
+
 		Genode::Env                      &_env;
+		Write_back_config           const _wb_config;
 		Genode::Tslab<Request, SLAB_SZ>   _r_slab;    /* slab for requests  */
 		Genode::List<Request>             _r_list;    /* list of requests   */
 		Genode::Packet_allocator          _alloc;     /* packet allocator   */
@@ -125,6 +179,34 @@ class Driver : public Block::Driver
 		Genode::Io_signal_handler<Driver> _source_submit;
 		Genode::Io_signal_handler<Driver> _yield;
 
+		Genode::Constructible<Genode::Expanding_reporter> _statistics { };
+
+		Genode::uint64_t _hits   { 0 };  /* read requests served by cache */
+		Genode::uint64_t _misses { 0 };  /* read requests fetched from device */
+
+		/*
+		 * Write-back state
+		 */
+		Genode::Avl_tree<Chunk_level_4> _dirty { };     /* sorted by offset */
+		unsigned         _dirty_count      { 0 };
+		unsigned         _writes_in_flight { 0 };
+		bool             _write_back_active { false };
+		Cache::offset_t  _write_back_cursor { 0 };
+		bool             _unsynced         { false }; /* writes since last sync */
+		bool             _sync_in_flight   { false };
+		Genode::uint64_t _write_requests   { 0 };
+		Genode::uint64_t _written_bytes    { 0 };
+
+		/*
+		 * Read-ahead state
+		 */
+		Cache::Read_ahead _read_ahead {
+			4*CACHE_BLK_SIZE / _info.block_size,
+			_wb_config.read_ahead / _info.block_size };
+
+		Genode::size_t   _read_ahead_in_flight { 0 };  /* bytes */
+		Genode::uint64_t _read_ahead_bytes     { 0 };
+
 		Driver(Driver const&);            /* singleton pattern */
 		Driver& operator=(Driver const&); /* singleton pattern */
 
@@ -157,8 +239,8 @@ class Driver : public Block::Driver
 		{
 			try {
 			if (r->cli.operation() == Block::Packet_descriptor::READ)
-				read(r->cli.block_number(), r->cli.block_count(),
-				     r->buffer, r->cli);
+				_read(r->cli.block_number(), r->cli.block_count(),
+				      r->buffer, r->cli);
 			else
 				write(r->cli.block_number(), r->cli.block_count(),
 				      r->buffer, r->cli);
@@ -178,18 +260,38 @@ class Driver : public Block::Driver
 			while (_blk.tx()->ack_avail()) {
 				Block::Packet_descriptor p = _blk.tx()->get_acked_packet();
 
+				switch (p.operation()) {
+				case Block::Packet_descriptor::WRITE:
+					_writes_in_flight--;
+					if (!p.succeeded())
+						Genode::error("write back of blocks ", p.block_number(),
+						              "-", p.block_number() + p.block_count() - 1,
+						              " failed");
+					_blk.tx()->release_packet(p);
+					continue;
+
+				case Block::Packet_descriptor::SYNC:
+					_sync_in_flight = false;
+					continue;
+
+				default: break;
+				}
+
 				/* when reading, write result into cache */
 				if (p.operation() == Block::Packet_descriptor::READ)
-					_cache.write(_blk.tx()->packet_content(p),
-					             p.block_count() * _info.block_size,
-					             p.block_number() * _info.block_size);
+					_cache.fill(_blk.tx()->packet_content(p),
+					            p.block_count() * _info.block_size,
+					            p.block_number() * _info.block_size);
 
 				/* loop through the list of requests, and ack all related */
 				for (Request *r = _r_list.first(), *r_to_handle = r; r;
 				     r_to_handle = r) {
 					r = r->next();
 					if (r_to_handle->match(p)) {
-						_handle_reply(p, r_to_handle);
+						if (r_to_handle->read_ahead())
+							_read_ahead_in_flight -= p.size();
+						else
+							_handle_reply(p, r_to_handle);
 						_r_list.remove(r_to_handle);
 						Genode::destroy(&_r_slab, r_to_handle);
 					}
@@ -197,12 +299,122 @@ class Driver : public Block::Driver
 
 				_blk.tx()->release_packet(p);
 			}
+
+			_write_back_dirty(false);
 		}
 
 		/*
 		 * Handle that the backend device is ready to receive again
 		 */
-		void _ready_to_submit() { }
+		void _ready_to_submit() { _write_back_dirty(false); }
+
+		Cache::size_t _device_size() const {
+			return (Cache::size_t)_info.block_size * _info.block_count; }
+
+		/*
+		 * Return dirty chunk at given offset or nullptr
+		 */
+		Chunk_level_4 *_dirty_chunk(Cache::offset_t off) const
+		{
+			Chunk_level_4 *c = _dirty_at_or_above(off);
+			return (c && c->base_offset() == off) ? c : nullptr;
+		}
+
+		Chunk_level_4 *_dirty_at_or_above(Cache::offset_t off) const {
+			return _dirty.first() ? _dirty.first()->find_at_or_above(off) : nullptr; }
+
+		/*
+		 * Write back the contiguous range of dirty chunks around 'chunk'
+		 *
+		 * The chunk contents are copied to the packet-stream buffer so that
+		 * the chunks become clean as soon as the request is submitted.
+		 *
+		 * \return false if the backend device is congested
+		 */
+		bool _write_back_range(Chunk_level_4 &chunk)
+		{
+			if (!_blk.tx()->ready_to_submit())
+				return false;
+
+			unsigned const max_chunks =
+				(unsigned)(_wb_config.max_write / CACHE_BLK_SIZE);
+
+			/* extend range towards lower offsets by up to half the maximum */
+			Chunk_level_4 *first = &chunk;
+			for (unsigned n = 1; n < max_chunks/2; n++) {
+				if (first->base_offset() < CACHE_BLK_SIZE) break;
+
+				Chunk_level_4 *prev =
+					_dirty_chunk(first->base_offset() - CACHE_BLK_SIZE);
+				if (!prev) break;
+				first = prev;
+			}
+
+			unsigned count = 1;
+			for (Chunk_level_4 *c = first; count < max_chunks; count++) {
+				c = _dirty_chunk(c->base_offset() + CACHE_BLK_SIZE);
+				if (!c) break;
+			}
+
+			Cache::offset_t const off = first->base_offset();
+			Cache::size_t   const len =
+				Genode::min((Cache::size_t)count*CACHE_BLK_SIZE,
+				            _device_size() - off);
+
+			Block::Packet_descriptor p;
+			try {
+				p = Block::Packet_descriptor(_blk.alloc_packet(len),
+				                             Block::Packet_descriptor::WRITE,
+				                             off / _info.block_size,
+				                             len / _info.block_size);
+			} catch (Block::Session::Tx::Source::Packet_alloc_failed) {
+				return false; }
+
+			char *dst = _blk.tx()->packet_content(p);
+			Chunk_level_4 *c = first;
+			for (Cache::size_t pos = 0; pos < len; pos += CACHE_BLK_SIZE) {
+				Chunk_level_4 *next = _dirty_chunk(c->base_offset() + CACHE_BLK_SIZE);
+
+				c->write_back(dst + pos, len - pos);
+				_dirty.remove(c);
+				_dirty_count--;
+				c = next;
+			}
+
+			_blk.tx()->submit_packet(p);
+			_writes_in_flight++;
+			_write_requests++;
+			_written_bytes    += len;
+			_write_back_cursor = off + len;
+			_unsynced          = true;
+			return true;
+		}
+
+		/*
+		 * Write back dirty chunks in ascending order of their offsets
+		 *
+		 * \param all  write back all dirty chunks instead of stopping at
+		 *             the low watermark
+		 */
+		void _write_back_dirty(bool all)
+		{
+			for (;;) {
+				if (!all && (!_write_back_active
+				          || _dirty_count <= _wb_config.dirty_low))
+					break;
+
+				/* sweep upwards, wrap around at the highest dirty chunk */
+				Chunk_level_4 *c = _dirty_at_or_above(_write_back_cursor);
+				if (!c) c = _dirty_at_or_above(0);
+				if (!c) break;
+
+				if (!_write_back_range(*c))
+					break;
+			}
+
+			if (_dirty_count <= _wb_config.dirty_low)
+				_write_back_active = false;
+		}
 
 		/*
 		 * Setup a request to the backend device
@@ -251,6 +463,8 @@ class Driver : public Block::Driver
 				_blk.tx()->submit_packet(p_to_dev);
 			} catch(Block::Session::Tx::Source::Packet_alloc_failed) {
 				throw Request_congestion();
+			} catch(Write_failed) {
+				throw Request_congestion();
 			} catch(Genode::Allocator::Out_of_memory) {
 				/* clean up */
 				_blk.tx()->release_packet(p_to_dev);
@@ -260,25 +474,131 @@ class Driver : public Block::Driver
 
 		/*
 		 * Synchronize dirty chunks with backend device
+		 *
+		 * Only the dirty chunks and the writes in flight are waited for.
 		 */
 		void _sync()
 		{
-			Cache::offset_t off = 0;
-			Cache::size_t len   = _info.block_size * _info.block_count;
-
-			while (len > 0) {
-				try {
-					_cache.sync(len, off);
-					len = 0;
-				} catch(Write_failed &e) {
-					/**
-					 * Write to backend failed when backend device isn't ready
-					 * to proceed, so handle signals, until it's ready again
-					 */
-					off = e.off;
-					len = _info.block_size * _info.block_count - off;
-					_env.ep().wait_and_dispatch_one_io_signal();
+			for (;;) {
+				_write_back_dirty(true);
+
+				if (!_dirty_count && !_writes_in_flight)
+					break;
+
+				/*
+				 * Handle signals until the backend device acknowledged
+				 * the submitted writes
+				 */
+				_env.ep().wait_and_dispatch_one_io_signal();
+			}
+
+			if (!_unsynced)
+				return;
+
+			/* let the backend device persist the written data */
+			while (!_blk.tx()->ready_to_submit())
+				_env.ep().wait_and_dispatch_one_io_signal();
+
+			_sync_in_flight = true;
+			_blk.tx()->submit_packet(
+				Block::Session::sync_all_packet_descriptor(_info, { 0 }));
+
+			while (_sync_in_flight)
+				_env.ep().wait_and_dispatch_one_io_signal();
+
+			_unsynced = false;
+		}
+
+		/*
+		 * Return true if the cache block at 'nr' is populated or requested
+		 */
+		bool _cached_or_requested(Block::sector_t nr)
+		{
+			for (Request *r = _r_list.first(); r; r = r->next())
+				if (r->match(false, nr, _cache_blk_mod()))
+					return true;
+
+			try {
+				_cache.stat(CACHE_BLK_SIZE, nr * _info.block_size);
+				return true;
+			} catch (Cache::Chunk_base::Range_incomplete) { }
+
+			return false;
+		}
+
+		/*
+		 * Issue read-ahead request to the backend device
+		 *
+		 * \return false if the request could not be issued
+		 */
+		bool _request_read_ahead(Block::sector_t nr, Genode::size_t cnt)
+		{
+			Genode::size_t const size = cnt * _info.block_size;
+
+			/* leave the larger part of the packet buffer to the client */
+			if (_read_ahead_in_flight + size > _wb_config.tx_buf_size/2)
+				return false;
+
+			if (!_blk.tx()->ready_to_submit())
+				return false;
+
+			Block::Packet_descriptor p;
+			try {
+				_cache.alloc(size, nr * _info.block_size);
+				p = Block::Packet_descriptor(_blk.alloc_packet(size),
+				                             Block::Packet_descriptor::READ,
+				                             nr, cnt);
+			}
+			catch (Block::Session::Tx::Source::Packet_alloc_failed) { return false; }
+			catch (Genode::Allocator::Out_of_memory)                 { return false; }
+			catch (Write_failed)                                     { return false; }
+			catch (Request_congestion)                               { return false; }
+
+			_r_list.insert(new (&_r_slab) Request(p));
+			_blk.tx()->submit_packet(p);
+
+			_read_ahead_in_flight += size;
+			_read_ahead_bytes     += size;
+			return true;
+		}
+
+		/*
+		 * Feed read access into the stream detector and prefetch the
+		 * chunks ahead of a sequential reader
+		 */
+		void _read_ahead_after(Block::sector_t nr, Genode::size_t cnt)
+		{
+			Cache::Read_ahead::Range const range = _read_ahead.access(nr, cnt);
+			if (!range.valid())
+				return;
+
+			Block::sector_t const end =
+				Genode::min(range.block_number + range.block_count,
+				            (Block::sector_t)_info.block_count);
+
+			Genode::size_t const max_blocks =
+				_wb_config.max_write / _info.block_size;
+
+			for (Block::sector_t b = _cache_blk_round_off(range.block_number);
+			     b < end; ) {
+
+				if (_cached_or_requested(b)) {
+					b += _cache_blk_mod();
+					continue;
+				}
+
+				/* merge consecutive missing cache blocks into one request */
+				Block::sector_t e = b + _cache_blk_mod();
+				while (e < end && e - b < max_blocks && !_cached_or_requested(e))
+					e += _cache_blk_mod();
+				e = Genode::min(e, (Block::sector_t)_info.block_count);
+
+				if (!_request_read_ahead(b, e - b)) {
+					_read_ahead.cancel({ b, (Genode::size_t)(range.block_number
+					                                         + range.block_count - b) });
+					return;
 				}
+				b = e;
 			}
 		}
 
@@ -319,8 +639,51 @@ class Driver : public Block::Driver
 				Arg_string::find_arg(args.string(), "ram_quota").ulong_value(0);
 
 			/* flush the requested amount of RAM from cache */
-			POLICY::flush(requested_ram_quota);
+			try { POLICY::flush(requested_ram_quota); }
+			catch (Write_failed)         { }
+			catch (Request_congestion)   { }
 			_env.parent().yield_response();
+
+			_report_statistics();
+		}
+
+		void _report_statistics()
+		{
+			if (!_statistics.constructed())
+				return;
+
+			_statistics->generate([&] (Genode::Xml_generator &xml) {
+				xml.attribute("policy", POLICY::name());
+				xml.attribute("hits",   _hits);
+				xml.attribute("misses", _misses);
+				xml.attribute("dirty",  _dirty_count);
+				xml.attribute("write_requests", _write_requests);
+				xml.attribute("written_bytes",  _written_bytes);
+				xml.attribute("read_ahead_bytes", _read_ahead_bytes);
+				POLICY::report(xml);
+			});
+		}
+
+		/*
+		 * Read from cache and acknowledge the client packet
+		 *
+		 * \return false if missing chunks had to be requested from the
+		 *         backend device first
+		 */
+		bool _read(Block::sector_t           block_number,
+		           Genode::size_t            block_count,
+		           char*                     buffer,
+		           Block::Packet_descriptor &packet)
+		{
+			if (!_stat(block_number, block_count, buffer, packet))
+				return false;
+
+			_cache.read(buffer,
+			            block_count *_info.block_size,
+			            block_number*_info.block_size);
+
+			ack_packet(packet);
+			return true;
 		}
 
 	public:
@@ -328,14 +691,15 @@ class Driver : public Block::Driver
 		/*
 		 * Constructor
 		 *
-		 * \param ep  server entrypoint
+		 * \param config  component configuration
 		 */
-		Driver(Genode::Env &env, Genode::Heap &heap)
+		Driver(Genode::Env &env, Genode::Heap &heap, Genode::Xml_node config)
 		: Block::Driver(env.ram()),
 		  _env(env),
+		  _wb_config(Write_back_config::from_xml(config)),
 		  _r_slab(&heap),
 		  _alloc(&heap, CACHE_BLK_SIZE),
-		  _blk(_env, &_alloc, Block::Session::TX_QUEUE_SIZE*CACHE_BLK_SIZE),
+		  _blk(_env, &_alloc, _wb_config.tx_buf_size),
 		  _info(_blk.info()),
 		  _cache(heap, 0),
 		  _source_ack(env.ep(), *this, &Driver::_ack_avail),
@@ -356,6 +720,9 @@ class Driver : public Block::Driver
 
 			/* truncate chunk structure to real size of the device */
 			_cache.truncate(_info.block_size * _info.block_count);
+
+			if (config.attribute_value("report", false))
+				_statistics.construct(env, "statistics", "statistics");
 		}
 
 		~Driver()
@@ -363,10 +730,31 @@ class Driver : public Block::Driver
 			/* when session gets closed, synchronize and flush the cache */
 			_sync();
 			POLICY::flush();
+			_report_statistics();
+		}
+
+		/**
+		 * Register chunk that became dirty
+		 */
+		void mark_dirty(Chunk_level_4 &chunk)
+		{
+			_dirty.insert(&chunk);
+			_dirty_count++;
+
+			if (_dirty_count >= _wb_config.dirty_high)
+				_write_back_active = true;
 		}
 
-		Block::Session_client* blk()    { return &_blk;   }
-		Genode::size_t         blk_sz() { return _info.block_size; }
+		/**
+		 * Write back dirty chunk to be evicted from the cache
+		 *
+		 * \throw Write_failed  backend device is not ready to proceed
+		 */
+		void write_back(Chunk_level_4 &chunk)
+		{
+			if (!_write_back_range(chunk))
+				throw Write_failed(chunk.base_offset());
+		}
 
 
 		/****************************
@@ -380,14 +768,12 @@ class Driver : public Block::Driver
 		          char*                     buffer,
 		          Block::Packet_descriptor &packet)
 		{
-			if (!_stat(block_number, block_count, buffer, packet))
-				return;
-
-			_cache.read(buffer,
-			            block_count *_info.block_size,
-			            block_number*_info.block_size);
+			if (_read(block_number, block_count, buffer, packet))
+				_hits++;
+			else
+				_misses++;
 
-			ack_packet(packet);
+			_read_ahead_after(block_number, block_count);
 		}
 
 		void write(Block::sector_t           block_number,
@@ -398,8 +784,11 @@ class Driver : public Block::Driver
 			if (!_info.writeable)
 				throw Io_error();
 
-			_cache.alloc(block_count  * _info.block_size,
-			             block_number * _info.block_size);
+			try {
+				_cache.alloc(block_count  * _info.block_size,
+				             block_number * _info.block_size);
+			} catch (Write_failed) {
+				throw Request_congestion(); }
 
 			if ((block_number % _cache_blk_mod()) &&
 			    !_stat(block_number, 1, const_cast<char* const>(buffer), packet))
@@ -415,7 +804,13 @@ class Driver : public Block::Driver
 			             block_number * _info.block_size);
 
 			ack_packet(packet);
+
+			_write_back_dirty(false);
 		}
 
-		void sync() { _sync(); }
+		void sync()
+		{
+			_sync();
+			_report_statistics();
+		}
 };
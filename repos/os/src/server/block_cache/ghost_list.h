@@ -0,0 +1,182 @@
+/*
+ * \brief  Bounded history of recently evicted chunks
+ * \author Stefan Kalkowski
+ * \date   2026-10-17
+ *
+ * A ghost list only remembers the offsets of evicted chunks, not their
+ * content. The adaptive replacement policies consult it on a cache miss to
+ * tell chunks that were evicted prematurely apart from chunks that are
+ * accessed only once, e.g., by a sequential scan.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _GHOST_LIST_H_
+#define _GHOST_LIST_H_
+
+/* Genode includes */
+#include <base/allocator.h>
+#include <util/noncopyable.h>
+
+#include "chunk.h"
+
+namespace Cache { class Ghost_list; }
+
+
+/**
+ * FIFO of chunk offsets with constant-time membership test
+ *
+ * The offsets are stored in a ring buffer of fixed capacity. When the ring
+ * is full, the oldest entry is dropped. Membership is tested via a chained
+ * hash table whose chains are threaded through the ring slots. The whole
+ * backing store is allocated once at construction time because entries are
+ * added while the cache is flushed due to memory pressure.
+ */
+class Cache::Ghost_list : Genode::Noncopyable
+{
+	private:
+
+		enum { NONE = ~0U };
+
+		struct Slot
+		{
+			offset_t offset;
+			unsigned next;   /* next slot within the same hash chain */
+			bool     valid;
+		};
+
+		Genode::Allocator &_alloc;
+
+		unsigned const _capacity;
+		unsigned const _num_buckets;
+
+		Slot     * const _slots;
+		unsigned * const _buckets;
+
+		unsigned _first { 0 };  /* ring index of oldest slot */
+		unsigned _used  { 0 };  /* occupied ring slots, including holes */
+		unsigned _count { 0 };  /* valid entries */
+
+		template <typename T>
+		static T *_alloc_array(Genode::Allocator &alloc, unsigned n)
+		{
+			return n ? (T *)alloc.alloc(n*sizeof(T)) : nullptr;
+		}
+
+		unsigned _bucket(offset_t off) const
+		{
+			Genode::uint64_t const h = off * 0x9e3779b97f4a7c15ULL;
+			return (unsigned)(h >> 32) % _num_buckets;
+		}
+
+		void _unlink(unsigned idx)
+		{
+			unsigned *link = &_buckets[_bucket(_slots[idx].offset)];
+
+			for (; *link != NONE; link = &_slots[*link].next) {
+				if (*link == idx) {
+					*link = _slots[idx].next;
+					break;
+				}
+			}
+			_slots[idx].valid = false;
+			_count--;
+		}
+
+		/*
+		 * Release invalid slots at the front of the ring
+		 */
+		void _trim()
+		{
+			while (_used && !_slots[_first].valid) {
+				_first = (_first + 1) % _capacity;
+				_used--;
+			}
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param capacity  maximum number of remembered offsets, a value
+		 *                  of 0 disables the ghost list
+		 */
+		Ghost_list(Genode::Allocator &alloc, unsigned capacity)
+		:
+			_alloc(alloc), _capacity(capacity),
+			_num_buckets(capacity ? capacity : 1),
+			_slots(_alloc_array<Slot>(alloc, capacity)),
+			_buckets(_alloc_array<unsigned>(alloc, capacity))
+		{
+			for (unsigned i = 0; i < _capacity; i++)
+				_buckets[i] = NONE;
+		}
+
+		~Ghost_list()
+		{
+			if (_slots)   _alloc.free(_slots,   _capacity*sizeof(Slot));
+			if (_buckets) _alloc.free(_buckets, _capacity*sizeof(unsigned));
+		}
+
+		unsigned count()    const { return _count; }
+		unsigned capacity() const { return _capacity; }
+
+		/**
+		 * Remember offset of evicted chunk
+		 */
+		void insert(offset_t off)
+		{
+			if (!_capacity) return;
+
+			if (_used == _capacity) {
+				_unlink(_first);
+				_trim();
+			}
+
+			unsigned const idx    = (_first + _used) % _capacity;
+			unsigned const bucket = _bucket(off);
+
+			_slots[idx]      = Slot { off, _buckets[bucket], true };
+			_buckets[bucket] = idx;
+			_used++;
+			_count++;
+		}
+
+		/**
+		 * Forget offset
+		 *
+		 * \return true if the offset was a member of the ghost list
+		 */
+		bool remove(offset_t off)
+		{
+			if (!_capacity) return false;
+
+			for (unsigned i = _buckets[_bucket(off)]; i != NONE; i = _slots[i].next) {
+				if (_slots[i].offset != off) continue;
+
+				_unlink(i);
+				_trim();
+				return true;
+			}
+			return false;
+		}
+
+		/**
+		 * Drop the oldest entry
+		 */
+		void shrink()
+		{
+			if (!_count) return;
+
+			_unlink(_first);
+			_trim();
+		}
+};
+
+#endif /* _GHOST_LIST_H_ */
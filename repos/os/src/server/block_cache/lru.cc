@@ -16,21 +16,26 @@
 
 typedef Driver<Lru_policy>::Chunk_level_4 Chunk;
 
-static const Lru_policy::Element        *lru = 0;
-static Genode::List<Lru_policy::Element> lru_list;
+static Cache::Queue<Lru_policy::Element> lru_queue;
+static Genode::uint64_t                  lru_evictions;
 
 
 static void lru_access(const Lru_policy::Element *e)
 {
-	if (e == lru) return;
-
-	if (e->next()) lru_list.remove(e);
+	if (e->cached) {
+		lru_queue.touch(*e);
+		return;
+	}
 
-	lru_list.insert(e, lru);
-	lru = e;
+	lru_queue.enqueue(*e);
+	e->cached = true;
 }
 
 
+void Lru_policy::fill(const Lru_policy::Element  *e) {
+	lru_access(e); }
+
+
 void Lru_policy::read(const Lru_policy::Element  *e) {
 	lru_access(e); }
 
@@ -42,21 +47,28 @@ void Lru_policy::write(const Lru_policy::Element *e) {
 void Lru_policy::flush(Cache::size_t size)
 {
 	Cache::size_t s = 0;
-	for (Lru_policy::Element *e = lru_list.first();
+	for (Lru_policy::Element *e = lru_queue.lru();
 		 e && ((size == 0) || (s < size));
-		 e = lru_list.first(), s += sizeof(Chunk)) {
+		 e = lru_queue.lru(), s += sizeof(Chunk)) {
 		Chunk *cb = static_cast<Chunk*>(e);
-		e = e->next();
-		try {
-			cb->free(Driver<Lru_policy>::CACHE_BLK_SIZE,
-			         cb->base_offset());
-			lru_list.remove(cb);
-		} catch(Chunk::Dirty_chunk &e) {
-			cb->sync(e.size, e.off);
-		}
-	}
 
-	if (!lru_list.first()) lru = 0;
+		/* write back dirty content, the chunk stays queued on failure */
+		cb->sync(Driver<Lru_policy>::CACHE_BLK_SIZE, cb->base_offset());
+
+		/* the chunk gets destroyed by 'free', dequeue it beforehand */
+		lru_queue.remove(*e);
+		e->cached = false;
+		lru_evictions++;
+
+		cb->free(Driver<Lru_policy>::CACHE_BLK_SIZE, cb->base_offset());
+	}
 
 	if (s < size) throw Block::Driver::Request_congestion();
 }
+
+
+void Lru_policy::report(Genode::Xml_generator &xml)
+{
+	xml.attribute("cached",    lru_queue.count());
+	xml.attribute("evictions", lru_evictions);
+}
@@ -11,15 +11,28 @@
  * under the terms of the GNU Affero General Public License version 3.
  */
 
-#include <util/list.h>
+#include <base/allocator.h>
+#include <util/xml_generator.h>
 
 #include "chunk.h"
+#include "queue.h"
 
 struct Lru_policy
 {
-	class Element : public Genode::List<Element>::Element {};
+	class Element : public Cache::Queue<Element>::Element
+	{
+		public:
 
+			bool mutable cached { false };
+	};
+
+	static char const *name() { return "lru"; }
+
+	static void init(Genode::Allocator &, unsigned) { }
+
+	static void fill(const Element  *e);
 	static void read(const Element  *e);
 	static void write(const Element *e);
 	static void flush(Cache::size_t size = 0);
+	static void report(Genode::Xml_generator &xml);
 };
@@ -11,71 +11,140 @@
  * under the terms of the GNU Affero General Public License version 3.
  */
 
+#include <base/attached_rom_dataspace.h>
 #include <base/component.h>
 
 #include "lru.h"
+#include "arc.h"
+#include "two_q.h"
 #include "driver.h"
 
-using Policy = Lru_policy;
-static Driver<Policy> * driver = nullptr;
+static Block::Driver * driver = nullptr;
 
 
 /**
  * Synchronize a chunk with the backend device
  */
 template <typename POLICY>
-void Driver<POLICY>::Policy::sync(const typename POLICY::Element *e, char *dst)
+void Driver<POLICY>::Policy::sync(const typename POLICY::Element *e, char *)
 {
-	Cache::offset_t off =
-		static_cast<const Driver<POLICY>::Chunk_level_4*>(e)->base_offset();
-
-	if (!driver) throw Write_failed(off);
-
-	if (!driver->blk()->tx()->ready_to_submit())
-		throw Write_failed(off);
-	try {
-		Block::Packet_descriptor
-			p(driver->blk()->alloc_packet(Driver::CACHE_BLK_SIZE),
-		      Block::Packet_descriptor::WRITE, off / driver->blk_sz(),
-		      Driver::CACHE_BLK_SIZE / driver->blk_sz());
-		driver->blk()->tx()->submit_packet(p);
-	} catch(Block::Session::Tx::Source::Packet_alloc_failed) {
-		throw Write_failed(off);
-	}
+	Chunk_level_4 &chunk =
+		*const_cast<Chunk_level_4 *>(static_cast<const Chunk_level_4 *>(e));
+
+	if (!driver) throw Write_failed(chunk.base_offset());
+
+	static_cast<Driver<POLICY> *>(driver)->write_back(chunk);
+}
+
+
+/**
+ * Register a chunk that became dirty with the write-back engine
+ */
+template <typename POLICY>
+void Driver<POLICY>::Policy::dirty(const typename POLICY::Element *e)
+{
+	Chunk_level_4 &chunk =
+		*const_cast<Chunk_level_4 *>(static_cast<const Chunk_level_4 *>(e));
+
+	if (driver)
+		static_cast<Driver<POLICY> *>(driver)->mark_dirty(chunk);
 }
 
 
 struct Main
 {
-	template <typename T>
+	enum Policy_type { LRU, ARC, TWO_Q };
+
 	struct Factory : Block::Driver_factory
 	{
-		Genode::Env  &env;
-		Genode::Heap &heap;
+		Genode::Env             &env;
+		Genode::Heap            &heap;
+		Genode::Xml_node  const  config;
+		Policy_type       const  policy;
+
+		Factory(Genode::Env &env, Genode::Heap &heap, Genode::Xml_node config,
+		        Policy_type policy)
+		: env(env), heap(heap), config(config), policy(policy) { }
 
-		Factory(Genode::Env &env, Genode::Heap &heap) : env(env), heap(heap) {}
+		template <typename T>
+		Block::Driver *_create() {
+			return new (&heap) ::Driver<T>(env, heap, config); }
+
+		template <typename T>
+		void _destroy(Block::Driver *driver) {
+			Genode::destroy(&heap, static_cast<::Driver<T>*>(driver)); }
 
 		Block::Driver *create()
 		{
-			driver = new (&heap) ::Driver<T>(env, heap);
+			switch (policy) {
+			case LRU:   driver = _create<Lru_policy>();   break;
+			case ARC:   driver = _create<Arc_policy>();   break;
+			case TWO_Q: driver = _create<Two_q_policy>(); break;
+			}
 			return driver;
 		}
 
-		void destroy(Block::Driver *driver) {
-			Genode::destroy(&heap, static_cast<::Driver<T>*>(driver)); }
+		void destroy(Block::Driver *driver)
+		{
+			switch (policy) {
+			case LRU:   _destroy<Lru_policy>(driver);   break;
+			case ARC:   _destroy<Arc_policy>(driver);   break;
+			case TWO_Q: _destroy<Two_q_policy>(driver); break;
+			}
+			::driver = nullptr;
+		}
 	};
 
 	void resource_handler() { }
 
-	Genode::Env                 &env;
-	Genode::Heap                 heap    { env.ram(), env.rm()     };
-	Factory<Lru_policy>          factory { env, heap               };
-	Block::Root                  root    { env.ep(), heap, env.rm(), factory, true };
+	Genode::Env                    &env;
+	Genode::Heap                    heap    { env.ram(), env.rm()     };
+	Genode::Attached_rom_dataspace  config  { env, "config"           };
+
+	static Policy_type _policy_from_config(Genode::Xml_node config)
+	{
+		typedef Genode::String<8> Name;
+		Name const name = config.attribute_value("policy", Name("lru"));
+
+		if (name == Arc_policy::name())   return ARC;
+		if (name == Two_q_policy::name()) return TWO_Q;
+		if (name != Lru_policy::name())
+			Genode::warning("unknown cache policy '", name, "', using LRU");
+
+		return LRU;
+	}
+
+	/*
+	 * By default, the ghost lists remember as many chunks as fit into the
+	 * RAM quota of the component.
+	 */
+	unsigned _ghost_entries(Genode::Xml_node config)
+	{
+		unsigned const max_chunks = (unsigned)
+			(env.pd().avail_ram().value / ::Driver<Lru_policy>::CACHE_BLK_SIZE);
+
+		return config.attribute_value("ghost_entries", max_chunks);
+	}
+
+	Policy_type const policy { _policy_from_config(config.xml()) };
+
+	Factory factory { env, heap, config.xml(), policy };
+
+	Block::Root root { env.ep(), heap, env.rm(), factory, true };
+
 	Genode::Signal_handler<Main> resource_dispatcher {
 		env.ep(), *this, &Main::resource_handler };
 
 	Main(Genode::Env &env) : env(env)
 	{
+		unsigned const ghost_entries = _ghost_entries(config.xml());
+
+		switch (policy) {
+		case LRU:   Lru_policy  ::init(heap, ghost_entries); break;
+		case ARC:   Arc_policy  ::init(heap, ghost_entries); break;
+		case TWO_Q: Two_q_policy::init(heap, ghost_entries); break;
+		}
+
 		env.parent().announce(env.ep().manage(root));
 		env.parent().resource_avail_sigh(resource_dispatcher);
 	}
@@ -0,0 +1,128 @@
+/*
+ * \brief  Doubly-linked recency queue used by the replacement policies
+ * \author Stefan Kalkowski
+ * \date   2026-10-17
+ *
+ * In contrast to 'Genode::List', elements can be removed from the middle of
+ * the queue in constant time, which is needed whenever a cache hit moves a
+ * chunk from one recency list to another.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _QUEUE_H_
+#define _QUEUE_H_
+
+/* Genode includes */
+#include <util/noncopyable.h>
+
+namespace Cache { template <typename> class Queue; }
+
+
+/**
+ * Recency-ordered queue
+ *
+ * \param QT  queue element type
+ *
+ * The head of the queue is the least-recently used element, new elements
+ * are appended as most-recently used ones.
+ */
+template <typename QT>
+class Cache::Queue : Genode::Noncopyable
+{
+	public:
+
+		class Element
+		{
+			private:
+
+				friend class Queue;
+
+				QT mutable *_prev { nullptr };
+				QT mutable *_next { nullptr };
+
+			public:
+
+				/**
+				 * Return next (more recently used) element
+				 */
+				QT *next() const { return _next; }
+		};
+
+	private:
+
+		QT       *_lru   { nullptr };
+		QT       *_mru   { nullptr };
+		unsigned  _count { 0 };
+
+	public:
+
+		/**
+		 * Return least-recently used element
+		 */
+		QT *lru() const { return _lru; }
+
+		/**
+		 * Return number of queued elements
+		 */
+		unsigned count() const { return _count; }
+
+		bool empty() const { return _count == 0; }
+
+		/**
+		 * Append element as most-recently used
+		 */
+		void enqueue(QT const &e)
+		{
+			QT *le = const_cast<QT *>(&e);
+
+			le->Queue::Element::_prev = _mru;
+			le->Queue::Element::_next = nullptr;
+
+			if (_mru) _mru->Queue::Element::_next = le;
+			else      _lru = le;
+
+			_mru = le;
+			_count++;
+		}
+
+		/**
+		 * Remove element from queue
+		 *
+		 * The caller must make sure that the element is a member of
+		 * this queue.
+		 */
+		void remove(QT const &e)
+		{
+			QT *prev = e.Queue::Element::_prev;
+			QT *next = e.Queue::Element::_next;
+
+			if (prev) prev->Queue::Element::_next = next;
+			else      _lru = next;
+
+			if (next) next->Queue::Element::_prev = prev;
+			else      _mru = prev;
+
+			e.Queue::Element::_prev = nullptr;
+			e.Queue::Element::_next = nullptr;
+			_count--;
+		}
+
+		/**
+		 * Move member element to the most-recently used position
+		 */
+		void touch(QT const &e)
+		{
+			if (&e == _mru) return;
+
+			remove(e);
+			enqueue(e);
+		}
+};
+
+#endif /* _QUEUE_H_ */
@@ -0,0 +1,143 @@
+/*
+ * \brief  Detector for sequential read streams
+ * \author Stefan Kalkowski
+ * \date   2026-10-17
+ *
+ * The detector keeps track of a small number of concurrent read streams of
+ * the client. Once a stream is recognized as sequential, its read-ahead
+ * window grows with each subsequent read until it reaches the configured
+ * maximum. New read ahead is requested as soon as less than half of the
+ * window is left ahead of the reader, so that a streaming reader finds the
+ * chunks already populated when it gets there.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _READ_AHEAD_H_
+#define _READ_AHEAD_H_
+
+/* Genode includes */
+#include <block_session/block_session.h>
+
+namespace Cache { class Read_ahead; }
+
+
+class Cache::Read_ahead
+{
+	public:
+
+		enum { MAX_STREAMS = 4 };
+
+		/**
+		 * Range of blocks to prefetch
+		 */
+		struct Range
+		{
+			Block::sector_t block_number;
+			Genode::size_t  block_count;
+
+			bool valid() const { return block_count > 0; }
+		};
+
+	private:
+
+		struct Stream
+		{
+			Block::sector_t next  { 0 };  /* block expected to be read next */
+			Block::sector_t ahead { 0 };  /* end of requested read ahead */
+			Genode::size_t  window { 0 }; /* read-ahead window in blocks */
+			unsigned        used  { 0 };  /* time stamp of last access */
+		};
+
+		Genode::size_t const _min_window;  /* in blocks */
+		Genode::size_t const _max_window;  /* in blocks */
+
+		Stream   _streams[MAX_STREAMS] { };
+		unsigned _time { 0 };
+
+		Stream &_least_recently_used()
+		{
+			Stream *lru = &_streams[0];
+			for (Stream &s : _streams)
+				if (s.used < lru->used)
+					lru = &s;
+			return *lru;
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param min_window  initial window of a sequential stream in blocks
+		 * \param max_window  maximum window in blocks, 0 disables read ahead
+		 */
+		Read_ahead(Genode::size_t min_window, Genode::size_t max_window)
+		:
+			_min_window(Genode::min(min_window, max_window)),
+			_max_window(max_window)
+		{ }
+
+		bool enabled() const { return _max_window > 0; }
+
+		/**
+		 * Account read access and return range to prefetch
+		 */
+		Range access(Block::sector_t nr, Genode::size_t cnt)
+		{
+			Range none { 0, 0 };
+
+			if (!enabled()) return none;
+
+			_time++;
+
+			/*
+			 * A read continuing a stream may start anywhere within the
+			 * area already requested ahead of the reader.
+			 */
+			for (Stream &s : _streams) {
+
+				if (!s.used || nr < s.next || nr > Genode::max(s.next, s.ahead))
+					continue;
+
+				s.used   = _time;
+				s.next   = nr + cnt;
+				s.window = s.window ? Genode::min(2*s.window, _max_window)
+				                    : _min_window;
+
+				Block::sector_t const target = s.next + s.window;
+
+				/* keep reader and read ahead apart by at least half a window */
+				if (s.ahead > s.next && s.ahead - s.next >= s.window/2)
+					return none;
+
+				Block::sector_t const start = Genode::max(s.ahead, s.next);
+				s.ahead = target;
+
+				return Range { start, (Genode::size_t)(target - start) };
+			}
+
+			/* start tracking a new stream */
+			Stream &s = _least_recently_used();
+			s = Stream { nr + cnt, nr + cnt, 0, _time };
+
+			return none;
+		}
+
+		/**
+		 * Revoke read ahead that could not be issued
+		 */
+		void cancel(Range const &range)
+		{
+			for (Stream &s : _streams)
+				if (s.ahead == range.block_number + range.block_count)
+					s.ahead = range.block_number;
+		}
+};
+
+#endif /* _READ_AHEAD_H_ */
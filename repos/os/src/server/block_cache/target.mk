@@ -1,5 +1,5 @@
 TARGET = block_cache
 LIBS   = base
-SRC_CC = main.cc lru.cc
+SRC_CC = main.cc lru.cc arc.cc two_q.cc
 
 CC_CXX_WARN_STRICT =
@@ -0,0 +1,128 @@
+/*
+ * \brief  2Q cache replacement strategy
+ * \author Stefan Kalkowski
+ * \date   2026-10-17
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#include <util/reconstructible.h>
+
+#include "two_q.h"
+#include "ghost_list.h"
+#include "driver.h"
+
+typedef Driver<Two_q_policy>::Chunk_level_4 Chunk;
+typedef Two_q_policy::Element               Element;
+
+static Cache::Queue<Element>                    a1in, am;
+static Genode::Constructible<Cache::Ghost_list> a1out;
+
+static Genode::uint64_t ghost_hits;
+static Genode::uint64_t evictions;
+
+
+static void two_q_access(Element const *e)
+{
+	switch (e->list) {
+	case Element::AM:
+		am.touch(*e);
+		return;
+
+	case Element::A1IN:
+		/* correlated reference */
+		return;
+
+	case Element::NONE:
+		break;
+	}
+
+	Cache::offset_t const off = static_cast<Chunk const *>(e)->base_offset();
+
+	if (a1out->remove(off)) {
+		ghost_hits++;
+		am.enqueue(*e);
+		e->list = Element::AM;
+		return;
+	}
+
+	a1in.enqueue(*e);
+	e->list = Element::A1IN;
+}
+
+
+/*
+ * Select the queue to reclaim from
+ */
+static Cache::Queue<Element> &two_q_victim_queue()
+{
+	unsigned const cached = a1in.count() + am.count();
+	unsigned const a1in_max =
+		Genode::max(cached*Two_q_policy::A1IN_PERCENT/100, 1U);
+
+	if (am.empty() || a1in.count() > a1in_max)
+		return a1in;
+
+	return am;
+}
+
+
+void Two_q_policy::init(Genode::Allocator &alloc, unsigned ghost_entries) {
+	a1out.construct(alloc, ghost_entries); }
+
+
+void Two_q_policy::fill(const Element *e) {
+	two_q_access(e); }
+
+
+void Two_q_policy::read(const Element *e) {
+	two_q_access(e); }
+
+
+void Two_q_policy::write(const Element *e) {
+	two_q_access(e); }
+
+
+void Two_q_policy::flush(Cache::size_t size)
+{
+	Cache::size_t s = 0;
+	while ((size == 0) || (s < size)) {
+
+		Cache::Queue<Element> &queue = two_q_victim_queue();
+		Element *e = queue.lru();
+		if (!e) break;
+
+		Chunk *cb = static_cast<Chunk*>(e);
+		Cache::offset_t const off = cb->base_offset();
+
+		/* write back dirty content, the chunk stays queued on failure */
+		cb->sync(Driver<Two_q_policy>::CACHE_BLK_SIZE, off);
+
+		/* the chunk gets destroyed by 'free', dequeue it beforehand */
+		queue.remove(*e);
+		if (e->list == Element::A1IN)
+			a1out->insert(off);
+		e->list = Element::NONE;
+		evictions++;
+
+		cb->free(Driver<Two_q_policy>::CACHE_BLK_SIZE, off);
+		s += sizeof(Chunk);
+	}
+
+	if (s < size) throw Block::Driver::Request_congestion();
+}
+
+
+void Two_q_policy::report(Genode::Xml_generator &xml)
+{
+	xml.attribute("a1in",       a1in.count());
+	xml.attribute("am",         am.count());
+	xml.attribute("a1out",      a1out->count());
+	xml.attribute("ghost_hits", ghost_hits);
+	xml.attribute("evictions",  evictions);
+}
@@ -0,0 +1,58 @@
+/*
+ * \brief  2Q cache replacement strategy
+ * \author Stefan Kalkowski
+ * \date   2026-10-17
+ *
+ * Chunks referenced for the first time enter the FIFO 'A1in'. References
+ * while a chunk resides in 'A1in' are considered as correlated and leave
+ * the chunk's position unchanged. Chunks evicted from 'A1in' are remembered
+ * in the ghost list 'A1out'. Only when a chunk is referenced again while
+ * being remembered in 'A1out', it enters the LRU-managed main queue 'Am'.
+ * One-shot scans thereby pass through 'A1in' without touching 'Am'.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _TWO_Q_H_
+#define _TWO_Q_H_
+
+#include <base/allocator.h>
+#include <util/xml_generator.h>
+
+#include "chunk.h"
+#include "queue.h"
+
+struct Two_q_policy
+{
+	class Element : public Cache::Queue<Element>::Element
+	{
+		public:
+
+			enum List { NONE, A1IN, AM };
+
+			List mutable list { NONE };
+	};
+
+	/*
+	 * Share of cached chunks 'A1in' may occupy before it gets reclaimed
+	 * in favour of 'Am'
+	 */
+	enum { A1IN_PERCENT = 25 };
+
+	static char const *name() { return "2q"; }
+
+	static void init(Genode::Allocator &alloc, unsigned ghost_entries);
+
+	static void fill(const Element  *e);
+	static void read(const Element  *e);
+	static void write(const Element *e);
+	static void flush(Cache::size_t size = 0);
+	static void report(Genode::Xml_generator &xml);
+};
+
+#endif /* _TWO_Q_H_ */
@@ -64,6 +64,7 @@ void Arp_cache::new_entry(Ipv4_address const &ip, Mac_address const &mac)
 {
 	if (_entries[_curr].constructed()) {
 		remove(&(*_entries[_curr]));
+		_domain.invalidate_flows();
 	}
 	_entries[_curr].construct(ip, mac);
 	Arp_cache_entry &entry = *_entries[_curr];
@@ -101,6 +102,7 @@ void Arp_cache::destroy_entries_with_mac(Mac_address const &mac)
 			}
 			remove(&entry);
 			_entries[curr].destruct();
+			_domain.invalidate_flows();
 
 		} catch (Arp_cache_entry_slot::Deref_unconstructed_object) { }
 	}
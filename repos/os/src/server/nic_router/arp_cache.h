@@ -77,7 +77,7 @@ class Net::Arp_cache : public Genode::Avl_tree<Arp_cache_entry>
 			NR_OF_ENTRIES = ENTRIES_SIZE / sizeof(Arp_cache_entry),
 		};
 
-		Domain const         &_domain;
+		Domain               &_domain;
 		Arp_cache_entry_slot  _entries[NR_OF_ENTRIES];
 		bool                  _init = true;
 		unsigned              _curr = 0;
@@ -86,7 +86,7 @@ class Net::Arp_cache : public Genode::Avl_tree<Arp_cache_entry>
 
 		struct No_match : Genode::Exception { };
 
-		Arp_cache(Domain const &domain) : _domain(domain) { }
+		Arp_cache(Domain &domain) : _domain(domain) { }
 
 		void new_entry(Ipv4_address const &ip, Mac_address const &mac);
 
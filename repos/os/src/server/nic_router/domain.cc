@@ -65,6 +65,8 @@ void Domain::ip_config(Ipv4_config const &new_ip_config)
 	if (!_ip_config_dynamic) {
 		throw Ip_config_static(); }
 
+	invalidate_flows();
+
 	/* discard old IP config if any */
 	if (ip_config().valid) {
 
@@ -221,7 +223,7 @@ Domain::Domain(Configuration &config, Xml_node const node, Allocator &alloc)
 }
 
 
-Link_side_tree &Domain::links(L3_protocol const protocol)
+Link_side_table &Domain::links(L3_protocol const protocol)
 {
 	switch (protocol) {
 	case L3_protocol::TCP:  return _tcp_links;
@@ -110,10 +110,11 @@ class Net::Domain : public Domain_base,
 		bool                            const _ip_config_dynamic    { !ip_config().valid };
 		List<Domain>                          _ip_config_dependents { };
 		Arp_cache                             _arp_cache            { *this };
+		unsigned                              _flow_generation      { 0 };
 		Arp_waiter_list                       _foreign_arp_waiters  { };
-		Link_side_tree                        _tcp_links            { };
-		Link_side_tree                        _udp_links            { };
-		Link_side_tree                        _icmp_links           { };
+		Link_side_table                       _tcp_links            { };
+		Link_side_table                       _udp_links            { };
+		Link_side_table                       _icmp_links           { };
 		Genode::size_t                        _tx_bytes             { 0 };
 		Genode::size_t                        _rx_bytes             { 0 };
 		bool                            const _verbose_packets;
@@ -173,7 +174,17 @@ class Net::Domain : public Domain_base,
 
 		void try_reuse_ip_config(Domain const &domain);
 
-		Link_side_tree &links(L3_protocol const protocol);
+		/**
+		 * Invalidate cached flows that forward to this domain
+		 *
+		 * Must be called whenever the next hop or its MAC address may
+		 * change, i.e., on changes of the IP config or the ARP cache.
+		 */
+		void invalidate_flows() { _flow_generation++; }
+
+		unsigned flow_generation() const { return _flow_generation; }
+
+		Link_side_table &links(L3_protocol const protocol);
 
 		void attach_interface(Interface &interface);
 
@@ -216,9 +227,9 @@ class Net::Domain : public Domain_base,
 		Dhcp_server                 &dhcp_server();
 		Arp_cache                   &arp_cache()                 { return _arp_cache; }
 		Arp_waiter_list             &foreign_arp_waiters()       { return _foreign_arp_waiters; }
-		Link_side_tree              &tcp_links()                 { return _tcp_links; }
-		Link_side_tree              &udp_links()                 { return _udp_links; }
-		Link_side_tree              &icmp_links()                { return _icmp_links; }
+		Link_side_table             &tcp_links()                 { return _tcp_links; }
+		Link_side_table             &udp_links()                 { return _udp_links; }
+		Link_side_table             &icmp_links()                { return _icmp_links; }
 		Domain_link_stats           &udp_stats()                 { return _udp_stats; }
 		Domain_link_stats           &tcp_stats()                 { return _tcp_stats; }
 		Domain_link_stats           &icmp_stats()                { return _icmp_stats; }
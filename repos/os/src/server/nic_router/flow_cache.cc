@@ -0,0 +1,145 @@
+/*
+ * \brief  Per-interface cache of forwarded UDP/TCP flows
+ * \author Martin Stein
+ * \date   2026-10-17
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <net/internet_checksum.h>
+#include <net/tcp.h>
+#include <net/udp.h>
+
+/* local includes */
+#include <flow_cache.h>
+#include <domain.h>
+
+using namespace Net;
+using namespace Genode;
+
+
+static Link_side const &_remote_side(Link_side const &local_side)
+{
+	Link &link = local_side.link();
+	return local_side.is_client() ? link.server() : link.client();
+}
+
+
+/**********
+ ** Flow **
+ **********/
+
+void Flow::translate(Ethernet_frame &eth,
+                     Ipv4_packet    &ip,
+                     void           *prot_base) const
+{
+	Link_side const &remote_side = _remote_side(*_local_side);
+
+	eth.dst(_dst_mac);
+	ip.src(remote_side.dst_ip());
+	ip.dst(remote_side.src_ip());
+	ip.update_checksum(_ip_icd);
+
+	switch (_protocol) {
+	case L3_protocol::TCP:
+		{
+			Tcp_packet &tcp = *(Tcp_packet *)prot_base;
+			tcp.src_port(remote_side.dst_port());
+			tcp.dst_port(remote_side.src_port());
+			tcp.update_checksum(_prot_icd);
+			return;
+		}
+	case L3_protocol::UDP:
+		{
+			Udp_packet &udp = *(Udp_packet *)prot_base;
+			udp.src_port(remote_side.dst_port());
+			udp.dst_port(remote_side.src_port());
+			udp.update_checksum(_prot_icd);
+			return;
+		}
+	default: return; }
+}
+
+
+/****************
+ ** Flow_cache **
+ ****************/
+
+unsigned Flow_cache::_index(L3_protocol protocol, Link_side_id const &id)
+{
+	return (id.hash() + (unsigned)protocol) & (NR_OF_FLOWS - 1);
+}
+
+
+Flow const *Flow_cache::find(L3_protocol protocol, Link_side_id const &id) const
+{
+	Flow const &flow = _flows[_index(protocol, id)];
+	if (!flow._local_side ||
+	    flow._protocol != protocol ||
+	    !(flow._local_side->id() == id) ||
+	    flow._remote_generation != flow._remote_domain->flow_generation())
+	{
+		return nullptr;
+	}
+	return &flow;
+}
+
+
+void Flow_cache::insert(L3_protocol        protocol,
+                        Link_side   const &local_side,
+                        Domain            &remote_domain,
+                        Mac_address const &dst_mac)
+{
+	if (protocol != L3_protocol::TCP && protocol != L3_protocol::UDP) {
+		return; }
+
+	Link_side const &remote_side = _remote_side(local_side);
+
+	/* the translation swaps the addresses and ports of the remote side */
+	Internet_checksum_diff ip_icd;
+	ip_icd.add_up_diff(remote_side.dst_ip().addr, local_side.src_ip().addr,
+	                   Ipv4_packet::ADDR_LEN);
+	ip_icd.add_up_diff(remote_side.src_ip().addr, local_side.dst_ip().addr,
+	                   Ipv4_packet::ADDR_LEN);
+
+	uint16_t const old_ports[] {
+		host_to_big_endian(local_side.src_port().value),
+		host_to_big_endian(local_side.dst_port().value) };
+
+	uint16_t const new_ports[] {
+		host_to_big_endian(remote_side.dst_port().value),
+		host_to_big_endian(remote_side.src_port().value) };
+
+	Internet_checksum_diff prot_icd = ip_icd;
+	prot_icd.add_up_diff(new_ports, old_ports, sizeof(new_ports));
+
+	Flow &flow = _flows[_index(protocol, local_side.id())];
+	flow._local_side        = &local_side;
+	flow._protocol          = protocol;
+	flow._remote_domain     = &remote_domain;
+	flow._remote_generation = remote_domain.flow_generation();
+	flow._dst_mac           = dst_mac;
+	flow._ip_icd            = ip_icd;
+	flow._prot_icd          = prot_icd;
+}
+
+
+void Flow_cache::evict(L3_protocol protocol, Link_side const &local_side)
+{
+	Flow &flow = _flows[_index(protocol, local_side.id())];
+	if (flow._local_side == &local_side) {
+		flow._local_side = nullptr; }
+}
+
+
+void Flow_cache::flush()
+{
+	for (Flow &flow : _flows) {
+		flow._local_side = nullptr; }
+}
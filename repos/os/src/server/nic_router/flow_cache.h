@@ -0,0 +1,121 @@
+/*
+ * \brief  Per-interface cache of forwarded UDP/TCP flows
+ * \author Martin Stein
+ * \date   2026-10-17
+ *
+ * Each packet that matches an existing link is rewritten according to the
+ * link and forwarded to the domain of the other link side. The flow cache
+ * keeps the outcome of this step for the recently used links of an
+ * interface: the remote domain, the MAC address of the next hop, and the
+ * checksum differences caused by the address and port translation. A packet
+ * that hits the cache is forwarded without looking up the link, the next
+ * hop, and the ARP cache, and its checksums are adapted incrementally
+ * (RFC 1624) instead of being re-calculated over the whole packet.
+ *
+ * The cache is direct-mapped on the hash of the link-side ID. Entries refer
+ * to the local link side and are evicted when the link gets dissolved or
+ * re-assigned. Entries that forward to a domain whose IP config or ARP cache
+ * changed since are detected via a generation counter of the domain. On
+ * reconfiguration, the cache is flushed as a whole.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _FLOW_CACHE_H_
+#define _FLOW_CACHE_H_
+
+/* Genode includes */
+#include <net/ethernet.h>
+#include <net/internet_checksum.h>
+#include <net/ipv4.h>
+
+/* local includes */
+#include <l3_protocol.h>
+
+namespace Net {
+
+	class Domain;
+	class Link_side;
+	struct Link_side_id;
+	class Flow;
+	class Flow_cache;
+}
+
+
+class Net::Flow
+{
+	friend class Flow_cache;
+
+	private:
+
+		Link_side const        *_local_side        { nullptr };
+		L3_protocol             _protocol          { L3_protocol::UDP };
+		Domain                 *_remote_domain     { nullptr };
+		unsigned                _remote_generation { 0 };
+		Mac_address             _dst_mac           { };
+		Internet_checksum_diff  _ip_icd            { };
+		Internet_checksum_diff  _prot_icd          { };
+
+	public:
+
+		/**
+		 * Translate addresses, ports, and checksums of a packet of the flow
+		 */
+		void translate(Ethernet_frame &eth,
+		               Ipv4_packet    &ip,
+		               void           *prot_base) const;
+
+		Link_side   const &local_side()    const { return *_local_side; }
+		Domain            &remote_domain() const { return *_remote_domain; }
+		Mac_address const &dst_mac()       const { return _dst_mac; }
+};
+
+
+class Net::Flow_cache
+{
+	public:
+
+		enum { NR_OF_FLOWS = 128 };
+
+	private:
+
+		Flow _flows[NR_OF_FLOWS] { };
+
+		static unsigned _index(L3_protocol         protocol,
+		                       Link_side_id const &id);
+
+	public:
+
+		/**
+		 * Look up valid flow of a UDP/TCP packet
+		 *
+		 * \return  flow or 'nullptr' if there is no valid cached flow
+		 */
+		Flow const *find(L3_protocol         protocol,
+		                 Link_side_id const &id) const;
+
+		/**
+		 * Cache flow of a link side that forwards to 'remote_domain'
+		 *
+		 * \param dst_mac  MAC address of the next hop in the remote domain
+		 */
+		void insert(L3_protocol        protocol,
+		            Link_side   const &local_side,
+		            Domain            &remote_domain,
+		            Mac_address const &dst_mac);
+
+		/**
+		 * Evict flow of a link side that is going to be dissolved
+		 */
+		void evict(L3_protocol      protocol,
+		           Link_side const &local_side);
+
+		void flush();
+};
+
+#endif /* _FLOW_CACHE_H_ */
@@ -16,6 +16,7 @@
 #include <net/udp.h>
 #include <net/icmp.h>
 #include <net/arp.h>
+#include <net/internet_checksum.h>
 #include <base/quota_guard.h>
 
 /* local includes */
@@ -134,27 +135,27 @@ static void _link_packet(L3_protocol  const  prot,
 }
 
 
-static void _update_checksum(L3_protocol   const prot,
-                             void         *const prot_base,
-                             size_t        const prot_size,
-                             Ipv4_address  const src,
-                             Ipv4_address  const dst,
-                             size_t        const ip_size)
+static void _update_checksums(L3_protocol            const  prot,
+                              void                  *const  prot_base,
+                              Ipv4_packet                  &ip,
+                              Internet_checksum_diff const &ip_icd,
+                              Internet_checksum_diff        prot_icd)
 {
+	ip.update_checksum(ip_icd);
 	switch (prot) {
 	case L3_protocol::TCP:
-		((Tcp_packet *)prot_base)->update_checksum(src, dst, prot_size);
+		prot_icd.add_up_diff(ip_icd);
+		((Tcp_packet *)prot_base)->update_checksum(prot_icd);
 		return;
 	case L3_protocol::UDP:
-		((Udp_packet *)prot_base)->update_checksum(src, dst);
+		prot_icd.add_up_diff(ip_icd);
+		((Udp_packet *)prot_base)->update_checksum(prot_icd);
 		return;
 	case L3_protocol::ICMP:
-		{
-			Icmp_packet &icmp = *(Icmp_packet *)prot_base;
-			icmp.update_checksum(ip_size - sizeof(Ipv4_packet) -
-			                               sizeof(Icmp_packet));
-			return;
-		}
+
+		/* the ICMP checksum does not cover a pseudo IP header */
+		((Icmp_packet *)prot_base)->update_checksum(prot_icd);
+		return;
 	default: throw Interface::Bad_transport_protocol(); }
 }
 
@@ -169,14 +170,15 @@ static Port _dst_port(L3_protocol const prot, void *const prot_base)
 }
 
 
-static void _dst_port(L3_protocol  const prot,
-                      void        *const prot_base,
-                      Port         const port)
+static void _dst_port(L3_protocol             const prot,
+                      void                   *const prot_base,
+                      Port                    const port,
+                      Internet_checksum_diff       &prot_icd)
 {
 	switch (prot) {
-	case L3_protocol::TCP:  (*(Tcp_packet *)prot_base).dst_port(port);  return;
-	case L3_protocol::UDP:  (*(Udp_packet *)prot_base).dst_port(port);  return;
-	case L3_protocol::ICMP: (*(Icmp_packet *)prot_base).query_id(port.value); return;
+	case L3_protocol::TCP:  (*(Tcp_packet *)prot_base).dst_port(port, prot_icd);  return;
+	case L3_protocol::UDP:  (*(Udp_packet *)prot_base).dst_port(port, prot_icd);  return;
+	case L3_protocol::ICMP: (*(Icmp_packet *)prot_base).query_id(port.value, prot_icd); return;
 	default: throw Interface::Bad_transport_protocol(); }
 }
 
@@ -191,14 +193,15 @@ static Port _src_port(L3_protocol const prot, void *const prot_base)
 }
 
 
-static void _src_port(L3_protocol  const prot,
-                      void        *const prot_base,
-                      Port         const port)
+static void _src_port(L3_protocol             const prot,
+                      void                   *const prot_base,
+                      Port                    const port,
+                      Internet_checksum_diff       &prot_icd)
 {
 	switch (prot) {
-	case L3_protocol::TCP:  ((Tcp_packet *)prot_base)->src_port(port);        return;
-	case L3_protocol::UDP:  ((Udp_packet *)prot_base)->src_port(port);        return;
-	case L3_protocol::ICMP: ((Icmp_packet *)prot_base)->query_id(port.value); return;
+	case L3_protocol::TCP:  ((Tcp_packet *)prot_base)->src_port(port, prot_icd);        return;
+	case L3_protocol::UDP:  ((Udp_packet *)prot_base)->src_port(port, prot_icd);        return;
+	case L3_protocol::ICMP: ((Icmp_packet *)prot_base)->query_id(port.value, prot_icd); return;
 	default: throw Interface::Bad_transport_protocol(); }
 }
 
@@ -273,16 +276,11 @@ void Interface::_destroy_link(Link &link)
 }
 
 
-void Interface::_pass_prot(Ethernet_frame       &eth,
-                           Size_guard           &size_guard,
-                           Ipv4_packet          &ip,
-                           L3_protocol    const  prot,
-                           void          *const  prot_base,
-                           size_t         const  prot_size)
+void Interface::_pass_prot(Ethernet_frame &eth,
+                           Size_guard     &size_guard)
 {
 	eth.src(_router_mac);
-	_update_checksum(prot, prot_base, prot_size, ip.src(), ip.dst(), ip.total_length());
-	_pass_ip(eth, size_guard, ip);
+	send(eth, size_guard);
 }
 
 
@@ -424,6 +422,7 @@ void Interface::attach_to_remote_ip_config()
 
 void Interface::_detach_from_domain()
 {
+	_flow_cache.flush();
 	try {
 		detach_from_ip_config();
 		_detach_from_domain_raw();
@@ -525,15 +524,16 @@ void Interface::_adapt_eth(Ethernet_frame          &eth,
 }
 
 
-void Interface::_nat_link_and_pass(Ethernet_frame        &eth,
-                                   Size_guard            &size_guard,
-                                   Ipv4_packet           &ip,
-                                   L3_protocol     const  prot,
-                                   void           *const  prot_base,
-                                   size_t          const  prot_size,
-                                   Link_side_id    const &local_id,
-                                   Domain                &local_domain,
-                                   Domain                &remote_domain)
+void Interface::_nat_link_and_pass(Ethernet_frame                &eth,
+                                   Size_guard                    &size_guard,
+                                   Ipv4_packet                   &ip,
+                                   L3_protocol            const  prot,
+                                   void                  *const  prot_base,
+                                   Link_side_id           const &local_id,
+                                   Domain                        &local_domain,
+                                   Domain                        &remote_domain,
+                                   Internet_checksum_diff        &ip_icd,
+                                   Internet_checksum_diff        &prot_icd)
 {
 	try {
 		Pointer<Port_allocator_guard> remote_port_alloc;
@@ -542,16 +542,17 @@ void Interface::_nat_link_and_pass(Ethernet_frame        &eth,
 			if(_config().verbose()) {
 				log("[", local_domain, "] using NAT rule: ", nat); }
 
-			_src_port(prot, prot_base, nat.port_alloc(prot).alloc());
-			ip.src(remote_domain.ip_config().interface.address);
+			_src_port(prot, prot_base, nat.port_alloc(prot).alloc(), prot_icd);
+			ip.src(remote_domain.ip_config().interface.address, ip_icd);
 			remote_port_alloc = nat.port_alloc(prot);
 		}
 		catch (Nat_rule_tree::No_match) { }
 		Link_side_id const remote_id = { ip.dst(), _dst_port(prot, prot_base),
 		                                 ip.src(), _src_port(prot, prot_base) };
 		_new_link(prot, local_id, remote_port_alloc, remote_domain, remote_id);
+		_update_checksums(prot, prot_base, ip, ip_icd, prot_icd);
 		remote_domain.interfaces().for_each([&] (Interface &interface) {
-			interface._pass_prot(eth, size_guard, ip, prot, prot_base, prot_size);
+			interface._pass_prot(eth, size_guard);
 		});
 	} catch (Port_allocator_guard::Out_of_indices) {
 		switch (prot) {
@@ -909,7 +910,6 @@ void Interface::_handle_icmp_query(Ethernet_frame          &eth,
                                    Packet_descriptor const &pkt,
                                    L3_protocol              prot,
                                    void                    *prot_base,
-                                   size_t                   prot_size,
                                    Domain                  &local_domain)
 {
 	Link_side_id const local_id = { ip.src(), _src_port(prot, prot_base),
@@ -927,18 +927,21 @@ void Interface::_handle_icmp_query(Ethernet_frame          &eth,
 			    " link: ", link);
 		}
 		_adapt_eth(eth, remote_side.src_ip(), pkt, remote_domain);
-		ip.src(remote_side.dst_ip());
-		ip.dst(remote_side.src_ip());
-		_src_port(prot, prot_base, remote_side.dst_port());
-		_dst_port(prot, prot_base, remote_side.src_port());
+		Internet_checksum_diff ip_icd;
+		Internet_checksum_diff prot_icd;
+		ip.src(remote_side.dst_ip(), ip_icd);
+		ip.dst(remote_side.src_ip(), ip_icd);
+		_src_port(prot, prot_base, remote_side.dst_port(), prot_icd);
+		_dst_port(prot, prot_base, remote_side.src_port(), prot_icd);
+		_update_checksums(prot, prot_base, ip, ip_icd, prot_icd);
 
 		remote_domain.interfaces().for_each([&] (Interface &interface) {
-			interface._pass_prot(eth, size_guard, ip, prot, prot_base, prot_size);
+			interface._pass_prot(eth, size_guard);
 		});
 		_link_packet(prot, prot_base, link, client);
 		return;
 	}
-	catch (Link_side_tree::No_match) { }
+	catch (Link_side_table::No_match) { }
 
 	/* try to route via ICMP rules */
 	try {
@@ -950,8 +953,10 @@ void Interface::_handle_icmp_query(Ethernet_frame          &eth,
 
 		Domain &remote_domain = rule.domain();
 		_adapt_eth(eth, local_id.dst_ip, pkt, remote_domain);
-		_nat_link_and_pass(eth, size_guard, ip, prot, prot_base, prot_size,
-		                   local_id, local_domain, remote_domain);
+		Internet_checksum_diff ip_icd;
+		Internet_checksum_diff prot_icd;
+		_nat_link_and_pass(eth, size_guard, ip, prot, prot_base, local_id,
+		                   local_domain, remote_domain, ip_icd, prot_icd);
 
 		return;
 	}
@@ -966,8 +971,7 @@ void Interface::_handle_icmp_error(Ethernet_frame          &eth,
                                    Ipv4_packet             &ip,
                                    Packet_descriptor const &pkt,
                                    Domain                  &local_domain,
-                                   Icmp_packet             &icmp,
-                                   size_t                   icmp_sz)
+                                   Icmp_packet             &icmp)
 {
 	/* drop packet if embedded IP checksum invalid */
 	Ipv4_packet &embed_ip = icmp.data<Ipv4_packet>(size_guard);
@@ -994,21 +998,33 @@ void Interface::_handle_icmp_error(Ethernet_frame          &eth,
 		}
 		/* adapt source and destination of Ethernet frame and IP packet */
 		_adapt_eth(eth, remote_side.src_ip(), pkt, remote_domain);
+		Internet_checksum_diff ip_icd;
 		if (remote_side.dst_ip() == remote_domain.ip_config().interface.address) {
-			ip.src(remote_side.dst_ip());
+			ip.src(remote_side.dst_ip(), ip_icd);
 		}
-		ip.dst(remote_side.src_ip());
+		ip.dst(remote_side.src_ip(), ip_icd);
 
 		/* adapt source and destination of embedded IP and transport packet */
-		embed_ip.src(remote_side.src_ip());
-		embed_ip.dst(remote_side.dst_ip());
-		_src_port(embed_prot, embed_prot_base, remote_side.src_port());
-		_dst_port(embed_prot, embed_prot_base, remote_side.dst_port());
-
-		/* update checksum of both IP headers and the ICMP header */
-		embed_ip.update_checksum();
-		icmp.update_checksum(icmp_sz - sizeof(Icmp_packet));
-		ip.update_checksum();
+		Internet_checksum_diff embed_ip_icd;
+		Internet_checksum_diff icmp_icd;
+		embed_ip.src(remote_side.src_ip(), embed_ip_icd);
+		embed_ip.dst(remote_side.dst_ip(), embed_ip_icd);
+		_src_port(embed_prot, embed_prot_base, remote_side.src_port(), icmp_icd);
+		_dst_port(embed_prot, embed_prot_base, remote_side.dst_port(), icmp_icd);
+
+		/*
+		 * Update checksum of both IP headers and the ICMP header. As the
+		 * embedded packets are ICMP data, the ICMP checksum also covers
+		 * the modified checksum of the embedded IP header.
+		 */
+		Genode::uint16_t const embed_ip_old_sum = host_to_big_endian(embed_ip.checksum());
+		embed_ip.update_checksum(embed_ip_icd);
+		Genode::uint16_t const embed_ip_new_sum = host_to_big_endian(embed_ip.checksum());
+		icmp_icd.add_up_diff(embed_ip_icd);
+		icmp_icd.add_up_diff(&embed_ip_new_sum, &embed_ip_old_sum,
+		                     sizeof(embed_ip_new_sum));
+		icmp.update_checksum(icmp_icd);
+		ip.update_checksum(ip_icd);
 
 		/* send adapted packet to all interfaces of remote domain */
 		remote_domain.interfaces().for_each([&] (Interface &interface) {
@@ -1019,7 +1035,7 @@ void Interface::_handle_icmp_error(Ethernet_frame          &eth,
 			_link_packet(embed_prot, embed_prot_base, link, client); }
 	}
 	/* drop packet if there is no matching link */
-	catch (Link_side_tree::No_match) {
+	catch (Link_side_table::No_match) {
 		throw Drop_packet("no link that matches packet embedded in ICMP error"); }
 }
 
@@ -1053,8 +1069,8 @@ void Interface::_handle_icmp(Ethernet_frame            &eth,
 	/* try to act as ICMP router */
 	switch (icmp.type()) {
 	case Icmp_packet::Type::ECHO_REPLY:
-	case Icmp_packet::Type::ECHO_REQUEST:    _handle_icmp_query(eth, size_guard, ip, pkt, prot, prot_base, prot_size, local_domain); break;
-	case Icmp_packet::Type::DST_UNREACHABLE: _handle_icmp_error(eth, size_guard, ip, pkt, local_domain, icmp, prot_size); break;
+	case Icmp_packet::Type::ECHO_REQUEST:    _handle_icmp_query(eth, size_guard, ip, pkt, prot, prot_base, local_domain); break;
+	case Icmp_packet::Type::DST_UNREACHABLE: _handle_icmp_error(eth, size_guard, ip, pkt, local_domain, icmp); break;
 	default: Drop_packet("unhandled type in ICMP"); }
 }
 
@@ -1115,6 +1131,22 @@ void Interface::_handle_ip(Ethernet_frame          &eth,
 		Link_side_id const local_id = { ip.src(), _src_port(prot, prot_base),
 		                                ip.dst(), _dst_port(prot, prot_base) };
 
+		/* try to route via cached flows of existing UDP/TCP links */
+		if (Flow const *flow = _flow_cache.find(prot, local_id)) {
+			Link &link = flow->local_side().link();
+			bool const client = flow->local_side().is_client();
+			if (_config().verbose()) {
+				log("[", local_domain, "] using cached ", l3_protocol_name(prot),
+				    " link: ", link);
+			}
+			flow->translate(eth, ip, prot_base);
+			eth.src(_router_mac);
+			flow->remote_domain().interfaces().for_each([&] (Interface &interface) {
+				interface.send(eth, size_guard);
+			});
+			_link_packet(prot, prot_base, link, client);
+			return;
+		}
 		/* try to route via existing UDP/TCP links */
 		try {
 			Link_side const &local_side = local_domain.links(prot).find_by_id(local_id);
@@ -1127,18 +1159,22 @@ void Interface::_handle_ip(Ethernet_frame          &eth,
 				    " link: ", link);
 			}
 			_adapt_eth(eth, remote_side.src_ip(), pkt, remote_domain);
-			ip.src(remote_side.dst_ip());
-			ip.dst(remote_side.src_ip());
-			_src_port(prot, prot_base, remote_side.dst_port());
-			_dst_port(prot, prot_base, remote_side.src_port());
+			_flow_cache.insert(prot, local_side, remote_domain, eth.dst());
+			Internet_checksum_diff ip_icd;
+			Internet_checksum_diff prot_icd;
+			ip.src(remote_side.dst_ip(), ip_icd);
+			ip.dst(remote_side.src_ip(), ip_icd);
+			_src_port(prot, prot_base, remote_side.dst_port(), prot_icd);
+			_dst_port(prot, prot_base, remote_side.src_port(), prot_icd);
+			_update_checksums(prot, prot_base, ip, ip_icd, prot_icd);
 
 			remote_domain.interfaces().for_each([&] (Interface &interface) {
-				interface._pass_prot(eth, size_guard, ip, prot, prot_base, prot_size);
+				interface._pass_prot(eth, size_guard);
 			});
 			_link_packet(prot, prot_base, link, client);
 			return;
 		}
-		catch (Link_side_tree::No_match) { }
+		catch (Link_side_table::No_match) { }
 
 		/* try to route via forward rules */
 		if (local_id.dst_ip == local_intf.address) {
@@ -1152,12 +1188,15 @@ void Interface::_handle_ip(Ethernet_frame          &eth,
 				}
 				Domain &remote_domain = rule.domain();
 				_adapt_eth(eth, rule.to_ip(), pkt, remote_domain);
-				ip.dst(rule.to_ip());
+				Internet_checksum_diff ip_icd;
+				Internet_checksum_diff prot_icd;
+				ip.dst(rule.to_ip(), ip_icd);
 				if (!(rule.to_port() == Port(0))) {
-					_dst_port(prot, prot_base, rule.to_port());
+					_dst_port(prot, prot_base, rule.to_port(), prot_icd);
 				}
 				_nat_link_and_pass(eth, size_guard, ip, prot, prot_base,
-				                   prot_size, local_id, local_domain, remote_domain);
+				                   local_id, local_domain, remote_domain, ip_icd,
+				                   prot_icd);
 				return;
 			}
 			catch (Forward_rule_tree::No_match) { }
@@ -1176,8 +1215,10 @@ void Interface::_handle_ip(Ethernet_frame          &eth,
 			}
 			Domain &remote_domain = permit_rule.domain();
 			_adapt_eth(eth, local_id.dst_ip, pkt, remote_domain);
-			_nat_link_and_pass(eth, size_guard, ip, prot, prot_base, prot_size,
-			                   local_id, local_domain, remote_domain);
+			Internet_checksum_diff ip_icd;
+			Internet_checksum_diff prot_icd;
+			_nat_link_and_pass(eth, size_guard, ip, prot, prot_base, local_id,
+			                   local_domain, remote_domain, ip_icd, prot_icd);
 			return;
 		}
 		catch (Transport_rule_list::No_match) { }
@@ -1376,9 +1417,8 @@ void Interface::_handle_arp(Ethernet_frame &eth,
 }
 
 
-void Interface::_handle_pkt()
+void Interface::_handle_pkt(Packet_descriptor const &pkt)
 {
-	Packet_descriptor const pkt = _sink.get_packet();
 	Size_guard size_guard(pkt.size());
 	try {
 		_handle_eth(_sink.packet_content(pkt), size_guard, pkt);
@@ -1391,20 +1431,36 @@ void Interface::_handle_pkt()
 
 void Interface::_ready_to_submit()
 {
+	/*
+	 * Packets are fetched and acknowledged in batches so that the session
+	 * client gets signalled at most once per batch.
+	 */
+	Packet_descriptor pkts[PACKET_BATCH];
 	unsigned long const max_pkts = _config().max_packets_per_signal();
-	if (max_pkts) {
-		for (unsigned long i = 0; _sink.packet_avail(); i++) {
-
-			if (i >= max_pkts) {
-				Signal_transmitter(_sink_submit).submit();
-				break;
-			}
-			_handle_pkt();
+	unsigned long handled = 0;
+
+	_defer_acks = true;
+	for (;;) {
+		unsigned long const max =
+			max_pkts ? Genode::min((unsigned long)PACKET_BATCH, max_pkts - handled)
+			         : (unsigned long)PACKET_BATCH;
+
+		if (!max) {
+			if (_sink.packet_avail()) {
+				Signal_transmitter(_sink_submit).submit(); }
+			break;
 		}
-	} else {
-		while (_sink.packet_avail()) {
-			_handle_pkt(); }
+		unsigned const num_pkts = _sink.get_packets(pkts, max);
+		if (!num_pkts) {
+			break; }
+
+		for (unsigned i = 0; i < num_pkts; i++) {
+			_handle_pkt(pkts[i]); }
+
+		handled += num_pkts;
 	}
+	_defer_acks = false;
+	_flush_acks();
 }
 
 
@@ -1428,8 +1484,11 @@ void Interface::_continue_handle_eth(Domain            const &domain,
 
 void Interface::_ready_to_ack()
 {
-	while (_source.ack_avail()) {
-		_source.release_packet(_source.get_acked_packet()); }
+	Packet_descriptor pkts[PACKET_BATCH];
+	for (unsigned num_pkts; (num_pkts = _source.get_acked_packets(pkts, PACKET_BATCH)); ) {
+		for (unsigned i = 0; i < num_pkts; i++) {
+			_source.release_packet(pkts[i]); }
+	}
 }
 
 
@@ -1868,6 +1927,9 @@ void Interface::_update_own_arp_waiters(Domain &domain)
 
 void Interface::handle_config_1(Configuration &config)
 {
+	/* cached flows may refer to domains of the old configuration */
+	_flow_cache.flush();
+
 	/* update config and policy */
 	_config = config;
 	_policy.handle_config(config);
@@ -1982,8 +2044,26 @@ void Interface::handle_config_3()
 }
 
 
+void Interface::_flush_acks()
+{
+	unsigned const num_acked = _sink.acknowledge_packets(_acks, _num_acks);
+	if (num_acked < _num_acks && _config().verbose()) {
+		log("[", _domain(), "] leak ", _num_acks - num_acked, " packets (sink "
+		    "not ready to acknowledge)");
+	}
+	_num_acks = 0;
+}
+
+
 void Interface::_ack_packet(Packet_descriptor const &pkt)
 {
+	if (_defer_acks) {
+		if (_num_acks == PACKET_BATCH) {
+			_flush_acks(); }
+
+		_acks[_num_acks++] = pkt;
+		return;
+	}
 	if (!_sink.ready_to_ack()) {
 		if (_config().verbose()) {
 			log("[", _domain(), "] leak packet (sink not ready to "
@@ -2015,6 +2095,13 @@ Interface::~Interface()
 {
 	_detach_from_domain();
 	_interfaces.remove(this);
+
+	/* link tables of any domain may have grown on the RAM of the session */
+	_config().domains().for_each([&] (Domain &domain) {
+		domain.tcp_links().release(_alloc);
+		domain.udp_links().release(_alloc);
+		domain.icmp_links().release(_alloc);
+	});
 }
 
 
@@ -22,6 +22,7 @@
 #include <dhcp_server.h>
 #include <list.h>
 #include <report.h>
+#include <flow_cache.h>
 
 /* Genode includes */
 #include <nic_session/nic_session.h>
@@ -110,6 +111,7 @@ class Net::Interface : private Interface_list::Element
 
 		enum { IPV4_TIME_TO_LIVE          = 64 };
 		enum { MAX_FREE_OPS_PER_EMERGENCY = 1024 };
+		enum { PACKET_BATCH               = 32 };
 
 		struct Dismiss_link       : Genode::Exception { };
 		struct Dismiss_arp_waiter : Genode::Exception { };
@@ -159,6 +161,10 @@ class Net::Interface : private Interface_list::Element
 		Interface_link_stats                  _icmp_stats                { };
 		Interface_object_stats                _arp_stats                 { };
 		Interface_object_stats                _dhcp_stats                { };
+		Packet_descriptor                     _acks[PACKET_BATCH]        { };
+		unsigned                              _num_acks                  { 0 };
+		bool                                  _defer_acks                { false };
+		Flow_cache                            _flow_cache                { };
 
 		void _new_link(L3_protocol             const  protocol,
 		               Link_side_id            const &local_id,
@@ -232,7 +238,6 @@ class Net::Interface : private Interface_list::Element
 		                        Packet_descriptor const &pkt,
 		                        L3_protocol              prot,
 		                        void                    *prot_base,
-		                        Genode::size_t           prot_size,
 		                        Domain                  &local_domain);
 
 		void _handle_icmp_error(Ethernet_frame          &eth,
@@ -240,8 +245,7 @@ class Net::Interface : private Interface_list::Element
 		                        Ipv4_packet             &ip,
 		                        Packet_descriptor const &pkt,
 		                        Domain                  &local_domain,
-		                        Icmp_packet             &icmp,
-		                        Genode::size_t           icmp_sz);
+		                        Icmp_packet             &icmp);
 
 		void _handle_icmp(Ethernet_frame            &eth,
 		                  Size_guard                &size_guard,
@@ -258,15 +262,16 @@ class Net::Interface : private Interface_list::Element
 		                Packet_descriptor const &pkt,
 		                Domain                  &remote_domain);
 
-		void _nat_link_and_pass(Ethernet_frame         &eth,
-		                        Size_guard             &size_guard,
-		                        Ipv4_packet            &ip,
-		                        L3_protocol      const  prot,
-		                        void            *const  prot_base,
-		                        Genode::size_t   const  prot_size,
-		                        Link_side_id     const &local_id,
-		                        Domain                 &local_domain,
-		                        Domain                 &remote_domain);
+		void _nat_link_and_pass(Ethernet_frame                &eth,
+		                        Size_guard                    &size_guard,
+		                        Ipv4_packet                   &ip,
+		                        L3_protocol            const  prot,
+		                        void                  *const  prot_base,
+		                        Link_side_id           const &local_id,
+		                        Domain                        &local_domain,
+		                        Domain                        &remote_domain,
+		                        Internet_checksum_diff        &ip_icd,
+		                        Internet_checksum_diff        &prot_icd);
 
 		void _broadcast_arp_request(Ipv4_address const &src_ip,
 		                            Ipv4_address const &dst_ip);
@@ -275,18 +280,17 @@ class Net::Interface : private Interface_list::Element
 		                       Size_guard     &size_guard,
 		                       Domain         &local_domain);
 
-		void _pass_prot(Ethernet_frame         &eth,
-		                Size_guard             &size_guard,
-		                Ipv4_packet            &ip,
-		                L3_protocol      const  prot,
-		                void            *const  prot_base,
-		                Genode::size_t   const  prot_size);
+		/**
+		 * Send packet whose checksums were already adapted to the NAT
+		 */
+		void _pass_prot(Ethernet_frame &eth,
+		                Size_guard     &size_guard);
 
 		void _pass_ip(Ethernet_frame       &eth,
 		              Size_guard           &size_guard,
 		              Ipv4_packet          &ip);
 
-		void _handle_pkt();
+		void _handle_pkt(Packet_descriptor const &pkt);
 
 		void _continue_handle_eth(Domain            const &domain,
 		                          Packet_descriptor const &pkt);
@@ -304,6 +308,8 @@ class Net::Interface : private Interface_list::Element
 
 		void _ack_packet(Packet_descriptor const &pkt);
 
+		void _flush_acks();
+
 		void _send_alloc_pkt(Genode::Packet_descriptor   &pkt,
 		                     void                      * &pkt_base,
 		                     Genode::size_t               pkt_size);
@@ -452,6 +458,7 @@ class Net::Interface : private Interface_list::Element
 		 ***************/
 
 		Configuration    const &config()     const { return _config(); }
+		Genode::Allocator      &alloc()            { return _alloc; }
 		Domain                 &domain()           { return _domain(); }
 		Mac_address      const &router_mac() const { return _router_mac; }
 		Mac_address      const &mac()        const { return _mac; }
@@ -465,6 +472,7 @@ class Net::Interface : private Interface_list::Element
 		Interface_link_stats   &icmp_stats()       { return _icmp_stats; }
 		Interface_object_stats &arp_stats()        { return _arp_stats; }
 		Interface_object_stats &dhcp_stats()       { return _dhcp_stats; }
+		Flow_cache             &flow_cache()       { return _flow_cache; }
 
 		void session_link_state_sigh(Genode::Signal_context_capability sigh);
 };
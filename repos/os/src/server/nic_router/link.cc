@@ -33,6 +33,22 @@ constexpr size_t Link_side_id::data_size()
 }
 
 
+uint32_t Link_side_id::hash() const
+{
+	/* FNV-1a over the identity followed by a final avalanche step */
+	uint8_t const *byte = (uint8_t const *)data_base();
+	uint32_t h = 2166136261u;
+	for (size_t i = 0; i < data_size(); i++) {
+		h ^= byte[i];
+		h *= 16777619u;
+	}
+	h ^= h >> 16;
+	h *= 0x85ebca6bu;
+	h ^= h >> 13;
+	return h;
+}
+
+
 bool Link_side_id::operator == (Link_side_id const &id) const
 {
 	return memcmp(id.data_base(), data_base(), data_size()) == 0;
@@ -103,10 +119,275 @@ Link_side const &Link_side_tree::find_by_id(Link_side_id const &id) const
 }
 
 
+/*********************
+ ** Link_side_table **
+ *********************/
+
+Link_side *Link_side_table::_tombstone()
+{
+	static char tombstone;
+	return (Link_side *)&tombstone;
+}
+
+
+Link_side_table::Table Link_side_table::_alloc_table(size_t     capacity,
+                                                     Allocator &alloc)
+{
+	Table table { };
+	try {
+		if (!alloc.alloc(capacity * sizeof(Slot), (void **)&table.slots)) {
+			return Table { }; }
+	}
+	catch (Out_of_ram)  { return Table { }; }
+	catch (Out_of_caps) { return Table { }; }
+
+	table.capacity = capacity;
+	table.alloc    = &alloc;
+	for (size_t idx = 0; idx < capacity; idx++) {
+		table.slots[idx] = Slot { 0, nullptr }; }
+
+	return table;
+}
+
+
+void Link_side_table::_free_table(Table &table)
+{
+	if (table.slots) {
+		table.alloc->free(table.slots, table.capacity * sizeof(Slot)); }
+
+	table = Table { };
+}
+
+
+void Link_side_table::_move_to_overflow(Table &table)
+{
+	for (size_t idx = 0; idx < table.capacity; idx++) {
+
+		Link_side *side = table.slots[idx].side;
+		if (!side || side == _tombstone()) {
+			continue; }
+
+		_overflow.insert(side);
+		_overflow_count++;
+	}
+	_free_table(table);
+}
+
+
+size_t Link_side_table::_lookup(Table        const &table,
+                                uint32_t            hash,
+                                Link_side_id const &id)
+{
+	if (!table.count) {
+		return ~(size_t)0; }
+
+	for (size_t idx = hash & table.mask(); ; idx = (idx + 1) & table.mask()) {
+
+		Slot const &slot = table.slots[idx];
+		if (!slot.side) {
+			return ~(size_t)0; }
+
+		if (slot.hash == hash && slot.side != _tombstone() &&
+		    slot.side->_id == id)
+		{
+			return idx;
+		}
+	}
+}
+
+
+size_t Link_side_table::_lookup(Table const &table, Link_side const &side)
+{
+	if (!table.count) {
+		return ~(size_t)0; }
+
+	for (size_t idx = side._id.hash() & table.mask(); ;
+	     idx = (idx + 1) & table.mask())
+	{
+		Slot const &slot = table.slots[idx];
+		if (!slot.side) {
+			return ~(size_t)0; }
+
+		if (slot.side == &side) {
+			return idx; }
+	}
+}
+
+
+void Link_side_table::_insert(Table &table, uint32_t hash, Link_side &side)
+{
+	size_t idx = hash & table.mask();
+	while (table.slots[idx].side) {
+		idx = (idx + 1) & table.mask(); }
+
+	table.slots[idx] = Slot { hash, &side };
+	table.count++;
+}
+
+
+void Link_side_table::_erase(Table &table, size_t idx)
+{
+	/*
+	 * Shift succeeding entries of the probe sequence backwards instead of
+	 * leaving a tombstone, so that the current table never degrades
+	 */
+	size_t hole = idx;
+	for (size_t next = (idx + 1) & table.mask(); table.slots[next].side;
+	     next = (next + 1) & table.mask())
+	{
+		size_t const home = table.slots[next].hash & table.mask();
+
+		/* entry may move to the hole if its home is not in (hole, next] */
+		bool const movable = hole <= next ? (home <= hole || home > next)
+		                                  : (home <= hole && home > next);
+		if (movable) {
+			table.slots[hole] = table.slots[next];
+			hole = next;
+		}
+	}
+	table.slots[hole] = Slot { 0, nullptr };
+	table.count--;
+}
+
+
+void Link_side_table::_migrate(size_t slots)
+{
+	for (; slots && _migrated < _prev.capacity; slots--, _migrated++) {
+
+		Slot &slot = _prev.slots[_migrated];
+		if (!slot.side || slot.side == _tombstone()) {
+			continue; }
+
+		_insert(_curr, slot.hash, *slot.side);
+		slot.side = _tombstone();
+		_prev.count--;
+	}
+	if (_prev.slots && _migrated == _prev.capacity) {
+		_free_table(_prev);
+		_migrated = 0;
+	}
+	/* move link sides that did not fit into the table back into it */
+	for (; slots && _overflow_count && !_prev.slots &&
+	       (_curr.count + 1) * 4 <= _curr.capacity * 3; slots--)
+	{
+		Link_side &side = *_overflow.first();
+		_overflow.remove(&side);
+		_overflow_count--;
+		_insert(_curr, side._id.hash(), side);
+	}
+}
+
+
+void Link_side_table::_resize(size_t capacity, Allocator &alloc)
+{
+	/* only one table can be drained at a time */
+	_migrate(_prev.capacity);
+
+	Table table = _alloc_table(capacity, alloc);
+	if (!table.slots) {
+		return; }
+
+	_prev     = _curr;
+	_curr     = table;
+	_migrated = 0;
+	_migrate(MIGRATE_STEP);
+}
+
+
+Link_side_table::~Link_side_table()
+{
+	_free_table(_prev);
+	_free_table(_curr);
+}
+
+
+void Link_side_table::insert(Link_side *side, Allocator &alloc)
+{
+	/* keep the load factor of the current table below 3/4 */
+	size_t const count = _curr.count + _prev.count + _overflow_count + 1;
+	if (count * 4 > _curr.capacity * 3) {
+
+		size_t capacity = max(_curr.capacity * 2, (size_t)MIN_CAPACITY);
+		while (count * 4 > capacity * 3) {
+			capacity *= 2; }
+
+		_resize(capacity, alloc);
+	}
+
+	if (_curr.count + 1 < _curr.capacity) {
+		_insert(_curr, side->_id.hash(), *side);
+		_migrate(MIGRATE_STEP);
+		return;
+	}
+	/* the table could not grow */
+	_overflow.insert(side);
+	_overflow_count++;
+}
+
+
+void Link_side_table::remove(Link_side *side)
+{
+	size_t idx = _lookup(_curr, *side);
+	if (idx != ~(size_t)0) {
+		_erase(_curr, idx);
+		_migrate(MIGRATE_STEP);
+		return;
+	}
+	idx = _lookup(_prev, *side);
+	if (idx != ~(size_t)0) {
+		_prev.slots[idx].side = _tombstone();
+		_prev.count--;
+		_migrate(MIGRATE_STEP);
+		return;
+	}
+	_overflow.remove(side);
+	_overflow_count--;
+}
+
+
+void Link_side_table::release(Allocator &alloc)
+{
+	if (_curr.alloc != &alloc && _prev.alloc != &alloc) {
+		return; }
+
+	/* the table that is being drained cannot remain without successor */
+	_move_to_overflow(_prev);
+	_move_to_overflow(_curr);
+	_migrated = 0;
+}
+
+
+Link_side const &Link_side_table::find_by_id(Link_side_id const &id) const
+{
+	uint32_t const hash = id.hash();
+
+	size_t idx = _lookup(_curr, hash, id);
+	if (idx != ~(size_t)0) {
+		return *_curr.slots[idx].side; }
+
+	idx = _lookup(_prev, hash, id);
+	if (idx != ~(size_t)0) {
+		return *_prev.slots[idx].side; }
+
+	if (_overflow_count) {
+		try { return _overflow.find_by_id(id); }
+		catch (Link_side_tree::No_match) { }
+	}
+	throw No_match();
+}
+
+
 /**********
  ** Link **
  **********/
 
+static void _evict_flows(L3_protocol const protocol, Link_side const &side)
+{
+	side.domain().interfaces().for_each([&] (Net::Interface &interface) {
+		interface.flow_cache().evict(protocol, side); });
+}
+
+
 void Link::print(Output &output) const
 {
 	Genode::print(output, "CLN ", _client, " SRV ", _server);
@@ -137,8 +418,8 @@ Link::Link(Interface                     &cln_interface,
 {
 	_stats_curr()++;
 	_client_interface.links(_protocol).insert(this);
-	_client.domain().links(_protocol).insert(&_client);
-	_server.domain().links(_protocol).insert(&_server);
+	_client.domain().links(_protocol).insert(&_client, cln_interface.alloc());
+	_server.domain().links(_protocol).insert(&_server, cln_interface.alloc());
 	_dissolve_timeout.schedule(_dissolve_timeout_us);
 }
 
@@ -168,6 +449,8 @@ void Link::dissolve(bool timeout)
 	}
 	_stats_curr()++;
 
+	_evict_flows(_protocol, _client);
+	_evict_flows(_protocol, _server);
 	_client.domain().links(_protocol).remove(&_client);
 	_server.domain().links(_protocol).remove(&_server);
 	if (_config().verbose()) {
@@ -201,6 +484,8 @@ void Link::handle_config(Domain                        &cln_domain,
 	_dissolve_timeout_us = dissolve_timeout_us;
 	_dissolve_timeout.schedule(_dissolve_timeout_us);
 
+	_evict_flows(_protocol, _client);
+	_evict_flows(_protocol, _server);
 	_client.domain().links(_protocol).remove(&_client);
 	_server.domain().links(_protocol).remove(&_server);
 
@@ -209,8 +494,8 @@ void Link::handle_config(Domain                        &cln_domain,
 	_server._domain    = srv_domain;
 	_server_port_alloc = srv_port_alloc;
 
-	cln_domain.links(_protocol).insert(&_client);
-	srv_domain.links(_protocol).insert(&_server);
+	cln_domain.links(_protocol).insert(&_client, _client_interface.alloc());
+	srv_domain.links(_protocol).insert(&_server, _client_interface.alloc());
 
 	if (config.verbose()) {
 		log("[", cln_domain, "] update link client: ", _client);
@@ -34,6 +34,7 @@
 #include <timer_session/connection.h>
 #include <util/avl_tree.h>
 #include <util/list.h>
+#include <util/noncopyable.h>
 #include <net/ipv4.h>
 #include <net/port.h>
 
@@ -54,6 +55,7 @@ namespace Net {
 	class  Link_side_id;
 	class  Link_side;
 	class  Link_side_tree;
+	class  Link_side_table;
 	class  Link;
 	struct Link_list : List<Link> { };
 	class  Tcp_link;
@@ -73,6 +75,8 @@ struct Net::Link_side_id
 
 	void *data_base() const { return (void *)&src_ip; }
 
+	Genode::uint32_t hash() const;
+
 
 	/************************
 	 ** Standard operators **
@@ -88,6 +92,7 @@ __attribute__((__packed__));
 class Net::Link_side : public Genode::Avl_node<Link_side>
 {
 	friend class Link;
+	friend class Link_side_table;
 
 	private:
 
@@ -126,6 +131,7 @@ class Net::Link_side : public Genode::Avl_node<Link_side>
 
 		Domain             &domain()    const { return _domain(); }
 		Link               &link()      const { return _link; }
+		Link_side_id const &id()        const { return _id; }
 		Ipv4_address const &src_ip()    const { return _id.src_ip; }
 		Ipv4_address const &dst_ip()    const { return _id.dst_ip; }
 		Port                src_port()  const { return _id.src_port; }
@@ -141,6 +147,105 @@ struct Net::Link_side_tree : Genode::Avl_tree<Link_side>
 };
 
 
+/**
+ * Per-domain index of the link sides of one transport protocol
+ *
+ * The link sides are kept in an open-addressing hash table with linear
+ * probing. When the table becomes too full, a table of twice the size is
+ * allocated and the entries of the old table are moved over in small steps
+ * with each subsequent insertion or removal, so that no single packet pays
+ * for rehashing all links. Until the old table is drained, lookups consult
+ * both tables. If the table cannot grow for lack of RAM, link sides are
+ * stored in an AVL tree as fallback.
+ *
+ * A table is allocated from the RAM quota of the session whose link
+ * creation made it grow. When the session closes, the entries of its
+ * tables are moved to the AVL tree, from where subsequent insertions and
+ * removals move them back into a table allocated by another session.
+ */
+class Net::Link_side_table : Genode::Noncopyable
+{
+	public:
+
+		struct No_match : Genode::Exception { };
+
+	private:
+
+		enum {
+			MIN_CAPACITY = 64,
+			MIGRATE_STEP = 4,   /* old slots moved per insert or remove */
+		};
+
+		struct Slot
+		{
+			Genode::uint32_t  hash;
+			Link_side        *side;
+		};
+
+		struct Table
+		{
+			Slot              *slots    { nullptr };
+			Genode::size_t     capacity { 0 };       /* power of two */
+			Genode::size_t     count    { 0 };       /* valid entries */
+			Genode::Allocator *alloc    { nullptr }; /* owning session */
+
+			Genode::size_t mask() const { return capacity - 1; }
+		};
+
+		Table          _curr     { };
+		Table          _prev     { };  /* table that is being drained */
+		Genode::size_t _migrated { 0 };  /* drained slots of '_prev' */
+		Link_side_tree _overflow { };
+		Genode::size_t _overflow_count { 0 };
+
+		static Link_side *_tombstone();
+
+		static Table _alloc_table(Genode::size_t     capacity,
+		                          Genode::Allocator &alloc);
+
+		static void _free_table(Table &table);
+
+		void _move_to_overflow(Table &table);
+
+		static Genode::size_t _lookup(Table              const &table,
+		                              Genode::uint32_t          hash,
+		                              Link_side_id       const &id);
+
+		static Genode::size_t _lookup(Table const &table, Link_side const &side);
+
+		static void _insert(Table &table, Genode::uint32_t hash, Link_side &side);
+
+		static void _erase(Table &table, Genode::size_t idx);
+
+		void _migrate(Genode::size_t slots);
+
+		void _resize(Genode::size_t capacity, Genode::Allocator &alloc);
+
+	public:
+
+		Link_side_table() { }
+
+		~Link_side_table();
+
+		/**
+		 * Insert link side
+		 *
+		 * \param alloc  quota-accounted allocator of the session that
+		 *               creates the link, used if the table must grow
+		 */
+		void insert(Link_side *side, Genode::Allocator &alloc);
+
+		/**
+		 * Stop using the memory of a session that is about to close
+		 */
+		void release(Genode::Allocator &alloc);
+
+		void remove(Link_side *side);
+
+		Link_side const &find_by_id(Link_side_id const &id) const;
+};
+
+
 class Net::Link : public Link_list::Element
 {
 	protected:
@@ -50,6 +50,8 @@ struct Nitpicker::Background : private Texture_base, View_component
 	int  frame_size(Focus const &) const override { return 0; }
 	void frame(Canvas_base &, Focus const &) const override { }
 
+	Rect opaque_geometry() const override { return abs_geometry(); }
+
 	void draw(Canvas_base &canvas, Font const &, Focus const &) const override
 	{
 		Rect const view_rect = abs_geometry();
@@ -31,6 +31,7 @@
 #include "clip_guard.h"
 #include "pointer_origin.h"
 #include "domain_registry.h"
+#include "tiled_renderer.h"
 
 namespace Nitpicker {
 	template <typename> class Root;
@@ -369,12 +370,39 @@ struct Nitpicker::Main : Focus_updater
 	 */
 	bool _motion_activity = false;
 
+	/*
+	 * Optional renderer that distributes the redraw over multiple CPUs
+	 */
+	unsigned _render_threads = 1;
+
+	Constructible<Tiled_renderer> _tiled_renderer { };
+
 	/**
 	 * Perform redraw and flush pixels to the framebuffer
 	 */
 	void _draw_and_flush()
 	{
-		_view_stack.draw(_fb_screen->screen, _font).flush([&] (Rect const &rect) {
+		Dirty_rect dirty { };
+
+		if (_tiled_renderer.constructed()) {
+
+			dirty = _view_stack.flush_dirty_rect();
+
+			_tiled_renderer->render(dirty, _fb_screen->size, _font,
+			                        [&] (Rect const &rect, Font const &font) {
+
+				/* the canvas holds the clipping state, use one per thread */
+				Canvas<PT> canvas { _fb_screen->fb_ds.local_addr<PT>(),
+				                    _fb_screen->size };
+
+				_view_stack.draw(canvas, font, rect);
+			});
+
+		} else {
+			dirty = _view_stack.draw(_fb_screen->screen, _font);
+		}
+
+		dirty.flush([&] (Rect const &rect) {
 			_framebuffer.refresh(rect.x1(), rect.y1(),
 			                     rect.w(),  rect.h()); });
 	}
@@ -480,9 +508,7 @@ void Nitpicker::Main::_handle_input()
 		_view_stack.geometry(_pointer_origin, Rect(_user_state.pointer_pos(), Area()));
 
 	/* perform redraw and flush pixels to the framebuffer */
-	_view_stack.draw(_fb_screen->screen, _font).flush([&] (Rect const &rect) {
-		_framebuffer.refresh(rect.x1(), rect.y1(),
-		                     rect.w(),  rect.h()); });
+	_draw_and_flush();
 
 	_view_stack.mark_all_views_as_clean();
 
@@ -589,6 +615,19 @@ void Nitpicker::Main::_handle_config()
 	/* disable builtin focus handling when using an external focus policy */
 	_user_state.focus_via_click(!_focus_rom.constructed());
 
+	/* (re-)create the worker threads of the tiled renderer */
+	unsigned const render_threads = config.attribute_value("render_threads", 1U);
+	if (render_threads != _render_threads) {
+
+		_render_threads = render_threads;
+
+		_tiled_renderer.destruct();
+
+		if (render_threads > 1)
+			_tiled_renderer.construct(_env, render_threads,
+			                          _binary_default_tff_start);
+	}
+
 	/* redraw */
 	_view_stack.update_all_views();
 
@@ -0,0 +1,276 @@
+/*
+ * \brief  Renderer that distributes the drawing of dirty areas over threads
+ * \author Norman Feske
+ * \date   2026-10-17
+ *
+ * The screen is partitioned into tiles that span the whole screen width.
+ * The entrypoint and a pool of worker threads, each pinned to a CPU of its
+ * own, pick the tiles that intersect with the dirty areas one by one and
+ * draw the intersection. Because the tiles are disjoint, no two threads
+ * ever draw the same pixel, which would break the blending of views with
+ * an alpha channel.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _TILED_RENDERER_H_
+#define _TILED_RENDERER_H_
+
+/* Genode includes */
+#include <base/thread.h>
+#include <base/semaphore.h>
+#include <cpu/atomic.h>
+#include <nitpicker_gfx/tff_font.h>
+
+/* local includes */
+#include "view_component.h"
+
+namespace Nitpicker { class Tiled_renderer; }
+
+
+class Nitpicker::Tiled_renderer : Noncopyable
+{
+	public:
+
+		/**
+		 * Interface for drawing a part of a tile
+		 *
+		 * The 'paint' method is called by multiple threads at the same time
+		 * with disjoint rectangles. Each thread passes a font of its own.
+		 */
+		struct Tile_painter : Interface
+		{
+			virtual void paint(Rect, Font const &) = 0;
+		};
+
+	private:
+
+		enum {
+			TILE_HEIGHT = 64,
+			STACK_SIZE  = 64*1024,
+			MAX_WORKERS = 15,
+
+			/* dirty areas smaller than this number of pixels are not distributed */
+			MIN_PIXELS  = 256*256,
+		};
+
+		struct Job
+		{
+			Dirty_rect const &dirty;
+			Tile_painter     &painter;
+			unsigned    const width;
+			int         const num_tiles;
+			int         const first_tile;
+
+			int volatile next = 0;
+
+			Job(Dirty_rect const &dirty, Tile_painter &painter, unsigned width,
+			    int first_tile, int last_tile)
+			:
+				dirty(dirty), painter(painter), width(width),
+				num_tiles(last_tile - first_tile + 1), first_tile(first_tile)
+			{ }
+
+			/**
+			 * Return index of next unprocessed tile, or -1 if none is left
+			 */
+			int claim()
+			{
+				for (;;) {
+					int const i = next;
+					if (i >= num_tiles)
+						return -1;
+
+					if (cmpxchg(&next, i, i + 1))
+						return first_tile + i;
+				}
+			}
+		};
+
+		/**
+		 * Draw tiles until all tiles of the job are claimed
+		 */
+		static void _work(Job &job, Font const &font)
+		{
+			for (int tile; (tile = job.claim()) >= 0; ) {
+
+				Rect const tile_rect(Point(0, tile*TILE_HEIGHT),
+				                     Area(job.width, TILE_HEIGHT));
+
+				job.dirty.for_each_rect([&] (Rect const &rect) {
+					Rect const r = Rect::intersect(rect, tile_rect);
+					if (r.valid())
+						job.painter.paint(r, font); });
+			}
+		}
+
+		Job      *_job  = nullptr;
+		bool      _exit = false;
+		Semaphore _start { };
+		Semaphore _done  { };
+
+		struct Worker : Thread
+		{
+			Tiled_renderer &_renderer;
+
+			/* the glyph buffer of a font cannot be shared between threads */
+			Tff_font::Static_glyph_buffer<4096> _glyph_buffer { };
+
+			Tff_font const _font;
+
+			Worker(Env &env, Location location, Tiled_renderer &renderer,
+			       void const *tff)
+			:
+				Thread(env, Name("render"), STACK_SIZE, location, Weight(), env.cpu()),
+				_renderer(renderer), _font(tff, _glyph_buffer)
+			{
+				start();
+			}
+
+			void entry() override
+			{
+				for (;;) {
+					_renderer._start.down();
+
+					if (_renderer._exit)
+						return;
+
+					_work(*_renderer._job, _font);
+
+					_renderer._done.up();
+				}
+			}
+		};
+
+		unsigned const _num_workers;
+
+		Constructible<Worker> _workers[MAX_WORKERS];
+
+		static unsigned _init_num_workers(Env &env, unsigned num_threads)
+		{
+			unsigned const num_cpus = env.cpu().affinity_space().total();
+
+			return min(min(num_threads, num_cpus), (unsigned)MAX_WORKERS + 1) - 1;
+		}
+
+		void _render(Dirty_rect const &dirty, Area size, Font const &font,
+		             Tile_painter &painter)
+		{
+			Rect const screen(Point(0, 0), size);
+
+			/* determine number of dirty pixels and vertical range of tiles */
+			size_t pixels = 0;
+			int    y1     = size.h(), y2 = -1;
+
+			dirty.for_each_rect([&] (Rect const &rect) {
+				Rect const r = Rect::intersect(rect, screen);
+				if (!r.valid())
+					return;
+
+				pixels += r.area().count();
+				y1      = min(y1, r.y1());
+				y2      = max(y2, r.y2());
+			});
+
+			if (!pixels)
+				return;
+
+			/* draw small areas without the overhead of waking up the workers */
+			if (pixels < MIN_PIXELS || !_num_workers) {
+				dirty.for_each_rect([&] (Rect const &rect) {
+					Rect const r = Rect::intersect(rect, screen);
+					if (r.valid())
+						painter.paint(r, font); });
+				return;
+			}
+
+			Job job(dirty, painter, size.w(), y1/TILE_HEIGHT, y2/TILE_HEIGHT);
+
+			_job = &job;
+
+			for (unsigned i = 0; i < _num_workers; i++)
+				_start.up();
+
+			/* the calling thread draws tiles too */
+			_work(job, font);
+
+			for (unsigned i = 0; i < _num_workers; i++)
+				_done.down();
+
+			_job = nullptr;
+		}
+
+		/*
+		 * Noncopyable
+		 */
+		Tiled_renderer(Tiled_renderer const &);
+		Tiled_renderer &operator = (Tiled_renderer const &);
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param num_threads  number of threads that draw, including the
+		 *                     calling thread, limited by the number of CPUs
+		 * \param tff          font data used by the worker threads
+		 */
+		Tiled_renderer(Env &env, unsigned num_threads, void const *tff)
+		:
+			_num_workers(_init_num_workers(env, num_threads))
+		{
+			Affinity::Space space = env.cpu().affinity_space();
+
+			/* the calling thread is expected to run on the first CPU */
+			for (unsigned i = 0; i < _num_workers; i++)
+				_workers[i].construct(env, space.location_of_index(i + 1),
+				                      *this, tff);
+		}
+
+		~Tiled_renderer()
+		{
+			_exit = true;
+
+			for (unsigned i = 0; i < _num_workers; i++)
+				_start.up();
+
+			for (unsigned i = 0; i < _num_workers; i++) {
+				_workers[i]->join();
+				_workers[i].destruct();
+			}
+		}
+
+		/**
+		 * Draw dirty areas
+		 *
+		 * \param size  screen size
+		 * \param font  font used by the calling thread
+		 * \param fn    functor called with a 'Rect' and a 'Font const &'
+		 *              for drawing a part of the dirty areas
+		 *
+		 * The method returns once all dirty areas are drawn.
+		 */
+		template <typename FN>
+		void render(Dirty_rect const &dirty, Area size, Font const &font,
+		            FN const &fn)
+		{
+			struct Painter : Tile_painter
+			{
+				FN const &fn;
+
+				Painter(FN const &fn) : fn(fn) { }
+
+				void paint(Rect rect, Font const &font) override { fn(rect, font); }
+
+			} painter(fn);
+
+			_render(dirty, size, font, painter);
+		}
+};
+
+#endif /* _TILED_RENDERER_H_ */
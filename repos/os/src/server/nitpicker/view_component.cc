@@ -178,6 +178,24 @@ int View_component::frame_size(Focus const &focus) const
 }
 
 
+Nitpicker::Rect View_component::opaque_geometry() const
+{
+	if (transparent())
+		return Rect();
+
+	Rect const view_rect = abs_geometry();
+
+	/* a view without texture is filled with black */
+	Texture_base const *texture = _owner.texture();
+	if (!texture)
+		return view_rect;
+
+	/* the parts of the view not covered by the texture are left untouched */
+	return Rect::intersect(view_rect, Rect(view_rect.p1() + _buffer_off,
+	                                       texture->size()));
+}
+
+
 bool View_component::transparent() const
 {
 	return _transparent || _owner.uses_alpha();
@@ -30,7 +30,12 @@ namespace Nitpicker {
 	class Buffer;
 	class Focus;
 
-	typedef Dirty_rect<Rect, 3> Dirty_rect;
+	/*
+	 * The number of rectangles is large enough to keep small updates at
+	 * distant screen positions, e.g., a blinking cursor and a clock, apart
+	 * instead of merging them into one huge bounding box.
+	 */
+	typedef Dirty_rect<Rect, 16> Dirty_rect;
 
 	/*
 	 * For each buffer, there is a list of views that belong to this buffer.
@@ -206,6 +211,14 @@ class Nitpicker::View_component : private Same_buffer_list_elem,
 		 */
 		virtual int frame_size(Focus const &) const;
 
+		/**
+		 * Return screen area that is completely covered by the view content
+		 *
+		 * Views behind this area are invisible. The area is invalid if the
+		 * view is transparent.
+		 */
+		virtual Rect opaque_geometry() const;
+
 		/**
 		 * Draw view-surrounding frame on canvas
 		 */
@@ -282,7 +295,7 @@ class Nitpicker::View_component : private Same_buffer_list_elem,
 		/**
 		 * Return dirty-rectangle information
 		 */
-		Dirty_rect dirty_rect() const { return _dirty_rect; }
+		Dirty_rect const &dirty_rect() const { return _dirty_rect; }
 
 		/**
 		 * Reset dirty rectangle
@@ -190,9 +190,13 @@ void View_stack::draw_rec(Canvas_base &canvas, Font const &font,
 	if (next && left.valid()) draw_rec(canvas, font, next, left);
 
 	/* draw current view */
-	view->dirty_rect().flush([&] (Rect const &dirty_rect) {
+	view->dirty_rect().for_each_rect([&] (Rect const &dirty_rect) {
 
-		Clip_guard clip_guard(canvas, Rect::intersect(clipped, dirty_rect));
+		Rect const dirty_clipped = Rect::intersect(clipped, dirty_rect);
+		if (!dirty_clipped.valid())
+			return;
+
+		Clip_guard clip_guard(canvas, dirty_clipped);
 
 		/* draw background if view is transparent */
 		if (view->uses_alpha())
@@ -213,13 +217,55 @@ void View_stack::refresh_view(View_component &view, Rect const rect)
 	/* rectangle constrained to view geometry */
 	Rect const view_rect = Rect::intersect(rect, _outline(view));
 
-	for (View_component *v = _first_view(); v; v = v->view_stack_next())
-		_mark_view_as_dirty(*v, view_rect);
+	_mark_as_dirty(view_rect);
 
 	view.for_each_child([&] (View_component &child) { refresh_view(child, rect); });
 }
 
 
+void View_stack::_mark_visible_as_dirty(View_component const *front,
+                                        View_component const &view, Rect rect)
+{
+	Rect occluded;
+
+	/* find next view in front of 'view' that hides a part of the rectangle */
+	for ( ; front && front != &view
+	     && !(occluded = Rect::intersect(front->opaque_geometry(), rect)).valid(); )
+		front = _next_view(*front);
+
+	/*
+	 * If we hit 'view' or the bottom of the view stack (if 'view' is not
+	 * part of the visible view stack), the rectangle is not hidden.
+	 */
+	if (!front || front == &view) {
+		_mark_as_dirty(rect);
+		return;
+	}
+
+	/* proceed with the parts around the occluded area */
+	Rect r[4];
+	rect.cut(occluded, &r[0], &r[1], &r[2], &r[3]);
+
+	View_component const *next = _next_view(*front);
+	for (int i = 0; i < 4; i++)
+		if (r[i].valid())
+			_mark_visible_as_dirty(next, view, r[i]);
+}
+
+
+void View_stack::_refresh_view_content(View_component &view, Rect const rect)
+{
+	/* rectangle constrained to view geometry */
+	Rect const view_rect = Rect::intersect(rect, _outline(view));
+
+	if (view_rect.valid())
+		_mark_visible_as_dirty(_first_view(), view, view_rect);
+
+	view.for_each_child([&] (View_component &child) {
+		_refresh_view_content(child, rect); });
+}
+
+
 void View_stack::refresh(Rect const rect)
 {
 	for (View_component *v = _first_view(); v; v = v->view_stack_next()) {
@@ -88,6 +88,35 @@ class Nitpicker::View_stack
 			view.mark_as_dirty(rect);
 		}
 
+		/**
+		 * Schedule 'rect' to be redrawn for all views
+		 */
+		void _mark_as_dirty(Rect rect)
+		{
+			_dirty_rect.mark_as_dirty(rect);
+
+			for (View_component *v = _first_view(); v; v = v->view_stack_next())
+				v->mark_as_dirty(rect);
+		}
+
+		/**
+		 * Schedule the parts of 'rect' to be redrawn that are not hidden
+		 * behind an opaque view in front of 'view'
+		 *
+		 * \param front  first view of the view stack to consider as occluder
+		 */
+		void _mark_visible_as_dirty(View_component const *front,
+		                            View_component const &view, Rect rect);
+
+		/**
+		 * Refresh the visible part of the content of a view
+		 *
+		 * In contrast to 'refresh_view', the refresh is limited to the parts
+		 * of the view that are not occluded. This is appropriate if only the
+		 * buffer content changed but not the view stack.
+		 */
+		void _refresh_view_content(View_component &view, Rect);
+
 	public:
 
 		/**
@@ -117,6 +146,17 @@ class Nitpicker::View_stack
 		 */
 		void draw_rec(Canvas_base &, Font const &, View_component const *, Rect) const;
 
+		/**
+		 * Draw views within the specified area
+		 *
+		 * The method does not modify the view stack. Hence, it may be called
+		 * by multiple threads for disjoint areas at the same time.
+		 */
+		void draw(Canvas_base &canvas, Font const &font, Rect rect) const
+		{
+			draw_rec(canvas, font, _first_view(), rect);
+		}
+
 		/**
 		 * Draw dirty areas
 		 */
@@ -125,7 +165,21 @@ class Nitpicker::View_stack
 			Dirty_rect result = _dirty_rect;
 
 			_dirty_rect.flush([&] (Rect const &rect) {
-				draw_rec(canvas, font, _first_view(), rect); });
+				draw(canvas, font, rect); });
+
+			return result;
+		}
+
+		/**
+		 * Return dirty areas and reset them
+		 *
+		 * The caller is responsible for drawing the returned areas.
+		 */
+		Dirty_rect flush_dirty_rect() const
+		{
+			Dirty_rect result = _dirty_rect;
+
+			_dirty_rect = Dirty_rect();
 
 			return result;
 		}
@@ -175,7 +229,7 @@ class Nitpicker::View_stack
 				                                    rect.p2() + offset),
 				                               view->abs_geometry());
 
-				refresh_view(*view, r);
+				_refresh_view_content(*view, r);
 			}
 		}
 
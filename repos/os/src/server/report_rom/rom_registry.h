@@ -16,7 +16,9 @@
 
 /* Genode includes */
 #include <report_rom/rom_registry.h>
+#include <base/attached_rom_dataspace.h>
 #include <os/session_policy.h>
+#include <util/construct_at.h>
 
 namespace Rom { struct Registry; }
 
@@ -30,7 +32,60 @@ struct Rom::Registry : Registry_for_reader, Registry_for_writer, Genode::Noncopy
 		Genode::Region_map             &_rm;
 		Genode::Attached_rom_dataspace &_config_rom;
 
-		Module_list _modules { };
+		/*
+		 * Modules are kept in a hash table with chained buckets, which
+		 * doubles in size whenever the number of modules exceeds twice the
+		 * number of buckets.
+		 */
+		enum { INITIAL_BUCKETS = 64 };
+
+		unsigned     _num_buckets = INITIAL_BUCKETS;
+		unsigned     _num_modules = 0;
+		Module_list *_buckets     = _alloc_buckets(_num_buckets);
+
+		Module_list *_alloc_buckets(unsigned num)
+		{
+			Module_list * const buckets =
+				(Module_list *)_md_alloc.alloc(num*sizeof(Module_list));
+
+			for (unsigned i = 0; i < num; i++)
+				Genode::construct_at<Module_list>(&buckets[i]);
+
+			return buckets;
+		}
+
+		void _free_buckets(Module_list *buckets, unsigned num) {
+			_md_alloc.free(buckets, num*sizeof(Module_list)); }
+
+		static unsigned _hash(Module::Name const &name)
+		{
+			/* FNV-1a */
+			unsigned h = 2166136261U;
+			for (char const *c = name.string(); *c; c++)
+				h = (h ^ (unsigned char)*c) * 16777619U;
+
+			return h;
+		}
+
+		Module_list &_bucket(Module::Name const &name) {
+			return _buckets[_hash(name) & (_num_buckets - 1)]; }
+
+		void _grow()
+		{
+			Module_list * const old_buckets     = _buckets;
+			unsigned      const old_num_buckets = _num_buckets;
+
+			_buckets      = _alloc_buckets(2*old_num_buckets);
+			_num_buckets *= 2;
+
+			for (unsigned i = 0; i < old_num_buckets; i++)
+				while (Module *m = old_buckets[i].first()) {
+					old_buckets[i].remove(m);
+					_bucket(m->_name).insert(m);
+				}
+
+			_free_buckets(old_buckets, old_num_buckets);
+		}
 
 		struct Read_write_policy : Module::Read_policy, Module::Write_policy
 		{
@@ -62,7 +117,7 @@ struct Rom::Registry : Registry_for_reader, Registry_for_writer, Genode::Noncopy
 
 		Module &_lookup(Module::Name const name)
 		{
-			for (Module *m = _modules.first(); m; m = m->next())
+			for (Module *m = _bucket(name).first(); m; m = m->next())
 				if (m->_has_name(name))
 					return *m;
 
@@ -72,9 +127,13 @@ struct Rom::Registry : Registry_for_reader, Registry_for_writer, Genode::Noncopy
 			/* XXX if we run out of memory, the server will abort */
 
 			Module * const module = new (&_md_alloc)
-				Module(_ram, _rm, name, _read_write_policy, _read_write_policy);
+				Module(_md_alloc, _ram, _rm, name,
+				       _read_write_policy, _read_write_policy);
 
-			_modules.insert(module);
+			if (++_num_modules > 2*_num_buckets)
+				_grow();
+
+			_bucket(name).insert(module);
 			return *module;
 		}
 
@@ -83,7 +142,8 @@ struct Rom::Registry : Registry_for_reader, Registry_for_writer, Genode::Noncopy
 			if (module._in_use())
 				return;
 
-			_modules.remove(&module);
+			_bucket(module._name).remove(&module);
+			_num_modules--;
 			Genode::destroy(&_md_alloc, const_cast<Module *>(&module));
 		}
 
@@ -131,6 +191,12 @@ struct Rom::Registry : Registry_for_reader, Registry_for_writer, Genode::Noncopy
 			throw Service_denied();
 		}
 
+		/*
+		 * Noncopyable
+		 */
+		Registry(Registry const &);
+		Registry &operator = (Registry const &);
+
 	public:
 
 		Registry(Genode::Allocator &md_alloc,
@@ -140,6 +206,8 @@ struct Rom::Registry : Registry_for_reader, Registry_for_writer, Genode::Noncopy
 			_md_alloc(md_alloc), _ram(ram), _rm(rm), _config_rom(config_rom)
 		{ }
 
+		~Registry() { _free_buckets(_buckets, _num_buckets); }
+
 		Module &lookup(Writer &writer, Module::Name const &name) override
 		{
 			Module &module = _lookup(writer, name);
@@ -170,6 +238,19 @@ struct Rom::Registry : Registry_for_reader, Registry_for_writer, Genode::Noncopy
 		{
 			return _release(reader, static_cast<Module &>(module));
 		}
+
+		bool shared_content(Module::Name const &rom_label) override
+		{
+			using namespace Genode;
+
+			try {
+				Session_policy policy(rom_label, _config_rom.xml());
+				return policy.attribute_value("shared", false);
+			}
+			catch (Session_policy::No_policy_defined) { }
+
+			return false;
+		}
 };
 
 #endif /* _ROM_REGISTRY_H_ */
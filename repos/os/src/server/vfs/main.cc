@@ -21,6 +21,7 @@
 #include <base/attached_rom_dataspace.h>
 #include <file_system_session/rpc_object.h>
 #include <root/component.h>
+#include <root/client.h>
 #include <os/session_policy.h>
 #include <base/allocator_guard.h>
 #include <util/fifo.h>
@@ -39,9 +40,12 @@ namespace Vfs_server {
 	class Session_component;
 	class Vfs_env;
 	class Root;
+	class Worker;
+	class Session_router;
 
 	typedef Genode::Fifo<Session_component>         Session_queue;
 	typedef Genode::Entrypoint::Io_progress_handler Io_progress_handler;
+	typedef Genode::String<64>                      Worker_name;
 
 	/**
 	 * Convenience utities for parsing quotas
@@ -749,6 +753,12 @@ class Vfs_server::Session_component : private Session_resources,
 };
 
 
+/**
+ * Root of the sessions served by one VFS instance
+ *
+ * The VFS instance, its sessions, and its I/O progress handling are bound
+ * to the entrypoint of the environment passed to the constructor.
+ */
 class Vfs_server::Root : public Genode::Root_component<Session_component>,
                          private Genode::Entrypoint::Io_progress_handler
 {
@@ -756,11 +766,22 @@ class Vfs_server::Root : public Genode::Root_component<Session_component>,
 
 		Genode::Env &_env;
 
+		/* worker that serves the VFS, invalid for the component entrypoint */
+		Worker_name const _worker;
+
 		Genode::Attached_rom_dataspace _config_rom { _env, "config" };
 
 		Genode::Xml_node vfs_config()
 		{
-			try { return _config_rom.xml().sub_node("vfs"); }
+			try {
+				Genode::Xml_node node = _config_rom.xml();
+				if (_worker.valid()) {
+					node = node.sub_node("worker");
+					while (node.attribute_value("name", Worker_name()) != _worker)
+						node = node.next("worker");
+				}
+				return node.sub_node("vfs");
+			}
 			catch (...) {
 				Genode::error("VFS not configured");
 				_env.parent().exit(~0);
@@ -972,15 +993,251 @@ class Vfs_server::Root : public Genode::Root_component<Session_component>,
 
 	public:
 
-		Root(Genode::Env &env, Genode::Allocator &md_alloc)
+		Root(Genode::Env &env, Genode::Allocator &md_alloc,
+		     Worker_name const &worker = Worker_name())
 		:
 			Root_component<Session_component>(&env.ep().rpc_ep(), &md_alloc),
-			_env(env)
+			_env(env), _worker(worker)
 		{
 			_env.ep().register_io_progress_handler(*this);
 			_config_rom.sigh(_config_handler);
+		}
+};
+
+
+/**
+ * Thread that serves an independent VFS sub-tree
+ *
+ * A '<worker>' node of the configuration hosts a '<vfs>' node of its own.
+ * Sessions that are routed to the worker via the 'worker' attribute of their
+ * policy are processed by the worker thread, so that a slow file system,
+ * e.g., a block-device-backed one, does not delay the sessions of other
+ * sub-trees. The sub-trees do not share any state. Hence, the VFS plugins
+ * need not be thread-safe.
+ */
+class Vfs_server::Worker
+{
+	private:
+
+		enum { STACK_SIZE = 16*1024*sizeof(Genode::addr_t) };
+
+		/**
+		 * Component environment with the entrypoint of the worker
+		 *
+		 * The VFS plugins of the sub-tree register their signal handlers
+		 * at 'env.ep()' and are thereby executed by the worker thread.
+		 */
+		struct Local_env : Genode::Env
+		{
+			Genode::Env &genode_env;
+
+			Genode::Entrypoint local_ep;
+
+			Local_env(Genode::Env &genode_env, Worker_name const &name,
+			          Genode::Affinity::Location location)
+			:
+				genode_env(genode_env),
+				local_ep(genode_env, STACK_SIZE, name.string(), location)
+			{ }
+
+			using Parent      = Genode::Parent;
+			using Affinity    = Genode::Affinity;
+			using Entrypoint  = Genode::Entrypoint;
+			using Region_map  = Genode::Region_map;
+			using Cpu_session = Genode::Cpu_session;
+			using Pd_session  = Genode::Pd_session;
+
+			Parent &parent()                                 override { return genode_env.parent(); }
+			Cpu_session &cpu()                               override { return genode_env.cpu(); }
+			Region_map &rm()                                 override { return genode_env.rm(); }
+			Pd_session &pd()                                 override { return genode_env.pd(); }
+			Entrypoint &ep()                                 override { return local_ep; }
+			Genode::Cpu_session_capability cpu_session_cap() override { return genode_env.cpu_session_cap(); }
+			Genode::Pd_session_capability pd_session_cap()   override { return genode_env.pd_session_cap(); }
+			Genode::Id_space<Parent::Client> &id_space()     override { return genode_env.id_space(); }
+
+			Genode::Session_capability session(Parent::Service_name const &service_name,
+			                                   Parent::Client::Id          id,
+			                                   Parent::Session_args const &session_args,
+			                                   Affinity             const &affinity) override
+			{ return genode_env.session(service_name, id, session_args, affinity); }
+
+			void upgrade(Parent::Client::Id id, Parent::Upgrade_args const &args) override
+			{ return genode_env.upgrade(id, args); }
+
+			void close(Parent::Client::Id id) override { return genode_env.close(id); }
+
+			void exec_static_constructors() override { }
+
+			void reinit(Genode::Native_capability::Raw raw) override {
+				genode_env.reinit(raw); }
+
+			void reinit_main_thread(Genode::Capability<Region_map> &stack_area_rm) override {
+				genode_env.reinit_main_thread(stack_area_rm); }
+		};
+
+		Worker_name const _name;
+
+		Local_env _env;
+
+		Root _root;
+
+		Genode::Root_client _root_client { _env.ep().manage(_root) };
+
+	public:
+
+		Worker(Genode::Env &env, Genode::Allocator &md_alloc,
+		       Worker_name const &name, Genode::Affinity::Location location)
+		:
+			_name(name), _env(env, name, location),
+			_root(_env, md_alloc, name)
+		{ }
+
+		Worker_name const &name() const { return _name; }
+
+		/**
+		 * Return root interface that forwards to the worker thread
+		 */
+		Genode::Root &root() { return _root_client; }
+};
+
+
+/**
+ * Root that routes each session to the root of the VFS sub-tree that the
+ * session policy selects
+ *
+ * Sessions of the top-level '<vfs>' node are served by the component
+ * entrypoint. The set of workers is determined at startup, whereas
+ * configuration updates of each sub-tree are applied at runtime.
+ */
+class Vfs_server::Session_router
+:
+	public Genode::Rpc_object<Genode::Typed_root<::File_system::Session>>
+{
+	private:
+
+		Genode::Env       &_env;
+		Genode::Allocator &_md_alloc;
+
+		Genode::Attached_rom_dataspace _config_rom { _env, "config" };
+
+		Vfs_server::Root _root { _env, _md_alloc };
+
+		Genode::Registry<Genode::Registered_no_delete<Worker>> _workers { };
+
+		struct Route
+		{
+			Genode::Session_capability const cap;
+			Genode::Root                    &root;
+
+			Route(Genode::Session_capability cap, Genode::Root &root)
+			: cap(cap), root(root) { }
+		};
+
+		Genode::Registry<Genode::Registered_no_delete<Route>> _routes { };
+
+		Genode::Root &_root_for_session(Genode::Session_label const &label)
+		{
+			using namespace Genode;
+
+			/* pull in policy changes */
+			_config_rom.update();
+
+			Worker_name name { };
+			try {
+				Session_policy policy(label, _config_rom.xml());
+				name = policy.attribute_value("worker", Worker_name());
+			}
+			/* let the root of the top-level sub-tree deny the session */
+			catch (Session_policy::No_policy_defined) { }
+
+			if (!name.valid())
+				return _root;
+
+			Genode::Root *root = nullptr;
+			_workers.for_each([&] (Worker &worker) {
+				if (worker.name() == name)
+					root = &worker.root(); });
+
+			if (!root) {
+				error("unknown worker '", name, "' in policy for '", label, "'");
+				throw Service_denied();
+			}
+			return *root;
+		}
+
+		template <typename FN>
+		void _with_route(Genode::Session_capability cap, FN const &fn)
+		{
+			_routes.for_each([&] (Genode::Registered_no_delete<Route> &route) {
+				if (route.cap == cap)
+					fn(route); });
+		}
+
+	public:
+
+		Session_router(Genode::Env &env, Genode::Allocator &md_alloc)
+		:
+			_env(env), _md_alloc(md_alloc)
+		{
+			using namespace Genode;
+
+			Affinity::Space space = env.cpu().affinity_space();
+
+			/* leave the first CPU to the component entrypoint if possible */
+			unsigned i = 0;
+			_config_rom.xml().for_each_sub_node("worker", [&] (Xml_node node) {
+
+				Worker_name const name = node.attribute_value("name", Worker_name());
+				if (!name.valid()) {
+					warning("ignoring worker without name");
+					return;
+				}
+
+				Affinity::Location const location = space.location_of_index(
+					space.total() > 1 ? 1 + i++ % (space.total() - 1) : 0);
+
+				new (_md_alloc)
+					Registered_no_delete<Worker>(_workers, _env, _md_alloc,
+					                             name, location);
+			});
+
 			env.parent().announce(env.ep().manage(*this));
 		}
+
+
+		/********************
+		 ** Root interface **
+		 ********************/
+
+		Genode::Session_capability session(Session_args const &args,
+		                                   Genode::Affinity const &affinity) override
+		{
+			using namespace Genode;
+
+			Genode::Root &root = _root_for_session(label_from_args(args.string()));
+
+			Session_capability const cap = root.session(args, affinity);
+
+			try { new (_md_alloc) Registered_no_delete<Route>(_routes, cap, root); }
+			catch (...) { root.close(cap); throw; }
+
+			return cap;
+		}
+
+		void upgrade(Genode::Session_capability cap, Upgrade_args const &args) override
+		{
+			_with_route(cap, [&] (Route &route) {
+				route.root.upgrade(cap, args); });
+		}
+
+		void close(Genode::Session_capability cap) override
+		{
+			_with_route(cap, [&] (Genode::Registered_no_delete<Route> &route) {
+				route.root.close(cap);
+				destroy(_md_alloc, &route);
+			});
+		}
 };
 
 
@@ -988,5 +1245,5 @@ void Component::construct(Genode::Env &env)
 {
 	static Genode::Sliced_heap sliced_heap { env.ram(), env.rm() };
 
-	static Vfs_server::Root root { env, sliced_heap };
+	static Vfs_server::Session_router router { env, sliced_heap };
 }
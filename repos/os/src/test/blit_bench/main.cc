@@ -0,0 +1,156 @@
+/*
+ * \brief  Throughput benchmark of the blit library
+ * \author Norman Feske
+ * \date   2026-10-17
+ *
+ * The benchmark applies each operation of the blit library to a full-HD
+ * surface in RAM and compares the result and the duration with a plain
+ * pixel-wise loop.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/attached_ram_dataspace.h>
+#include <base/component.h>
+#include <base/log.h>
+#include <blit/blit.h>
+#include <timer_session/connection.h>
+
+using namespace Genode;
+
+
+struct Main
+{
+	enum { WIDTH = 1920, HEIGHT = 1080, FRAMES = 20 };
+
+	enum { SIZE_888 = WIDTH*HEIGHT*4, SIZE_565 = WIDTH*HEIGHT*2 };
+
+	Env               &_env;
+	Timer::Connection  _timer { _env };
+
+	Attached_ram_dataspace _src_ds { _env.ram(), _env.rm(), SIZE_888 };
+	Attached_ram_dataspace _dst_ds { _env.ram(), _env.rm(), SIZE_888 };
+	Attached_ram_dataspace _ref_ds { _env.ram(), _env.rm(), SIZE_888 };
+
+	uint32_t * const _src { _src_ds.local_addr<uint32_t>() };
+	uint32_t * const _dst { _dst_ds.local_addr<uint32_t>() };
+	uint32_t * const _ref { _ref_ds.local_addr<uint32_t>() };
+
+	/* RGB565 views of the buffers */
+	uint16_t * const _src_16 { _src_ds.local_addr<uint16_t>() };
+	uint16_t * const _dst_16 { _dst_ds.local_addr<uint16_t>() };
+	uint16_t * const _ref_16 { _ref_ds.local_addr<uint16_t>() };
+
+	template <typename FN>
+	uint64_t _measure_us(FN const &fn)
+	{
+		uint64_t const start_us = _timer.elapsed_us();
+		for (unsigned i = 0; i < FRAMES; i++)
+			fn();
+		return max(_timer.elapsed_us() - start_us, (uint64_t)1)/FRAMES;
+	}
+
+	/**
+	 * Run operation of the blit library and its plain counterpart
+	 */
+	template <typename LIB_FN, typename REF_FN>
+	void _compare(char const *name, size_t size, LIB_FN const &lib_fn,
+	              REF_FN const &ref_fn)
+	{
+		memset(_dst, 0, size);
+		memset(_ref, 0, size);
+
+		uint64_t const lib_us = _measure_us(lib_fn);
+		uint64_t const ref_us = _measure_us(ref_fn);
+
+		if (memcmp(_dst, _ref, size)) {
+			error(name, ": result differs from plain loop");
+			throw -1;
+		}
+
+		log(name, ": ", lib_us, " us per frame (", (size*1000000)/(lib_us*1024*1024),
+		    " MiB/sec), plain loop ", ref_us, " us per frame");
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- blit benchmark ---");
+		log("kernels: ", Blit::kernels());
+
+		unsigned seed = 1;
+		for (unsigned i = 0; i < WIDTH*HEIGHT; i++) {
+			seed = seed*1103515245 + 12345;
+			_src[i] = seed;
+		}
+
+		unsigned const line_888 = WIDTH*4, line_565 = WIDTH*2;
+
+		_compare("copy", SIZE_888,
+			[&] () { blit(_src, line_888, _dst, line_888, line_888, HEIGHT); },
+			[&] () {
+				for (unsigned i = 0; i < WIDTH*HEIGHT; i++)
+					_ref[i] = _src[i]; });
+
+		_compare("rotate 90", SIZE_888,
+			[&] () { Blit::rotate(_src, line_888, _dst, HEIGHT*4, WIDTH, HEIGHT,
+			                      Blit::ROTATE_90); },
+			[&] () {
+				for (unsigned y = 0; y < HEIGHT; y++)
+					for (unsigned x = 0; x < WIDTH; x++)
+						_ref[x*HEIGHT + HEIGHT - 1 - y] = _src[y*WIDTH + x]; });
+
+		_compare("rotate 180", SIZE_888,
+			[&] () { Blit::rotate(_src, line_888, _dst, line_888, WIDTH, HEIGHT,
+			                      Blit::ROTATE_180); },
+			[&] () {
+				for (unsigned i = 0; i < WIDTH*HEIGHT; i++)
+					_ref[WIDTH*HEIGHT - 1 - i] = _src[i]; });
+
+		_compare("rotate 270", SIZE_888,
+			[&] () { Blit::rotate(_src, line_888, _dst, HEIGHT*4, WIDTH, HEIGHT,
+			                      Blit::ROTATE_270); },
+			[&] () {
+				for (unsigned y = 0; y < HEIGHT; y++)
+					for (unsigned x = 0; x < WIDTH; x++)
+						_ref[(WIDTH - 1 - x)*HEIGHT + y] = _src[y*WIDTH + x]; });
+
+		_compare("RGB888 to RGB565", SIZE_565,
+			[&] () { Blit::rgb888_to_rgb565(_src, line_888, _dst_16, line_565,
+			                                WIDTH, HEIGHT); },
+			[&] () {
+				for (unsigned i = 0; i < WIDTH*HEIGHT; i++) {
+					uint32_t const p = _src[i];
+					_ref_16[i] = (uint16_t)(((p >> 8) & 0xf800) | ((p >> 5) & 0x07e0)
+					                      | ((p >> 3) & 0x001f));
+				} });
+
+		_compare("RGB565 to RGB888", SIZE_888,
+			[&] () { Blit::rgb565_to_rgb888(_src_16, line_565, _dst, line_888,
+			                                WIDTH, HEIGHT); },
+			[&] () {
+				for (unsigned i = 0; i < WIDTH*HEIGHT; i++) {
+					uint16_t const p = _src_16[i];
+					_ref[i] = ((p & 0xf800) << 8) | ((p & 0x07e0) << 5)
+					        | ((p & 0x001f) << 3);
+				} });
+
+		log("--- blit benchmark finished ---");
+	}
+
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Main(Main const &);
+		Main &operator = (Main const &);
+};
+
+
+void Component::construct(Env &env) { static Main main(env); }
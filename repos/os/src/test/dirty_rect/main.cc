@@ -0,0 +1,180 @@
+/*
+ * \brief  Test of the dirty-rectangle tracker
+ * \author Norman Feske
+ * \date   2026-10-17
+ *
+ * The test marks random rectangles as dirty and checks that the tracked
+ * rectangles cover all marked pixels and that no pair of tracked rectangles
+ * is worth merging. It also checks that a few small updates at distant
+ * positions, e.g., a blinking cursor and a clock, are not merged into one
+ * huge bounding box.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/log.h>
+#include <util/dirty_rect.h>
+#include <util/geometry.h>
+
+using namespace Genode;
+
+
+struct Main
+{
+	enum { W = 320, H = 240, ROUNDS = 2000, MAX_MARKS = 24 };
+
+	typedef Genode::Point<>                Point;
+	typedef Genode::Area<>                 Area;
+	typedef Genode::Rect<>                 Rect;
+	typedef Genode::Dirty_rect<Rect, 16>   Dirty_rect;
+
+	/* pixels marked as dirty, reset by '_check' */
+	unsigned char _marked[H][W] { };
+
+	unsigned _seed = 1;
+
+	unsigned _random()
+	{
+		_seed = _seed*1103515245 + 12345;
+		return _seed >> 16;
+	}
+
+	Rect _random_rect()
+	{
+		int const x = _random() % W, y = _random() % H;
+
+		/* mostly small rectangles, sometimes large ones */
+		unsigned const max = (_random() % 8) ? 32 : W;
+
+		return Rect::intersect(Rect(Point(0, 0), Area(W, H)),
+		                       Rect(Point(x, y), Area(1 + _random() % max,
+		                                              1 + _random() % max)));
+	}
+
+	void _mark(Dirty_rect &dirty, Rect rect)
+	{
+		dirty.mark_as_dirty(rect);
+
+		for (int y = rect.y1(); y <= rect.y2(); y++)
+			for (int x = rect.x1(); x <= rect.x2(); x++)
+				_marked[y][x] = 1;
+	}
+
+	/**
+	 * Check tracked rectangles and return the number of covered pixels
+	 */
+	size_t _check(Dirty_rect &dirty)
+	{
+		Rect   rects[16];
+		unsigned num = 0;
+		size_t covered = 0;
+
+		dirty.flush([&] (Rect const &rect) {
+			rects[num++] = rect;
+			covered += rect.area().count(); });
+
+		for (unsigned i = 0; i < num; i++) {
+			for (unsigned j = i + 1; j < num; j++) {
+
+				size_t const sum = rects[i].area().count() + rects[j].area().count();
+
+				if (Rect::compound(rects[i], rects[j]).area().count() < sum) {
+					error("rectangles ", rects[i], " and ", rects[j], " not merged");
+					throw -1;
+				}
+			}
+		}
+
+		for (int y = 0; y < H; y++) {
+			for (int x = 0; x < W; x++) {
+
+				if (!_marked[y][x])
+					continue;
+
+				_marked[y][x] = 0;
+
+				bool found = false;
+				for (unsigned i = 0; i < num && !found; i++)
+					found = rects[i].contains(Point(x, y));
+
+				if (!found) {
+					error("dirty pixel ", Point(x, y), " not covered");
+					throw -1;
+				}
+			}
+		}
+
+		dirty.flush([&] (Rect const &) {
+			error("flush did not reset the dirty rectangles");
+			throw -1; });
+
+		return covered;
+	}
+
+	void _test_random()
+	{
+		for (unsigned i = 0; i < ROUNDS; i++) {
+
+			Dirty_rect dirty { };
+
+			unsigned const num_marks = 1 + _random() % MAX_MARKS;
+			for (unsigned j = 0; j < num_marks; j++)
+				_mark(dirty, _random_rect());
+
+			_check(dirty);
+		}
+		log("random rectangles passed");
+	}
+
+	void _test_distant_updates()
+	{
+		Rect const updates[] = {
+			Rect(Point(300, 200), Area(2, 16)),   /* cursor */
+			Rect(Point(270, 2),   Area(48, 12)),  /* clock */
+			Rect(Point(8, 100),   Area(120, 14)), /* line of text */
+			Rect(Point(20, 102),  Area(60, 8)),   /* within the line of text */
+			Rect(Point(4, 220),   Area(16, 16)),  /* icon */
+		};
+
+		Dirty_rect dirty { };
+
+		size_t expected = 0;
+		for (Rect const &rect : updates) {
+			_mark(dirty, rect);
+			expected += rect.area().count();
+		}
+
+		/* the rectangle within the line of text is counted twice */
+		expected -= updates[3].area().count();
+
+		size_t const covered = _check(dirty);
+
+		log("distant updates: ", expected, " dirty pixels, ",
+		    covered, " pixels covered");
+
+		if (covered != expected) {
+			error("distant updates were merged");
+			throw -1;
+		}
+	}
+
+	Main(Env &)
+	{
+		log("--- dirty-rect test ---");
+
+		_test_random();
+		_test_distant_updates();
+
+		log("--- dirty-rect test finished ---");
+	}
+};
+
+
+void Component::construct(Env &env) { static Main main(env); }
@@ -0,0 +1,3 @@
+TARGET = test-dirty_rect
+SRC_CC = main.cc
+LIBS   = base
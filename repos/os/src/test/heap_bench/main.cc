@@ -0,0 +1,149 @@
+/*
+ * \brief  Multi-threaded heap benchmark
+ * \author Norman Feske
+ * \date   2026-10-17
+ *
+ * A growing number of threads, spread over the available CPUs, allocate and
+ * free blocks of random small sizes concurrently. The benchmark compares
+ * the plain 'Heap' with the 'Thread_cached_heap' front end and checks that
+ * the front end accounts for all blocks once they are freed.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/log.h>
+#include <base/thread.h>
+#include <timer_session/connection.h>
+
+using namespace Genode;
+
+
+struct Worker : Thread
+{
+	enum { STACK_SIZE = 16*1024, SLOTS = 256, ROUNDS = 200000 };
+
+	Allocator &_alloc;
+	unsigned   _seed;
+	bool       _corrupt = false;
+
+	struct Slot { unsigned char *ptr; size_t size; } _slots[SLOTS] { };
+
+	unsigned _random()
+	{
+		_seed = _seed*1103515245 + 12345;
+		return _seed >> 16;
+	}
+
+	Worker(Env &env, Affinity::Location location, Allocator &alloc, unsigned id)
+	:
+		Thread(env, Name("worker"), STACK_SIZE, location, Weight(), env.cpu()),
+		_alloc(alloc), _seed(id + 1)
+	{ }
+
+	void entry() override
+	{
+		unsigned char const pattern = (unsigned char)_seed;
+
+		for (unsigned i = 0; i < ROUNDS; i++) {
+
+			Slot &slot = _slots[_random() % SLOTS];
+
+			if (slot.ptr) {
+				_corrupt |= (slot.ptr[0] != pattern || slot.ptr[slot.size - 1] != pattern);
+				_alloc.free(slot.ptr, slot.size);
+				slot.ptr = nullptr;
+				continue;
+			}
+
+			slot.size = 16 + _random() % 496;
+			slot.ptr  = (unsigned char *)_alloc.alloc(slot.size);
+			slot.ptr[0] = slot.ptr[slot.size - 1] = pattern;
+		}
+
+		for (Slot &slot : _slots)
+			if (slot.ptr)
+				_alloc.free(slot.ptr, slot.size);
+	}
+
+	bool corrupt() const { return _corrupt; }
+};
+
+
+struct Main
+{
+	enum { MAX_THREADS = 16 };
+
+	Env               &_env;
+	Heap               _heap  { _env.ram(), _env.rm() };
+	Timer::Connection  _timer { _env };
+
+	Affinity::Space _cpus { _env.cpu().affinity_space() };
+
+	uint64_t _run(Allocator &alloc, unsigned num_threads)
+	{
+		Worker *workers[MAX_THREADS] { };
+
+		for (unsigned i = 0; i < num_threads; i++)
+			workers[i] = new (_heap)
+				Worker(_env, _cpus.location_of_index(i % _cpus.total()), alloc, i);
+
+		uint64_t const start_ms = _timer.elapsed_ms();
+
+		for (unsigned i = 0; i < num_threads; i++)
+			workers[i]->start();
+
+		for (unsigned i = 0; i < num_threads; i++)
+			workers[i]->join();
+
+		uint64_t const duration_ms = max(_timer.elapsed_ms() - start_ms, (uint64_t)1);
+
+		for (unsigned i = 0; i < num_threads; i++) {
+			if (workers[i]->corrupt()) {
+				error("heap handed out overlapping blocks");
+				throw -1;
+			}
+			destroy(_heap, workers[i]);
+		}
+		return duration_ms;
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- heap benchmark ---");
+		log("CPUs: ", _cpus.total());
+
+		Thread_cached_heap cached_heap { _heap };
+
+		size_t const consumed = cached_heap.consumed();
+
+		for (unsigned threads = 1; threads <= MAX_THREADS; threads *= 2) {
+
+			uint64_t const heap_ms   = _run(_heap, threads);
+			uint64_t const cached_ms = _run(cached_heap, threads);
+
+			if (cached_heap.consumed() != consumed) {
+				error("thread-cached heap accounts ", cached_heap.consumed() - consumed,
+				      " bytes of freed blocks as consumed");
+				throw -1;
+			}
+
+			uint64_t const ops = (uint64_t)threads*Worker::ROUNDS;
+
+			log(threads, " threads: heap ", ops/heap_ms, " ops/ms, "
+			    "thread-cached heap ", ops/cached_ms, " ops/ms");
+		}
+
+		log("--- heap benchmark finished ---");
+	}
+};
+
+
+void Component::construct(Env &env) { static Main main(env); }
@@ -0,0 +1,3 @@
+TARGET = test-heap_bench
+SRC_CC = main.cc
+LIBS   = base
@@ -0,0 +1,193 @@
+/*
+ * \brief  Internet-checksum benchmark
+ * \author Martin Stein
+ * \date   2026-10-17
+ *
+ * The benchmark measures the throughput of 'internet_checksum' for typical
+ * packet sizes in comparison to a plain loop over 16-bit words, which was
+ * the implementation before the vectorized kernel. Furthermore, it compares
+ * the re-calculation of the IP and UDP checksums after a NAT rewrite with
+ * the incremental update via 'Internet_checksum_diff'.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/log.h>
+#include <net/internet_checksum.h>
+#include <net/udp.h>
+#include <timer_session/connection.h>
+
+using namespace Genode;
+using namespace Net;
+
+
+/**
+ * Reference implementation that adds up one 16-bit word at a time
+ */
+static uint16_t reference_checksum(uint16_t const *addr, size_t size)
+{
+	addr_t sum = 0;
+	for (; size > 1; size -= 2)
+		sum += *addr++;
+
+	if (size > 0)
+		sum += *(uint8_t *)addr;
+
+	while (addr_t const sum_rsh = sum >> 16)
+		sum = (sum & 0xffff) + sum_rsh;
+
+	return (uint16_t)~sum;
+}
+
+
+struct Main
+{
+	enum { BUFFER_SIZE = 16*1024, BYTES_PER_SIZE = 256*1024*1024 };
+
+	Env               &_env;
+	Timer::Connection  _timer { _env };
+
+	/* keep the buffer aligned like packet data behind an Ethernet header */
+	uint8_t            _buffer[BUFFER_SIZE + 2] __attribute__((aligned(16)));
+	uint8_t    * const _data   { _buffer + 2 };
+	uint16_t volatile  _sink   { 0 };
+
+	unsigned _seed = 1;
+
+	unsigned _random()
+	{
+		_seed = _seed*1103515245 + 12345;
+		return _seed >> 16;
+	}
+
+	template <typename FN>
+	uint64_t _measure_ms(FN const &fn)
+	{
+		uint64_t const start_ms = _timer.elapsed_ms();
+		fn();
+		return max(_timer.elapsed_ms() - start_ms, (uint64_t)1);
+	}
+
+	void _check(size_t size)
+	{
+		uint16_t const *data = (uint16_t const *)_data;
+		if (internet_checksum(data, size) != reference_checksum(data, size)) {
+			error("checksum mismatch for ", size, " bytes");
+			throw -1;
+		}
+	}
+
+	void _bench_full(size_t size)
+	{
+		uint16_t const *data = (uint16_t const *)_data;
+		unsigned const rounds = BYTES_PER_SIZE / size;
+
+		uint64_t const reference_ms = _measure_ms([&] () {
+			for (unsigned i = 0; i < rounds; i++)
+				_sink = _sink + reference_checksum(data, size); });
+
+		uint64_t const vector_ms = _measure_ms([&] () {
+			for (unsigned i = 0; i < rounds; i++)
+				_sink = _sink + internet_checksum(data, size); });
+
+		log(size, " bytes: reference ", (BYTES_PER_SIZE/1024)/reference_ms,
+		    " KiB/ms, internet_checksum ", (BYTES_PER_SIZE/1024)/vector_ms,
+		    " KiB/ms");
+	}
+
+	void _bench_nat(size_t size)
+	{
+		enum { ROUNDS = 1000000 };
+
+		Size_guard size_guard(size);
+		Ipv4_packet &ip  = *construct_at<Ipv4_packet>(_data);
+		size_guard.consume_head(sizeof(Ipv4_packet));
+		ip.header_length(sizeof(Ipv4_packet) / 4);
+		ip.version(4);
+		ip.total_length(size);
+		ip.time_to_live(64);
+		ip.protocol(Ipv4_packet::Protocol::UDP);
+		ip.src(Ipv4_address((uint8_t)10));
+		ip.dst(Ipv4_address((uint8_t)192));
+
+		Udp_packet &udp = ip.data<Udp_packet>(size_guard);
+		udp.length(size - sizeof(Ipv4_packet));
+		udp.src_port(Port(49152));
+		udp.dst_port(Port(80));
+		ip.update_checksum();
+		udp.update_checksum(ip.src(), ip.dst());
+
+		Ipv4_address const addr[2] { ip.src(), ip.dst() };
+		uint16_t     const port[2] { host_to_big_endian((uint16_t)49152),
+		                             host_to_big_endian((uint16_t)50000) };
+
+		/* alternate between the two source addresses and ports */
+		uint64_t const full_ms = _measure_ms([&] () {
+			for (unsigned i = 0; i < ROUNDS; i++) {
+				ip.src(addr[~i & 1]);
+				udp.src_port(Port(host_to_big_endian(port[~i & 1])));
+				ip.update_checksum();
+				udp.update_checksum(ip.src(), ip.dst());
+			} });
+
+		uint64_t const incremental_ms = _measure_ms([&] () {
+			for (unsigned i = 0; i < ROUNDS; i++) {
+				Internet_checksum_diff icd;
+				icd.add_up_diff(addr[~i & 1].addr, addr[i & 1].addr, Ipv4_packet::ADDR_LEN);
+				ip.src(addr[~i & 1]);
+				ip.update_checksum(icd);
+
+				icd.add_up_diff(&port[~i & 1], &port[i & 1], sizeof(uint16_t));
+				udp.src_port(Port(host_to_big_endian(port[~i & 1])));
+				udp.update_checksum(icd);
+			} });
+
+		/* after an even number of rounds, both checksums must be valid */
+		if (ip.checksum_error() || udp.checksum_error(ip.src(), ip.dst())) {
+			error("incremental update corrupted the checksums");
+			throw -1;
+		}
+		log(size, " bytes NAT rewrite: full ", (ROUNDS/full_ms),
+		    " packets/ms, incremental ", (ROUNDS/incremental_ms),
+		    " packets/ms");
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- Internet-checksum benchmark ---");
+
+		for (uint8_t &byte : _buffer)
+			byte = (uint8_t)_random();
+
+		for (size_t size = 0; size < 4096; size++)
+			_check(size);
+
+		static size_t const sizes[] = { 64, 576, 1500, 9000 };
+
+		for (size_t size : sizes)
+			_bench_full(size);
+
+		for (size_t size : sizes)
+			_bench_nat(size);
+
+		log("--- Internet-checksum benchmark finished ---");
+	}
+
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Main(Main const &);
+		Main &operator = (Main const &);
+};
+
+
+void Component::construct(Env &env) { static Main main(env); }
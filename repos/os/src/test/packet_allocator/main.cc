@@ -0,0 +1,180 @@
+/*
+ * \brief  Packet-allocator benchmark
+ * \author Sebastian Sumpf
+ * \date   2026-10-17
+ *
+ * The benchmark compares the bit-array based 'Packet_allocator' with the
+ * 'Size_class_packet_allocator' for workloads typical for NIC and block
+ * sessions. Each workload keeps a window of packets in flight, releasing
+ * them mostly in allocation order and occasionally out of order.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/log.h>
+#include <os/packet_allocator.h>
+#include <os/size_class_packet_allocator.h>
+#include <timer_session/connection.h>
+
+using namespace Genode;
+
+
+struct Workload
+{
+	char const *name;
+	size_t      min_size;
+	size_t      max_size;
+};
+
+
+struct Main
+{
+	enum {
+		BUFFER_SIZE = 4*1024*1024,
+		BLOCK_SIZE  = 64,
+		WINDOW      = 256,
+		ITERATIONS  = 1000000,
+	};
+
+	Env               &_env;
+	Heap               _heap  { _env.ram(), _env.rm() };
+	Timer::Connection  _timer { _env };
+
+	unsigned _seed = 1;
+
+	unsigned _random()
+	{
+		_seed = _seed*1103515245 + 12345;
+		return _seed >> 16;
+	}
+
+	size_t _size(Workload const &w)
+	{
+		return w.min_size + _random() % (w.max_size - w.min_size + 1);
+	}
+
+	/**
+	 * Check that the allocator hands out non-overlapping packets within
+	 * its range and that all space is available again after releasing
+	 */
+	void _check(Range_allocator &alloc, char const *name)
+	{
+		enum { N = 512 };
+		addr_t addr[N] { };
+		size_t size[N] { };
+
+		size_t const avail = alloc.avail();
+
+		for (unsigned i = 0; i < N; i++) {
+			size[i] = 1 + _random() % 8192;
+			if (!alloc.alloc(size[i], (void **)&addr[i])) {
+				error(name, ": allocation ", i, " failed");
+				throw -1;
+			}
+			if (addr[i] < BUFFER_SIZE || addr[i] + size[i] > 2*BUFFER_SIZE) {
+				error(name, ": packet out of range");
+				throw -1;
+			}
+			for (unsigned j = 0; j < i; j++)
+				if (addr[i] < addr[j] + size[j] && addr[j] < addr[i] + size[i]) {
+					error(name, ": overlapping packets");
+					throw -1;
+				}
+		}
+
+		for (unsigned i = 0; i < N; i++)
+			alloc.free((void *)addr[i], size[i]);
+
+		if (alloc.avail() != avail) {
+			error(name, ": leaked ", avail - alloc.avail(), " bytes");
+			throw -1;
+		}
+	}
+
+	void _bench(Range_allocator &alloc, char const *name, Workload const &w)
+	{
+		addr_t addr[WINDOW] { };
+		size_t size[WINDOW] { };
+		unsigned failed = 0;
+
+		_seed = 1;
+
+		uint64_t const start_ms = _timer.elapsed_ms();
+
+		for (unsigned i = 0; i < ITERATIONS; i++) {
+
+			/* release oldest packet, or a random one every 8th time */
+			unsigned const slot = (i % 8) ? i % WINDOW : _random() % WINDOW;
+
+			if (addr[slot]) {
+				alloc.free((void *)addr[slot], size[slot]);
+				addr[slot] = 0;
+			}
+
+			size[slot] = _size(w);
+			if (!alloc.alloc(size[slot], (void **)&addr[slot])) {
+				addr[slot] = 0;
+				failed++;
+			}
+		}
+
+		uint64_t const end_ms = _timer.elapsed_ms();
+
+		for (unsigned i = 0; i < WINDOW; i++)
+			if (addr[i])
+				alloc.free((void *)addr[i], size[i]);
+
+		uint64_t const ms = max(end_ms - start_ms, (uint64_t)1);
+
+		log(name, " ", w.name, ": ", ITERATIONS/ms, " alloc/free pairs per ms");
+
+		if (failed)
+			log(name, " ", w.name, ": ", failed, " allocations failed");
+	}
+
+	template <typename ALLOC>
+	void _run(ALLOC &alloc, char const *name)
+	{
+		alloc.add_range(BUFFER_SIZE, BUFFER_SIZE);
+
+		_check(alloc, name);
+
+		static Workload const workloads[] = {
+			{ "MTU-sized",  1518, 1518 },
+			{ "NIC mixed",    64, 2048 },
+			{ "4K blocks",  4096, 4096 },
+		};
+
+		for (Workload const &w : workloads)
+			_bench(alloc, name, w);
+
+		alloc.remove_range(BUFFER_SIZE, BUFFER_SIZE);
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- Packet-allocator benchmark ---");
+
+		{
+			Packet_allocator alloc(&_heap, BLOCK_SIZE);
+			_run(alloc, "Packet_allocator");
+		}
+		{
+			Size_class_packet_allocator alloc(&_heap, BLOCK_SIZE);
+			_run(alloc, "Size_class_packet_allocator");
+		}
+
+		log("--- Packet-allocator benchmark finished ---");
+	}
+};
+
+
+void Component::construct(Env &env) { static Main main(env); }
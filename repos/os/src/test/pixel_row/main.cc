@@ -0,0 +1,210 @@
+/*
+ * \brief  Test of the row operations on pixels
+ * \author Norman Feske
+ * \date   2026-10-17
+ *
+ * The test compares the results of the 'Pixel_row' specializations with
+ * the plain pixel-wise loops of 'Pixel_row_scalar' for random pixels,
+ * line lengths, and alignments as well as for all alpha values. It also
+ * reports the duration of both variants.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/log.h>
+#include <os/pixel_rgb565.h>
+#include <os/pixel_rgb888.h>
+#include <os/pixel_alpha8.h>
+#include <timer_session/connection.h>
+
+using namespace Genode;
+
+
+struct Main
+{
+	enum { LEN = 256, ROUNDS = 20000, BENCH_LEN = 1920*64, BENCH_ROUNDS = 50 };
+
+	Env               &_env;
+	Timer::Connection  _timer { _env };
+
+	unsigned _seed = 1;
+
+	unsigned _random()
+	{
+		_seed = _seed*1103515245 + 12345;
+		return _seed >> 8;
+	}
+
+	/**
+	 * Return random alpha value, favouring the special values 0 and 255
+	 */
+	unsigned char _random_alpha()
+	{
+		switch (_random() % 4) {
+		case 0:  return 0;
+		case 1:  return 255;
+		default: return (unsigned char)_random();
+		}
+	}
+
+	template <typename PT>
+	PT _random_pixel()
+	{
+		PT p;
+		p.pixel = (decltype(p.pixel))_random();
+		return p;
+	}
+
+	enum Op { FILL, MIX, MIX_OPACITY, BLEND, AVR, NUM_OPS };
+
+	template <typename PT, typename ROW>
+	static void _apply(Op op, PT *dst, PT const *src, unsigned char const *alpha,
+	                   PT color, int color_alpha, unsigned n)
+	{
+		switch (op) {
+		case FILL:        ROW::fill(dst, color, n);                     break;
+		case MIX:         ROW::mix(dst, color, color_alpha, n);         break;
+		case MIX_OPACITY: ROW::mix(dst, color, color_alpha, alpha, n);  break;
+		case BLEND:       ROW::blend(dst, src, alpha, n);               break;
+		case AVR:         ROW::avr(dst, src, color, n);                 break;
+		case NUM_OPS:                                                   break;
+		}
+	}
+
+	template <typename PT>
+	struct Buffers
+	{
+		PT            dst[LEN], ref[LEN], src[LEN];
+		unsigned char alpha[LEN];
+	};
+
+	/**
+	 * Apply operation with both variants, return true if the results match
+	 */
+	template <typename PT>
+	bool _compare(Buffers<PT> &b, Op op, unsigned offset, unsigned n,
+	              PT color, int color_alpha)
+	{
+		_apply<PT, Pixel_row<PT>>(op, b.dst + offset, b.src + offset,
+		                          b.alpha + offset, color, color_alpha, n);
+		_apply<PT, Pixel_row_scalar<PT>>(op, b.ref + offset, b.src + offset,
+		                                 b.alpha + offset, color, color_alpha, n);
+
+		for (unsigned i = 0; i < LEN; i++)
+			if (b.dst[i].pixel != b.ref[i].pixel)
+				return false;
+
+		return true;
+	}
+
+	template <typename PT>
+	void _randomize(Buffers<PT> &b)
+	{
+		for (unsigned i = 0; i < LEN; i++) {
+			b.dst[i] = b.ref[i] = _random_pixel<PT>();
+			b.src[i]   = _random_pixel<PT>();
+			b.alpha[i] = _random_alpha();
+		}
+	}
+
+	template <typename PT>
+	void _test(char const *name)
+	{
+		static Buffers<PT> b;
+
+		auto fail = [&] (Op op, int color_alpha) {
+			error(name, ": operation ", (int)op, " with alpha ", color_alpha,
+			      " differs from pixel-wise loop");
+			throw -1;
+		};
+
+		/* random line lengths and alignments */
+		for (unsigned i = 0; i < ROUNDS; i++) {
+
+			_randomize(b);
+
+			Op       const op     = (Op)(i % NUM_OPS);
+			unsigned const offset = _random() % 16;
+			unsigned const n      = _random() % (LEN - 16);
+			int      const alpha  = (_random() % 16) ? _random_alpha()
+			                                         : (int)(_random() % 300);
+
+			if (!_compare(b, op, offset, n, _random_pixel<PT>(), alpha))
+				fail(op, alpha);
+		}
+
+		/* all alpha values */
+		for (int alpha = 0; alpha < 256; alpha++) {
+
+			Op const ops[] = { MIX, MIX_OPACITY, BLEND };
+
+			for (Op op : ops) {
+				_randomize(b);
+				for (unsigned i = 0; i < LEN; i++)
+					b.alpha[i] = (unsigned char)alpha;
+
+				if (!_compare(b, op, 0, LEN, _random_pixel<PT>(), alpha))
+					fail(op, alpha);
+			}
+		}
+
+		_bench<PT>(name);
+	}
+
+	template <typename FN>
+	uint64_t _measure_us(FN const &fn)
+	{
+		uint64_t const start_us = _timer.elapsed_us();
+		for (unsigned i = 0; i < BENCH_ROUNDS; i++)
+			fn();
+		return max(_timer.elapsed_us() - start_us, (uint64_t)1);
+	}
+
+	template <typename PT>
+	void _bench(char const *name)
+	{
+		static PT            dst[BENCH_LEN], src[BENCH_LEN];
+		static unsigned char alpha[BENCH_LEN];
+
+		for (unsigned i = 0; i < BENCH_LEN; i++) {
+			dst[i]   = _random_pixel<PT>();
+			src[i]   = _random_pixel<PT>();
+			alpha[i] = _random_alpha();
+		}
+
+		PT const color = _random_pixel<PT>();
+
+		char const *op_names[NUM_OPS] = { "fill", "mix", "mix opacity", "blend", "avr" };
+
+		for (unsigned op = 0; op < NUM_OPS; op++) {
+
+			uint64_t const row_us = _measure_us([&] () {
+				_apply<PT, Pixel_row<PT>>((Op)op, dst, src, alpha, color, 128, BENCH_LEN); });
+
+			uint64_t const scalar_us = _measure_us([&] () {
+				_apply<PT, Pixel_row_scalar<PT>>((Op)op, dst, src, alpha, color, 128, BENCH_LEN); });
+
+			log(name, " ", op_names[op], ": ", row_us, " us, pixel-wise ", scalar_us, " us");
+		}
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- pixel-row test ---");
+
+		_test<Pixel_rgb888>("RGB888");
+		_test<Pixel_rgb565>("RGB565");
+
+		log("--- pixel-row test finished ---");
+	}
+};
+
+
+void Component::construct(Env &env) { static Main main(env); }
@@ -0,0 +1,3 @@
+TARGET = test-pixel_row
+SRC_CC = main.cc
+LIBS   = base
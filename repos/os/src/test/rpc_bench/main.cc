@@ -0,0 +1,166 @@
+/*
+ * \brief  RPC round-trip benchmark
+ * \author Norman Feske
+ * \date   2026-10-17
+ *
+ * The benchmark measures the round-trip time of an RPC to a local
+ * entrypoint, which resolves the invoked capability via its object pool.
+ * The number of objects managed by the entrypoint is increased step by
+ * step. Each step is measured once without and once with a thread that
+ * concurrently manages and dissolves objects at the same entrypoint.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/log.h>
+#include <base/rpc_client.h>
+#include <base/rpc_server.h>
+#include <base/thread.h>
+#include <timer_session/connection.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	struct Session;
+	struct Client;
+	struct Component;
+	struct Churn;
+	struct Main;
+}
+
+
+struct Test::Session : Interface
+{
+	GENODE_RPC(Rpc_echo, unsigned long, echo, unsigned long);
+	GENODE_RPC_INTERFACE(Rpc_echo);
+};
+
+
+struct Test::Client : Rpc_client<Session>
+{
+	Client(Capability<Session> cap) : Rpc_client<Session>(cap) { }
+
+	unsigned long echo(unsigned long value) { return call<Rpc_echo>(value); }
+};
+
+
+struct Test::Component : Rpc_object<Session, Component>
+{
+	unsigned long echo(unsigned long value) { return value; }
+};
+
+
+/**
+ * Thread that manages and dissolves an object at the entrypoint in a loop
+ */
+struct Test::Churn : Thread
+{
+	Rpc_entrypoint &_ep;
+	Component       _component { };
+	bool volatile   _stop      { false };
+	unsigned long   _rounds    { 0 };
+
+	Churn(Env &env, Rpc_entrypoint &ep)
+	:
+		Thread(env, "churn", 16*1024), _ep(ep)
+	{ }
+
+	void entry() override
+	{
+		while (!_stop) {
+			_ep.manage(&_component);
+			_ep.dissolve(&_component);
+			_rounds++;
+		}
+	}
+
+	unsigned long stop()
+	{
+		_stop = true;
+		join();
+		return _rounds;
+	}
+};
+
+
+struct Test::Main
+{
+	enum { STACK_SIZE = 16*1024, MAX_OBJECTS = 1024, CALLS = 100000 };
+
+	Env               &_env;
+	Heap               _heap  { _env.ram(), _env.rm() };
+	Timer::Connection  _timer { _env };
+	Rpc_entrypoint     _ep    { &_env.pd(), STACK_SIZE, "rpc_bench_ep" };
+
+	Component  _component { };
+	Client     _client    { _ep.manage(&_component) };
+
+	Component *_objects[MAX_OBJECTS] { };
+	unsigned   _num_objects { 0 };
+
+	uint64_t _measure_us()
+	{
+		uint64_t const start_us = _timer.elapsed_us();
+
+		for (unsigned long i = 0; i < CALLS; i++) {
+			if (_client.echo(i) != i) {
+				error("RPC returned unexpected value");
+				throw -1;
+			}
+		}
+		return max(_timer.elapsed_us() - start_us, (uint64_t)1);
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- RPC benchmark ---");
+
+		for (unsigned num = 1; num <= MAX_OBJECTS; num *= 4) {
+
+			/* populate the object pool of the entrypoint */
+			for (; _num_objects < num - 1; _num_objects++) {
+				_objects[_num_objects] = new (_heap) Component;
+				_ep.manage(_objects[_num_objects]);
+			}
+
+			uint64_t const quiet_us = _measure_us();
+
+			Churn churn(_env, _ep);
+			churn.start();
+			uint64_t const churn_us = _measure_us();
+			unsigned long const churn_rounds = churn.stop();
+
+			log(num, " objects: ", (quiet_us*1000)/CALLS, " ns per call, ",
+			    (churn_us*1000)/CALLS, " ns per call with ", churn_rounds,
+			    " concurrent manage/dissolve rounds");
+		}
+
+		for (unsigned i = 0; i < _num_objects; i++) {
+			_ep.dissolve(_objects[i]);
+			destroy(_heap, _objects[i]);
+		}
+		_ep.dissolve(&_component);
+
+		log("--- RPC benchmark finished ---");
+	}
+
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Main(Main const &);
+		Main &operator = (Main const &);
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
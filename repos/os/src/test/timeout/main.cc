@@ -14,6 +14,7 @@
 /* Genode includes */
 #include <base/component.h>
 #include <base/attached_ram_dataspace.h>
+#include <base/heap.h>
 #include <timer_session/connection.h>
 #include <util/fifo.h>
 #include <util/misc_math.h>
@@ -770,6 +771,167 @@ struct Fast_polling : Test
 };
 
 
+struct Timeout_stress : Test
+{
+	static constexpr char const *brief = "schedule and discard many timeouts";
+
+	using Queue = Timer::Connection::Queue;
+
+	enum { NR_OF_TIMEOUTS  = 4096 };
+	enum { NR_OF_ROUNDS    = 16 };
+	enum { NR_OF_TRIGGERED = 256 };
+	enum { MAX_TRIGGER_US  = 500000 };
+	enum { MAX_CHURN_US    = 60000000 };
+
+	struct Stress_timeout : Genode::Timeout::Handler
+	{
+		Timeout_stress  &test;
+		Genode::Timeout  timeout;
+		uint64_t         deadline_us { 0 };
+
+		Stress_timeout(Timeout_stress &test, Timer::Connection &timer)
+		: test(test), timeout(timer) { }
+
+		void handle_timeout(Duration time) override { test.handle(*this, time); }
+	};
+
+	Heap                              heap            { env.ram(), env.rm() };
+	Queue                             queue           { Queue::SORTED_LIST };
+	Constructible<Timer::Connection>  stress_timer    { };
+	Stress_timeout                   *timeouts[NR_OF_TIMEOUTS] { };
+	unsigned                          nr_of_triggered { 0 };
+	uint64_t                          seed            { 1 };
+	uint64_t                          max_error_us    { config.xml().attribute_value("precise_timeouts", true) ?
+	                                                    (uint64_t)50000 : (uint64_t)200000 };
+
+	Timer::One_shot_timeout<Timeout_stress> watchdog { timer, *this, &Timeout_stress::handle_watchdog };
+
+	/*
+	 * The timeouts cannot be destroyed from within their handlers, thus,
+	 * finishing a run is deferred to a signal
+	 */
+	Signal_handler<Timeout_stress> finish_handler { env.ep(), *this, &Timeout_stress::finish };
+
+	static char const *name(Queue queue)
+	{
+		return queue == Queue::SORTED_LIST ? "sorted list" : "timing wheel";
+	}
+
+	uint64_t random(uint64_t range)
+	{
+		/* xorshift64 */
+		seed ^= seed << 13;
+		seed ^= seed >> 7;
+		seed ^= seed << 17;
+		return seed % range;
+	}
+
+	uint64_t curr_time_us() { return stress_timer->curr_time().trunc_to_plain_us().value; }
+
+	void schedule(Stress_timeout &t, uint64_t duration_us)
+	{
+		t.deadline_us = curr_time_us() + duration_us;
+		t.timeout.schedule_one_shot(Microseconds(duration_us), t);
+	}
+
+	void start()
+	{
+		stress_timer.construct(env, env.ep(), "stress", queue);
+		for (Stress_timeout *&t : timeouts)
+			t = new (heap) Stress_timeout(*this, *stress_timer);
+
+		/*
+		 * Re-schedule and discard the timeouts like a network stack does
+		 * with its retransmission timeouts
+		 */
+		uint64_t const start_us = curr_time_us();
+		for (unsigned round = 0; round < NR_OF_ROUNDS; round++) {
+			for (Stress_timeout *t : timeouts) {
+				if (random(4)) {
+					schedule(*t, MAX_TRIGGER_US + random(MAX_CHURN_US));
+				} else {
+					t->timeout.discard(); }
+			}
+		}
+		uint64_t const churn_us = curr_time_us() - start_us;
+		log(name(queue), ": ", (unsigned)(NR_OF_ROUNDS * NR_OF_TIMEOUTS),
+		    " operations on ", (unsigned)NR_OF_TIMEOUTS, " timeouts took ",
+		    churn_us, " us");
+
+		/* let some of the timeouts trigger while the others are pending */
+		nr_of_triggered = 0;
+		for (unsigned i = 0; i < NR_OF_TRIGGERED; i++)
+			schedule(*timeouts[i], 1000 + random(MAX_TRIGGER_US));
+
+		watchdog.schedule(Microseconds(MAX_TRIGGER_US + 2 * max_error_us + 1000000));
+	}
+
+	void finish()
+	{
+		for (Stress_timeout *t : timeouts)
+			destroy(heap, t);
+
+		stress_timer.destruct();
+
+		if (queue == Queue::SORTED_LIST) {
+			queue = Queue::TIMING_WHEEL;
+			start();
+			return;
+		}
+		done.submit();
+	}
+
+	void handle(Stress_timeout &t, Duration time)
+	{
+		uint64_t const time_us = time.trunc_to_plain_us().value;
+		if (time_us + max_error_us < t.deadline_us) {
+			error(name(queue), ": timeout triggered ", t.deadline_us - time_us,
+			      " us too early");
+			error_cnt++;
+		}
+		if (++nr_of_triggered < NR_OF_TRIGGERED)
+			return;
+
+		log(name(queue), ": all ", (unsigned)NR_OF_TRIGGERED, " timeouts triggered");
+		watchdog.discard();
+		Signal_transmitter(finish_handler).submit();
+	}
+
+	void handle_watchdog(Duration)
+	{
+		error(name(queue), ": only ", nr_of_triggered, " of ",
+		      (unsigned)NR_OF_TRIGGERED, " timeouts triggered");
+		error_cnt++;
+		Signal_transmitter(finish_handler).submit();
+	}
+
+	Timeout_stress(Env                       &env,
+	               unsigned                  &error_cnt,
+	               Signal_context_capability  done,
+	               unsigned                   id)
+	:
+		Test(env, error_cnt, done, id, brief)
+	{
+		start();
+	}
+
+	~Timeout_stress()
+	{
+		if (stress_timer.constructed())
+			for (Stress_timeout *t : timeouts)
+				destroy(heap, t);
+	}
+
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Timeout_stress(Timeout_stress const &);
+		Timeout_stress &operator = (Timeout_stress const &);
+};
+
+
 struct Main
 {
 	Env                           &env;
@@ -778,10 +940,12 @@ struct Main
 	Constructible<Duration_test>   test_1      { };
 	Constructible<Fast_polling>    test_2      { };
 	Constructible<Mixed_timeouts>  test_3      { };
+	Constructible<Timeout_stress>  test_4      { };
 	Signal_handler<Main>           test_0_done { env.ep(), *this, &Main::handle_test_0_done };
 	Signal_handler<Main>           test_1_done { env.ep(), *this, &Main::handle_test_1_done };
 	Signal_handler<Main>           test_2_done { env.ep(), *this, &Main::handle_test_2_done };
 	Signal_handler<Main>           test_3_done { env.ep(), *this, &Main::handle_test_3_done };
+	Signal_handler<Main>           test_4_done { env.ep(), *this, &Main::handle_test_4_done };
 
 	Main(Env &env) : env(env)
 	{
@@ -809,6 +973,12 @@ struct Main
 	void handle_test_3_done()
 	{
 		test_3.destruct();
+		test_4.construct(env, error_cnt, test_4_done, 4);
+	}
+
+	void handle_test_4_done()
+	{
+		test_4.destruct();
 		if (error_cnt) {
 			error("test failed because of ", error_cnt, " error(s)");
 			env.parent().exit(-1);
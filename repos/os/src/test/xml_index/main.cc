@@ -0,0 +1,191 @@
+/*
+ * \brief  XML-index benchmark
+ * \author Norman Feske
+ * \date   2026-10-17
+ *
+ * The benchmark generates an init configuration of several megabytes and
+ * compares the navigation through plain 'Xml_node' objects with the
+ * navigation through the nodes of an 'Xml_index'. The first workload walks
+ * the whole document recursively, the second one accesses top-level nodes
+ * by their index. Both variants must yield the same results.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/attached_ram_dataspace.h>
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/log.h>
+#include <util/xml_generator.h>
+#include <util/xml_index.h>
+#include <timer_session/connection.h>
+
+using namespace Genode;
+
+
+struct Main
+{
+	enum {
+		DOC_SIZE      = 4*1024*1024,
+		NUM_STARTS    = 4000,
+		NUM_DIRS      = 8,
+		NUM_SERVICES  = 6,
+		NUM_ACCESSES  = 64,
+	};
+
+	Env               &_env;
+	Heap               _heap  { _env.ram(), _env.rm() };
+	Timer::Connection  _timer { _env };
+
+	Attached_ram_dataspace _doc_ds { _env.ram(), _env.rm(), DOC_SIZE };
+
+	char  * const _doc      { _doc_ds.local_addr<char>() };
+	size_t        _doc_size { 0 };
+
+	unsigned _seed = 1;
+
+	unsigned _random()
+	{
+		_seed = _seed*1103515245 + 12345;
+		return _seed >> 16;
+	}
+
+	template <typename FN>
+	uint64_t _measure_ms(FN const &fn)
+	{
+		uint64_t const start_ms = _timer.elapsed_ms();
+		fn();
+		return max(_timer.elapsed_ms() - start_ms, (uint64_t)1);
+	}
+
+	void _generate()
+	{
+		Xml_generator xml(_doc, DOC_SIZE, "config", [&] () {
+			for (unsigned i = 0; i < NUM_STARTS; i++) {
+				xml.node("start", [&] () {
+					xml.attribute("name", String<32>("component-", i));
+					xml.attribute("caps", 100 + i % 100);
+					xml.node("resource", [&] () {
+						xml.attribute("name", "RAM");
+						xml.attribute("quantum", 1024*(1 + i % 64));
+					});
+					xml.node("config", [&] () {
+						xml.node("vfs", [&] () {
+							for (unsigned j = 0; j < NUM_DIRS; j++)
+								xml.node("dir", [&] () {
+									xml.attribute("name", String<16>("dir-", j));
+									xml.node("ram");
+								});
+						});
+					});
+					xml.node("route", [&] () {
+						for (unsigned j = 0; j < NUM_SERVICES; j++)
+							xml.node("service", [&] () {
+								xml.attribute("name", String<16>("service-", j));
+								xml.node("parent");
+							});
+					});
+				});
+			}
+		});
+		_doc_size = xml.used();
+	}
+
+	struct Walk_result
+	{
+		unsigned long nodes;
+		unsigned long quantum;
+
+		bool operator != (Walk_result const &other) const {
+			return nodes != other.nodes || quantum != other.quantum; }
+	};
+
+	static void _walk(Xml_node const &node, Walk_result &result)
+	{
+		result.nodes++;
+		result.quantum += node.attribute_value("quantum", 0UL);
+
+		node.for_each_sub_node([&] (Xml_node const &sub_node) {
+			_walk(sub_node, result); });
+	}
+
+	unsigned long _access(Xml_node const &config)
+	{
+		unsigned long services = 0;
+		for (unsigned i = 0; i < NUM_ACCESSES; i++) {
+			Xml_node const start = config.sub_node(_random() % NUM_STARTS);
+			services += start.sub_node("route").num_sub_nodes();
+		}
+		return services;
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- XML-index benchmark ---");
+
+		_generate();
+		log("document of ", _doc_size/1024, " KiB");
+
+		Xml_node const plain(_doc, _doc_size);
+
+		Constructible<Xml_index> index { };
+		uint64_t const index_ms = _measure_ms([&] () {
+			index.construct(_heap, plain); });
+
+		log("indexed ", index->num_nodes(), " nodes in ", index_ms, " ms");
+
+		Xml_node const indexed = index->xml();
+
+		Walk_result plain_walk   { 0, 0 };
+		Walk_result indexed_walk { 0, 0 };
+
+		uint64_t const plain_walk_ms = _measure_ms([&] () {
+			_walk(plain, plain_walk); });
+
+		uint64_t const indexed_walk_ms = _measure_ms([&] () {
+			_walk(indexed, indexed_walk); });
+
+		if (plain_walk != indexed_walk || plain_walk.nodes != index->num_nodes()) {
+			error("walks of plain and indexed document differ");
+			throw -1;
+		}
+		log("recursive walk: plain ", plain_walk_ms, " ms, indexed ",
+		    indexed_walk_ms, " ms");
+
+		unsigned long plain_services = 0, indexed_services = 0;
+
+		_seed = 1;
+		uint64_t const plain_access_ms = _measure_ms([&] () {
+			plain_services = _access(plain); });
+
+		_seed = 1;
+		uint64_t const indexed_access_ms = _measure_ms([&] () {
+			indexed_services = _access(indexed); });
+
+		if (plain_services != indexed_services) {
+			error("accesses of plain and indexed document differ");
+			throw -1;
+		}
+		log((unsigned)NUM_ACCESSES, " accesses by index: plain ", plain_access_ms,
+		    " ms, indexed ", indexed_access_ms, " ms");
+
+		log("--- XML-index benchmark finished ---");
+	}
+
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Main(Main const &);
+		Main &operator = (Main const &);
+};
+
+
+void Component::construct(Env &env) { static Main main(env); }